@@ -75,15 +75,16 @@ VerticalBlockMatrix SymmetricBlockMatrix::split(DenseIndex nFrontals) {
   gttic(VerticalBlockMatrix_split);
 
   // Construct a VerticalBlockMatrix that contains [R Sd]
-  const size_t n1 = offset(nFrontals);
+  const DenseIndex topleft = offset(0);
+  const DenseIndex n1 = offset(nFrontals) - topleft;
   VerticalBlockMatrix RSd = VerticalBlockMatrix::LikeActiveViewOf(*this, n1);
 
   // Copy into it.
-  RSd.full() = matrix_.topRows(n1);
+  RSd.full() = matrix_.block(topleft, topleft, n1, cols());
   RSd.full().triangularView<Eigen::StrictlyLower>().setZero();
 
   // Take lower-right block of Ab_ to get the remaining factor
-  blockStart() = nFrontals;
+  blockStart() += nFrontals;
 
   return RSd;
 }
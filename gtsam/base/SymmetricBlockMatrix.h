@@ -191,6 +191,15 @@ namespace gtsam {
                    j_endBlock - j_startBlock);
     }
 
+    /// Get the block (I, J) on or above the diagonal as a fixed-size R x C
+    /// block, so that updates with fixed-size matrices are unrolled.
+    template <int R, int C>
+    Eigen::Block<Matrix, R, C> fixedBlock(DenseIndex I, DenseIndex J) {
+      assert(I <= J);
+      assert(offset(I + 1) - offset(I) == R && offset(J + 1) - offset(J) == C);
+      return matrix_.block<R, C>(offset(I), offset(J));
+    }
+
     /// @}
     /// @name Block setter methods.
     /// @{
@@ -290,6 +299,37 @@ namespace gtsam {
     /// it will be inaccessible, except by accessing the underlying matrix using matrix().
     DenseIndex blockStart() const { return blockStart_; }
 
+    /// Size of the underlying storage, which can be larger than rows(), see resetBlocks().
+    DenseIndex capacity() const { return matrix_.rows(); }
+
+    /**
+     * Change the block structure to the given dimensions, with an extra block of dimension 1 at
+     * the end if appendOneDimension is true.  The storage is only re-allocated if it is smaller
+     * than the new total dimension.  Otherwise the blocks are laid out in its lower-right corner,
+     * and the part before them is hidden with blockStart(), so that the same storage can be used
+     * for a sequence of dense eliminations.  The matrix entries are not initialized.
+     */
+    template<typename CONTAINER>
+    void resetBlocks(const CONTAINER& dimensions, bool appendOneDimension = false) {
+      DenseIndex size = appendOneDimension ? 1 : 0;
+      for (DenseIndex dim : dimensions)
+        size += dim;
+      if (matrix_.rows() < size)
+        matrix_.resize(size, size);
+      variableColOffsets_.resize(dimensions.size() + (appendOneDimension ? 3 : 2));
+      variableColOffsets_[0] = 0;
+      variableColOffsets_[1] = matrix_.rows() - size;
+      DenseIndex j = 1;
+      for (DenseIndex dim : dimensions) {
+        variableColOffsets_[j + 1] = variableColOffsets_[j] + dim;
+        ++j;
+      }
+      if (appendOneDimension)
+        variableColOffsets_[j + 1] = variableColOffsets_[j] + 1;
+      blockStart_ = 1;
+      assertInvariants();
+    }
+
     /**
      * Given the augmented Hessian [A1'A1 A1'A2 A1'b
      *                              A2'A1 A2'A2 A2'b
@@ -0,0 +1,143 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file     ThreadPool.cpp
+ * @brief    A minimal std::thread pool for data-parallel loops, usable without TBB
+ * @date     Oct 15, 2026
+ */
+
+#include <gtsam/base/ThreadPool.h>
+#include <gtsam/base/timing.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+
+namespace gtsam {
+
+namespace {
+// Set while a thread is executing a loop body, to run nested loops serially
+thread_local bool tl_insideLoop = false;
+}
+
+/* ************************************************************************* */
+ThreadPool::ThreadPool(size_t numThreads) :
+    stop_(false), generation_(0), busy_(0), body_(0), n_(0), grain_(1),
+    next_(0) {
+  for (size_t i = 1; i < numThreads; ++i)
+    workers_.push_back(std::thread(&ThreadPool::workerLoop, this));
+}
+
+/* ************************************************************************* */
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_.notify_all();
+  for (std::thread& worker : workers_)
+    worker.join();
+}
+
+/* ************************************************************************* */
+void ThreadPool::runChunks() {
+  tl_insideLoop = true;
+  size_t begin;
+  while ((begin = next_.fetch_add(grain_)) < n_) {
+    try {
+      (*body_)(begin, std::min(begin + grain_, n_));
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_)
+        error_ = std::current_exception();
+      next_ = n_; // Stop handing out chunks
+    }
+  }
+  tl_insideLoop = false;
+}
+
+/* ************************************************************************* */
+void ThreadPool::workerLoop() {
+  // Loop bodies may contain gttic/gttoc, which only the calling thread records
+  internal::setTimingEnabledInThread(false);
+  size_t seen = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+      if (stop_)
+        return;
+      seen = generation_;
+    }
+    runChunks();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--busy_ == 0)
+        done_.notify_all();
+    }
+  }
+}
+
+/* ************************************************************************* */
+void ThreadPool::parallelFor(size_t n, const RangeFunction& body) {
+  if (n == 0)
+    return;
+
+  // Serial fallback: no workers, a single item, or called from a loop body
+  if (workers_.empty() || n == 1 || tl_insideLoop) {
+    body(0, n);
+    return;
+  }
+
+  std::lock_guard<std::mutex> call(callMutex_);
+
+  // A few chunks per thread balances uneven factor costs
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    body_ = &body;
+    n_ = n;
+    grain_ = std::max<size_t>(1, n / (8 * numThreads()));
+    next_ = 0;
+    error_ = std::exception_ptr();
+    busy_ = workers_.size();
+    ++generation_;
+  }
+  start_.notify_all();
+
+  // The calling thread works too
+  runChunks();
+
+  std::exception_ptr error;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&] { return busy_ == 0; });
+    body_ = 0;
+    error = error_;
+  }
+  if (error)
+    std::rethrow_exception(error);
+}
+
+/* ************************************************************************* */
+ThreadPool& ThreadPool::Shared(size_t numThreads) {
+  if (numThreads == 0)
+    numThreads = std::max(1u, std::thread::hardware_concurrency());
+  static std::mutex mutex;
+  static std::map<size_t, std::unique_ptr<ThreadPool> > pools;
+  std::lock_guard<std::mutex> lock(mutex);
+  std::unique_ptr<ThreadPool>& pool = pools[numThreads];
+  if (!pool)
+    pool.reset(new ThreadPool(numThreads));
+  return *pool;
+}
+
+} // namespace gtsam
@@ -0,0 +1,100 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file     ThreadPool.h
+ * @brief    A minimal std::thread pool for data-parallel loops, usable without TBB
+ * @date     Oct 15, 2026
+ * @addtogroup base
+ */
+
+#pragma once
+
+#include <gtsam/dllexport.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * A fixed-size pool of worker threads that runs parallel loops.
+ *
+ * The only operation is parallelFor, which splits an index range into chunks
+ * that the workers and the calling thread claim dynamically, and returns when
+ * all of them are done.  It is meant for loops over factors, where every
+ * iteration writes to its own output slot, so results do not depend on the
+ * number of threads.
+ *
+ * A pool of size 1 has no workers and simply runs the loop on the calling
+ * thread.  Calls from within a running loop (nested parallelism) are also run
+ * serially on the calling thread.
+ *
+ * gttic/gttoc in a loop body are only recorded for the chunks run by the
+ * calling thread, as the global timing tree is not thread-safe.
+ */
+class GTSAM_EXPORT ThreadPool {
+public:
+  /// Loop body, called with a half-open range [begin, end) of indices
+  typedef std::function<void(size_t begin, size_t end)> RangeFunction;
+
+  /// Create a pool using \c numThreads threads in total, including the caller
+  explicit ThreadPool(size_t numThreads);
+
+  /// Stops and joins all workers
+  ~ThreadPool();
+
+  /// Total number of threads used by parallelFor, including the caller
+  size_t numThreads() const { return workers_.size() + 1; }
+
+  /**
+   * Call \c body on chunks covering [0, n), in parallel, and wait until all
+   * chunks are done.  If \c body throws, the first exception is rethrown
+   * here after all threads have finished.
+   */
+  void parallelFor(size_t n, const RangeFunction& body);
+
+  /**
+   * A process-wide pool with \c numThreads threads, created on first use and
+   * shared by all callers asking for the same number of threads.  A value of
+   * 0 means std::thread::hardware_concurrency().
+   */
+  static ThreadPool& Shared(size_t numThreads);
+
+private:
+  ThreadPool(const ThreadPool&);            // not copyable
+  ThreadPool& operator=(const ThreadPool&); // not copyable
+
+  void workerLoop();
+  void runChunks();
+
+  std::vector<std::thread> workers_;
+  std::mutex callMutex_; ///< Serializes concurrent parallelFor calls
+  std::mutex mutex_;     ///< Protects the state below
+  std::condition_variable start_, done_;
+  bool stop_;
+  size_t generation_; ///< Incremented for every new loop
+  size_t busy_;       ///< Number of workers still working on the current loop
+
+  // The current loop
+  const RangeFunction* body_;
+  size_t n_, grain_;
+  std::atomic<size_t> next_;
+  std::exception_ptr error_;
+};
+
+} // namespace gtsam
@@ -17,6 +17,7 @@
 
 #include <CppUnitLite/TestHarness.h>
 #include <gtsam/base/SymmetricBlockMatrix.h>
+#include <gtsam/base/VerticalBlockMatrix.h>
 #include <boost/assign/list_of.hpp>
 
 using namespace std;
@@ -168,6 +169,35 @@ TEST(SymmetricBlockMatrix, inverseInPlace) {
   EXPECT(assert_equal(expectedInverse, symmMatrix.selfadjointView()));
 }
 
+/* ************************************************************************* */
+TEST(SymmetricBlockMatrix, resetBlocks) {
+  // Reference factorization in its own storage
+  const Matrix A = (Matrix(3, 6) << 1.0, 2.0, 0.3, -1.0, 0.5, 4.0,
+                                    0.0, 1.5, -2.0, 1.0, 0.2, 3.0,
+                                    0.7, 0.1, 1.0, 2.0, -1.0, 2.5).finished();
+  const Matrix info = A.transpose() * A + I_6x6;
+  SymmetricBlockMatrix expected(list_of(2)(3), info, true);
+  expected.choleskyPartial(1);
+  const VerticalBlockMatrix expectedRSd = expected.split(1);
+
+  // The same in the lower-right corner of larger storage
+  SymmetricBlockMatrix workspace;
+  workspace.resetBlocks(list_of(4)(5), true);
+  EXPECT_LONGS_EQUAL(10, workspace.capacity());
+  workspace.resetBlocks(list_of(2)(3), true);
+  EXPECT_LONGS_EQUAL(10, workspace.capacity());
+  EXPECT_LONGS_EQUAL(3, workspace.nBlocks());
+  EXPECT_LONGS_EQUAL(6, workspace.rows());
+  workspace.setFullMatrix(info);
+  workspace.choleskyPartial(1);
+  const VerticalBlockMatrix actualRSd = workspace.split(1);
+
+  EXPECT(assert_equal(Matrix(expectedRSd.full()), Matrix(actualRSd.full())));
+  EXPECT_LONGS_EQUAL(2, workspace.nBlocks());
+  EXPECT(assert_equal(Matrix(expected.selfadjointView()),
+                      Matrix(workspace.selfadjointView())));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
@@ -0,0 +1,94 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testThreadPool.cpp
+ * @brief   Unit tests for ThreadPool
+ */
+
+#include <gtsam/base/ThreadPool.h>
+#include <gtsam/base/timing.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST(ThreadPool, parallelFor) {
+  for (size_t numThreads = 1; numThreads <= 4; ++numThreads) {
+    ThreadPool pool(numThreads);
+    EXPECT_LONGS_EQUAL(numThreads, pool.numThreads());
+
+    // Every index is visited exactly once
+    std::vector<int> visited(1000, 0);
+    pool.parallelFor(visited.size(), [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) visited[i] += 1;
+    });
+    for (int v : visited) EXPECT_LONGS_EQUAL(1, v);
+
+    // Empty loops return immediately
+    pool.parallelFor(0, [](size_t, size_t) { throw std::runtime_error(""); });
+  }
+}
+
+/* ************************************************************************* */
+TEST(ThreadPool, exception) {
+  ThreadPool pool(3);
+  CHECK_EXCEPTION(pool.parallelFor(100,
+                                   [](size_t begin, size_t end) {
+                                     if (begin <= 50 && 50 < end)
+                                       throw std::runtime_error("50");
+                                   }),
+                  std::runtime_error);
+
+  // The pool is still usable afterwards
+  size_t count = 0;
+  pool.parallelFor(1, [&](size_t begin, size_t end) { count += end - begin; });
+  EXPECT_LONGS_EQUAL(1, count);
+}
+
+/* ************************************************************************* */
+TEST(ThreadPool, nested) {
+  ThreadPool& pool = ThreadPool::Shared(2);
+  EXPECT(&pool == &ThreadPool::Shared(2));
+
+  // Inner loops run serially on the calling thread
+  std::vector<int> visited(100, 0);
+  pool.parallelFor(10, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      pool.parallelFor(10, [&](size_t b, size_t e) {
+        for (size_t j = b; j < e; ++j) visited[10 * i + j] += 1;
+      });
+  });
+  for (int v : visited) EXPECT_LONGS_EQUAL(1, v);
+}
+
+/* ************************************************************************* */
+TEST(ThreadPool, timing) {
+  // Only the calling thread records tic/toc in loop bodies, so the global
+  // timing tree is not corrupted by the workers
+  ThreadPool pool(4);
+  for (size_t k = 0; k < 10; ++k)
+    pool.parallelFor(10000, [](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        gttic_(threadPoolBody);
+        gttoc_(threadPoolBody);
+      }
+    });
+  EXPECT(internal::gCurrentTimer.lock() == internal::gTimingRoot);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -154,6 +154,75 @@ TEST(treeTraversal, CloneForest)
   EXPECT(assert_container_equality(preOrderModifiedExpected, preOrder2ModActual));
 }
 
+/* ************************************************************************* */
+namespace parallel {
+// A binary tree, where every node checks that its children were post-visited first
+struct Node {
+  typedef boost::shared_ptr<Node> shared_ptr;
+  vector<shared_ptr> children;
+  int size;
+  bool preVisited, postVisited, childrenFirst;
+  explicit Node(int depth)
+      : size(1), preVisited(false), postVisited(false), childrenFirst(true) {
+    if (depth > 0) {
+      for (int i = 0; i < 2; ++i) {
+        children.push_back(boost::make_shared<Node>(depth - 1));
+        size += children.back()->size;
+      }
+    }
+  }
+  int problemSize() const { return size; }
+};
+
+struct Forest {
+  typedef parallel::Node Node;
+  FastVector<Node::shared_ptr> roots_;
+  const FastVector<Node::shared_ptr>& roots() const { return roots_; }
+};
+
+struct PreVisitor {
+  const Node* operator()(const Node::shared_ptr& node, const Node* parent) {
+    node->preVisited = parent ? parent->preVisited : true;
+    return node.get();
+  }
+};
+
+struct PostVisitor {
+  void operator()(const Node::shared_ptr& node, const Node* data) {
+    for (const Node::shared_ptr& child : node->children)
+      if (!child->postVisited) node->childrenFirst = false;
+    if (data != node.get()) node->childrenFirst = false;
+    node->postVisited = true;
+  }
+};
+
+bool allVisited(const Node& node) {
+  if (!node.preVisited || !node.postVisited || !node.childrenFirst)
+    return false;
+  for (const Node::shared_ptr& child : node.children)
+    if (!allVisited(*child)) return false;
+  return true;
+}
+}  // namespace parallel
+
+/* ************************************************************************* */
+TEST(treeTraversal, DepthFirstForestParallel)
+{
+  // Thresholds where the top of the trees, all of them, or none are split into tasks
+  for (int threshold : {0, 50, 10000}) {
+    parallel::Forest forest;
+    for (int i = 0; i < 3; ++i)
+      forest.roots_.push_back(boost::make_shared<parallel::Node>(8));
+    parallel::PreVisitor preVisitor;
+    parallel::PostVisitor postVisitor;
+    const parallel::Node* rootData = 0;
+    treeTraversal::DepthFirstForestParallel(forest, rootData, preVisitor,
+                                            postVisitor, threshold, 4);
+    for (const parallel::Node::shared_ptr& root : forest.roots_)
+      EXPECT(parallel::allVisited(*root));
+  }
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -28,6 +28,7 @@
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <stdexcept>
 #include <utility>
 
@@ -38,6 +39,9 @@ GTSAM_EXPORT boost::shared_ptr<TimingOutline> gTimingRoot(
     new TimingOutline("Total", getTicTocID("Total")));
 GTSAM_EXPORT boost::weak_ptr<TimingOutline> gCurrentTimer(gTimingRoot);
 
+// Whether tic/toc record anything on this thread
+static thread_local bool tl_timingEnabled = true;
+
 /* ************************************************************************* */
 // Implementation of TimingOutline
 /* ************************************************************************* */
@@ -221,6 +225,10 @@ size_t getTicTocID(const char *descriptionC) {
   static size_t nextId = 0;
   static gtsam::FastMap<std::string, size_t> idMap;
 
+  // IDs are created the first time a tic runs, possibly on several threads
+  static std::mutex idMutex;
+  std::lock_guard<std::mutex> lock(idMutex);
+
   // Retrieve or add this string
   gtsam::FastMap<std::string, size_t>::const_iterator it = idMap.find(
       description);
@@ -233,8 +241,15 @@ size_t getTicTocID(const char *descriptionC) {
   return it->second;
 }
 
+/* ************************************************************************* */
+void setTimingEnabledInThread(bool enabled) {
+  tl_timingEnabled = enabled;
+}
+
 /* ************************************************************************* */
 void tic(size_t id, const char *labelC) {
+  if (!tl_timingEnabled)
+    return;
   const std::string label(labelC);
   boost::shared_ptr<TimingOutline> node = //
       gCurrentTimer.lock()->child(id, label, gCurrentTimer);
@@ -244,6 +259,8 @@ void tic(size_t id, const char *labelC) {
 
 /* ************************************************************************* */
 void toc(size_t id, const char *label) {
+  if (!tl_timingEnabled)
+    return;
   boost::shared_ptr<TimingOutline> current(gCurrentTimer.lock());
   if (id != current->id_) {
     gTimingRoot->print();
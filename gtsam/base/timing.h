@@ -139,6 +139,10 @@ namespace gtsam {
     // Call toc on gCurrentTimer and then set gCurrentTimer to the parent of gCurrentTimer
     GTSAM_EXPORT void toc(size_t id, const char *label);
 
+    // Enable or disable tic/toc on the calling thread.  The timing tree is not
+    // thread-safe, so the workers of ThreadPool disable it for themselves.
+    GTSAM_EXPORT void setTimingEnabledInThread(bool enabled);
+
     /**
      * Timing Entry, arranged in a tree
      */
@@ -148,21 +148,31 @@ void DepthFirstForest(FOREST& forest, DATA& rootData, VISITOR_PRE& visitorPre) {
  *         its children, and will be passed, by reference, the \c DATA object returned by the
  *         call to \c visitorPre (the \c DATA object may be modified by visiting the children).
  *  @param rootData The data to pass by reference to \c visitorPre when it is called on each
- *         root node. */
+ *         root node.
+ *  @param problemSizeThreshold Children of nodes with a smaller problem size are processed in
+ *         the same task as their parent.
+ *  @param numThreads Without TBB, the number of threads of the built-in ThreadPool to use (0
+ *         means one per hardware thread, 1 traverses serially).  Ignored with TBB, which
+ *         always traverses in parallel. */
 template<class FOREST, typename DATA, typename VISITOR_PRE,
     typename VISITOR_POST>
 void DepthFirstForestParallel(FOREST& forest, DATA& rootData,
     VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost,
-    int problemSizeThreshold = 10) {
-#ifdef GTSAM_USE_TBB
+    int problemSizeThreshold = 10, size_t numThreads = 1) {
   // Typedefs
   typedef typename FOREST::Node Node;
 
+#ifdef GTSAM_USE_TBB
   tbb::task::spawn_root_and_wait(
       internal::CreateRootTask<Node>(forest.roots(), rootData, visitorPre,
           visitorPost, problemSizeThreshold));
 #else
-  DepthFirstForest(forest, rootData, visitorPre, visitorPost);
+  ThreadPool& pool = ThreadPool::Shared(numThreads);
+  if (pool.numThreads() == 1)
+    DepthFirstForest(forest, rootData, visitorPre, visitorPost);
+  else
+    internal::ThreadPoolTraversal<Node>(forest.roots(), rootData, visitorPre,
+        visitorPost, problemSizeThreshold, pool);
 #endif
 }
 
@@ -204,3 +204,138 @@ namespace gtsam {
 }
 
 #endif
+
+#include <gtsam/base/ThreadPool.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace gtsam {
+
+  /** Internal functions used for traversing trees */
+  namespace treeTraversal {
+
+    namespace internal {
+
+      /* ************************************************************************* */
+      /** Visit the children of \c node recursively, then \c node itself in post-order */
+      template<typename NODE, typename DATA, typename VISITOR_PRE, typename VISITOR_POST>
+      void ProcessNodeRecursively(const boost::shared_ptr<NODE>& node, DATA& myData,
+                                  VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost)
+      {
+        for(const boost::shared_ptr<NODE>& child: node->children)
+        {
+          DATA childData = visitorPre(child, myData);
+          ProcessNodeRecursively(child, childData, visitorPre, visitorPost);
+        }
+        (void) visitorPost(node, myData);
+      }
+
+      /* ************************************************************************* */
+      /** Depth-first traversal with the built-in ThreadPool, for builds without TBB.  Like the
+       *  TBB tasks above, a node with a problem size of at least \c problemSizeThreshold hands
+       *  each of its children to the pool as a separate task, and its post-order visit is run
+       *  by the thread that finishes its last child.  Smaller subtrees are traversed in a single
+       *  task.  The threads of the pool take tasks from a shared stack, so large sibling
+       *  subtrees are traversed concurrently.  As with TBB, the visitors must be safe to call
+       *  concurrently on different nodes. */
+      template<typename NODE, typename ROOTS, typename DATA, typename VISITOR_PRE,
+               typename VISITOR_POST>
+      void ThreadPoolTraversal(const ROOTS& roots, DATA& rootData, VISITOR_PRE& visitorPre,
+                               VISITOR_POST& visitorPost, int problemSizeThreshold,
+                               ThreadPool& pool)
+      {
+        struct Task {
+          boost::shared_ptr<NODE> treeNode;
+          DATA data;
+          Task* parent;
+          std::atomic<size_t> pending; ///< Number of children not finished yet
+          Task(const boost::shared_ptr<NODE>& treeNode, const DATA& data, Task* parent)
+              : treeNode(treeNode), data(data), parent(parent), pending(0) {}
+        };
+
+        // A deque does not move its elements, so children may refer to their parent's data
+        std::deque<Task> tasks;
+        std::vector<Task*> stack;
+        for(const boost::shared_ptr<NODE>& root: roots)
+        {
+          tasks.emplace_back(root, visitorPre(root, rootData), nullptr);
+          stack.push_back(&tasks.back());
+        }
+        size_t rootsLeft = stack.size();
+        if(rootsLeft == 0)
+          return;
+        bool failed = false;
+        std::mutex mutex; // Protects the state above
+        std::condition_variable ready;
+
+        // Called once the subtree of task is done, runs the post-order visits of the ancestors
+        // whose last child this was
+        auto finish = [&](Task* task) {
+          while(task->parent)
+          {
+            task = task->parent;
+            if(--task->pending > 0)
+              return;
+            (void) visitorPost(task->treeNode, task->data);
+          }
+          std::lock_guard<std::mutex> lock(mutex);
+          if(--rootsLeft == 0)
+            ready.notify_all();
+        };
+
+        auto run = [&](Task* task) {
+          const boost::shared_ptr<NODE>& node = task->treeNode;
+          if(node->children.empty() || node->problemSize() < problemSizeThreshold)
+          {
+            ProcessNodeRecursively(node, task->data, visitorPre, visitorPost);
+            finish(task);
+            return;
+          }
+          std::vector<DATA> childData;
+          childData.reserve(node->children.size());
+          for(const boost::shared_ptr<NODE>& child: node->children)
+            childData.push_back(visitorPre(child, task->data));
+          task->pending = node->children.size();
+          std::lock_guard<std::mutex> lock(mutex);
+          size_t i = 0;
+          for(const boost::shared_ptr<NODE>& child: node->children)
+          {
+            tasks.emplace_back(child, childData[i++], task);
+            stack.push_back(&tasks.back());
+          }
+          ready.notify_all();
+        };
+
+        // Every thread of the pool takes tasks until all roots are done
+        pool.parallelFor(pool.numThreads(), [&](size_t, size_t) {
+          std::unique_lock<std::mutex> lock(mutex);
+          while(true)
+          {
+            ready.wait(lock, [&] { return failed || rootsLeft == 0 || !stack.empty(); });
+            if(failed || rootsLeft == 0)
+              return;
+            Task* task = stack.back();
+            stack.pop_back();
+            lock.unlock();
+            try {
+              run(task);
+            } catch(...) {
+              lock.lock();
+              failed = true;
+              ready.notify_all();
+              throw;
+            }
+            lock.lock();
+          }
+        });
+      }
+
+    }
+
+  }
+
+}
@@ -134,6 +134,55 @@ Point2 PinholeBase::project2(const Point3& point, OptionalJacobian<2, 6> Dpose,
   return pn;
 }
 
+/* ************************************************************************* */
+void PinholeBase::ProjectBatch(const Point3& point, const PoseBatch& poses,
+    ProjectionBatch& result) {
+  auto R = [&poses](int i, int j) { return poses.row(i + 3 * j).array(); };
+
+  // Transform to camera coordinates, q = R' * (point - t)
+  Eigen::Array<double, 6, Eigen::Dynamic, Eigen::RowMajor> scratch(6, poses.cols());
+  auto dx = scratch.row(0), dy = scratch.row(1), dz = scratch.row(2);
+  auto d = scratch.row(3), u = scratch.row(4), v = scratch.row(5);
+  dx = point.x() - poses.row(9).array();
+  dy = point.y() - poses.row(10).array();
+  dz = point.z() - poses.row(11).array();
+  d = R(0, 2) * dx + R(1, 2) * dy + R(2, 2) * dz;
+#ifdef GTSAM_THROW_CHEIRALITY_EXCEPTION
+  if ((d <= 0).any())
+    throw CheiralityException();
+#endif
+  d = d.inverse();
+  u = (R(0, 0) * dx + R(1, 0) * dy + R(2, 0) * dz) * d;
+  v = (R(0, 1) * dx + R(1, 1) * dy + R(2, 1) * dz) * d;
+
+  result.resize(20, poses.cols());
+  result.row(0) = u;
+  result.row(1) = v;
+
+  // Same as Dpose
+  auto Dpose = [&result](int i, int j) {
+    return result.row(2 + 6 * i + j).array();
+  };
+  Dpose(0, 0) = u * v;
+  Dpose(0, 1) = -1 - u * u;
+  Dpose(0, 2) = v;
+  Dpose(0, 3) = -d;
+  Dpose(0, 4).setZero();
+  Dpose(0, 5) = d * u;
+  Dpose(1, 0) = 1 + v * v;
+  Dpose(1, 1) = -u * v;
+  Dpose(1, 2) = -u;
+  Dpose(1, 3).setZero();
+  Dpose(1, 4) = -d;
+  Dpose(1, 5) = d * v;
+
+  // Same as Dpoint, with Rt(i, j) = R(j, i)
+  for (int j = 0; j < 3; j++) {
+    result.row(14 + j) = d * (R(j, 0) - u * R(j, 2));
+    result.row(17 + j) = d * (R(j, 1) - v * R(j, 2));
+  }
+}
+
 /* ************************************************************************* */
 Point2 PinholeBase::project2(const Unit3& pw, OptionalJacobian<2, 6> Dpose,
     OptionalJacobian<2, 2> Dpoint) const {
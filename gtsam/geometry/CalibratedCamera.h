@@ -209,6 +209,24 @@ public:
       OptionalJacobian<2, 6> Dpose = boost::none,
       OptionalJacobian<2, 2> Dpoint = boost::none) const;
 
+  /// Poses of m cameras, structure-of-arrays: rows 0-8 hold the column-major
+  /// rotation matrices and rows 9-11 the translations, every row contiguous
+  typedef Eigen::Matrix<double, 12, Eigen::Dynamic, Eigen::RowMajor> PoseBatch;
+
+  /// Projections of a point into m cameras: rows 0-1 hold the intrinsic
+  /// coordinates, rows 2-13 the row-major 2x6 derivatives wrpt the pose, and
+  /// rows 14-19 the row-major 2x3 derivatives wrpt the point
+  typedef Eigen::Matrix<double, 20, Eigen::Dynamic, Eigen::RowMajor> ProjectionBatch;
+
+  /**
+   * Project a point into m cameras at once, with the derivatives of project2.
+   * Every step works on rows of m values, which Eigen vectorizes.
+   * Throws a CheiralityException if the point is behind any of the image
+   * planes iff GTSAM_THROW_CHEIRALITY_EXCEPTION
+   */
+  static void ProjectBatch(const Point3& point, const PoseBatch& poses,
+      ProjectionBatch& result);
+
   /// backproject a 2-dimensional point to a 3-dimensional point at given depth
   static Point3 BackprojectFromCamera(const Point2& p, const double depth,
                                       OptionalJacobian<3, 2> Dpoint = boost::none,
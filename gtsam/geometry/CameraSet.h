@@ -20,14 +20,30 @@
 
 #include <gtsam/geometry/Point3.h>
 #include <gtsam/geometry/CalibratedCamera.h>  // for Cheirality exception
+#include <gtsam/geometry/PinholePose.h>
 #include <gtsam/base/Testable.h>
 #include <gtsam/base/SymmetricBlockMatrix.h>
 #include <gtsam/base/FastMap.h>
 #include <gtsam/inference/Key.h>
+#include <type_traits>
 #include <vector>
 
 namespace gtsam {
 
+namespace internal {
+/// Whether CameraSet projects a POINT into all CAMERAs at once: a Point3 into
+/// cameras derived from PinholeBaseK
+template<class CAMERA, class POINT, class = void>
+struct BatchProjectable : std::false_type {
+};
+
+template<class CAMERA>
+struct BatchProjectable<CAMERA, Point3, typename std::enable_if<
+    std::is_base_of<PinholeBaseK<typename CAMERA::CalibrationType>,
+        CAMERA>::value>::type> : std::true_type {
+};
+} // \ namespace internal
+
 /**
  * @brief A set of cameras, all with their own calibration
  */
@@ -101,12 +117,27 @@ public:
    * Project a point (possibly Unit3 at infinity), with derivatives
    * Note that F is a sparse block-diagonal matrix, so instead of a large dense
    * matrix this function returns the diagonal blocks.
+   * With derivatives, a Point3 is projected into many pinhole cameras at
+   * once, see PinholeBase::ProjectBatch.
    * throws CheiralityException
    */
   template<class POINT>
   ZVector project2(const POINT& point, //
       boost::optional<FBlocks&> Fs = boost::none, //
       boost::optional<Matrix&> E = boost::none) const {
+    return project2(point, Fs, E,
+        internal::BatchProjectable<CAMERA, POINT>());
+  }
+
+private:
+
+  /// Fewest cameras for which project2 projects all at once
+  static const size_t kMinBatchSize = 4;
+
+  /// Project into one camera at a time
+  template<class POINT>
+  ZVector project2(const POINT& point, boost::optional<FBlocks&> Fs,
+      boost::optional<Matrix&> E, std::false_type) const {
 
     static const int N = FixedDimension<POINT>::value;
 
@@ -131,6 +162,64 @@ public:
     return z;
   }
 
+  /// Project into all pinhole cameras at once, then apply the calibrations
+  ZVector project2(const Point3& point, boost::optional<FBlocks&> Fs,
+      boost::optional<Matrix&> E, std::true_type) const {
+
+    const size_t m = this->size();
+    if ((!Fs && !E) || m < kMinBatchSize)
+      return project2(point, Fs, E, std::false_type());
+
+    // Gather the poses, structure-of-arrays
+    PinholeBase::PoseBatch poses(12, m);
+    for (size_t i = 0; i < m; i++) {
+      const Pose3& pose = this->at(i).pose();
+      const Matrix3 R = pose.rotation().matrix();
+      poses.col(i) << Eigen::Map<const Vector9>(R.data()), pose.translation();
+    }
+    PinholeBase::ProjectionBatch projections;
+    PinholeBase::ProjectBatch(point, poses, projections);
+
+    // Views on the derivatives of camera i, strided in the batch
+    typedef Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic> Strided;
+    typedef Eigen::Map<const Eigen::Matrix<double, 2, 6, Eigen::RowMajor>, 0,
+        Strided> Dpose;
+    typedef Eigen::Map<const Eigen::Matrix<double, 2, 3, Eigen::RowMajor>, 0,
+        Strided> Dpoint;
+    const double* data = projections.data();
+
+    typedef typename CAMERA::CalibrationType Calibration;
+    static const int DimK = FixedDimension<Calibration>::value;
+
+    ZVector z;
+    z.reserve(m);
+    if (E) E->resize(ZDim * m, 3);
+    if (Fs) Fs->resize(m);
+
+    // Uncalibrate and apply the chain rule, the camera is [pose, calibration]
+    // or only the pose
+    for (size_t i = 0; i < m; i++) {
+      Matrix2 Dpi_pn;
+      Eigen::Matrix<double, 2, DimK> Dcal;
+      z.emplace_back(this->at(i).calibration().uncalibrate(
+          Point2(projections(0, i), projections(1, i)),
+          Fs && D > 6 ? &Dcal : 0, Dpi_pn));
+      if (Fs) {
+        MatrixZD& Fi = (*Fs)[i];
+        Fi.template leftCols<6>().noalias() = Dpi_pn
+            * Dpose(data + 2 * m + i, Strided(6 * m, m));
+        if (D > 6) Fi.rightCols(D - 6) = Dcal;
+      }
+      if (E)
+        E->block<2, 3>(2 * i, 0).noalias() = Dpi_pn
+            * Dpoint(data + 14 * m + i, Strided(3 * m, m));
+    }
+
+    return z;
+  }
+
+public:
+
   /// Calculate vector [project2(point)-z] of re-projection errors
   template<class POINT>
   Vector reprojectionError(const POINT& point, const ZVector& measured,
@@ -126,6 +126,43 @@ TEST(CameraSet, Pinhole) {
   EXPECT(assert_equal(actualE, E));
 }
 
+/* ************************************************************************* */
+// Many cameras are projected into at once, compare with one at a time
+template<class CAMERA>
+static bool batchProjectionIsExact(const CameraSet<CAMERA>& set,
+    const Point3& p) {
+  typename CameraSet<CAMERA>::FBlocks Fs;
+  Matrix E;
+  const Point2Vector z = set.project2(p, Fs, E);
+  if (z.size() != set.size() || Fs.size() != set.size()) return false;
+  bool exact = true;
+  for (size_t i = 0; i < set.size(); i++) {
+    typename CameraSet<CAMERA>::MatrixZD Fi;
+    Matrix23 Ei;
+    exact = assert_equal(set[i].project2(p, Fi, Ei), z[i], 1e-9) && exact;
+    exact = assert_equal(Fi, Fs[i], 1e-9) && exact;
+    exact = assert_equal(Ei, Matrix(E.block<2, 3>(2 * i, 0)), 1e-9) && exact;
+  }
+  return exact;
+}
+
+#include <gtsam/geometry/Cal3_S2.h>
+TEST(CameraSet, BatchProjection) {
+  CameraSet<PinholeCamera<Cal3Bundler> > bundlerSet;
+  CameraSet<PinholePose<Cal3_S2> > poseSet;
+  const boost::shared_ptr<Cal3_S2> K(new Cal3_S2(500, 480, 0.1, 320, 240));
+  for (size_t i = 0; i < 9; i++) {
+    const Pose3 pose(Rot3::Ypr(0.1 * i, -0.05 * i, 0.02 * i),
+        Point3(0.3 * i, -0.1 * i, -5.0 + 0.2 * i));
+    bundlerSet.push_back(PinholeCamera<Cal3Bundler>(pose,
+        Cal3Bundler(500 + i, 1e-3 * i, -1e-4 * i)));
+    poseSet.push_back(PinholePose<Cal3_S2>(pose, K));
+  }
+  const Point3 p(0.5, -0.4, 1.0);
+  EXPECT(batchProjectionIsExact(bundlerSet, p));
+  EXPECT(batchProjectionIsExact(poseSet, p));
+}
+
 /* ************************************************************************* */
 #include <gtsam/geometry/StereoCamera.h>
 TEST(CameraSet, Stereo) {
@@ -29,7 +29,8 @@ namespace gtsam {
   boost::shared_ptr<typename EliminateableFactorGraph<FACTORGRAPH>::BayesNetType>
     EliminateableFactorGraph<FACTORGRAPH>::eliminateSequential(
     OptionalOrdering ordering, const Eliminate& function,
-    OptionalVariableIndex variableIndex, OptionalOrderingType orderingType) const
+    OptionalVariableIndex variableIndex, OptionalOrderingType orderingType,
+    size_t numThreads) const
   {
     if(ordering && variableIndex) {
       gttic(eliminateSequential);
@@ -37,7 +38,7 @@ namespace gtsam {
       EliminationTreeType etree(asDerived(), *variableIndex, *ordering);
       boost::shared_ptr<BayesNetType> bayesNet;
       boost::shared_ptr<FactorGraphType> factorGraph;
-      boost::tie(bayesNet,factorGraph) = etree.eliminate(function);
+      boost::tie(bayesNet,factorGraph) = etree.eliminate(function, numThreads);
       // If any factors are remaining, the ordering was incomplete
       if(!factorGraph->empty())
         throw InconsistentEliminationRequested();
@@ -49,7 +50,7 @@ namespace gtsam {
       // for no variable index first so that it's always computed if we need to call COLAMD because
       // no Ordering is provided.
       VariableIndex computedVariableIndex(asDerived());
-      return eliminateSequential(ordering, function, computedVariableIndex, orderingType);
+      return eliminateSequential(ordering, function, computedVariableIndex, orderingType, numThreads);
     }
     else /*if(!ordering)*/ {
       // If no Ordering provided, compute one and call this function again.  We are guaranteed to
@@ -57,10 +58,10 @@ namespace gtsam {
       // block.
       if (orderingType == Ordering::METIS) {
         Ordering computedOrdering = Ordering::Metis(asDerived());
-        return eliminateSequential(computedOrdering, function, variableIndex, orderingType);
+        return eliminateSequential(computedOrdering, function, variableIndex, orderingType, numThreads);
       } else {
         Ordering computedOrdering = Ordering::Colamd(*variableIndex);
-        return eliminateSequential(computedOrdering, function, variableIndex, orderingType);
+        return eliminateSequential(computedOrdering, function, variableIndex, orderingType, numThreads);
       }
     }
   }
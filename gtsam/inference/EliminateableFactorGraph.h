@@ -120,12 +120,17 @@ namespace gtsam {
      *  Data data = otherFunctionUsingVariableIndex(graph, varIndex); // Other code that uses variable index
      *  boost::shared_ptr<GaussianBayesNet> result = graph.eliminateSequential(EliminateQR, boost::none, varIndex);
      *  \endcode
+     *
+     *  Independent subtrees of the elimination tree are eliminated in parallel with TBB or,
+     *  without TBB, on \c numThreads threads (0 for all cores).  The Bayes net does not depend
+     *  on the number of threads.
      *  */
     boost::shared_ptr<BayesNetType> eliminateSequential(
       OptionalOrdering ordering = boost::none,
       const Eliminate& function = EliminationTraitsType::DefaultEliminate,
       OptionalVariableIndex variableIndex = boost::none,
-      OptionalOrderingType orderingType = boost::none) const;
+      OptionalOrderingType orderingType = boost::none,
+      size_t numThreads = 1) const;
 
     /** Do multifrontal elimination of all variables to produce a Bayes tree.  If an ordering is not
      *  provided, the ordering will be computed using either COLAMD or METIS, dependeing on
@@ -19,8 +19,10 @@
 
 #include <boost/make_shared.hpp>
 #include <boost/bind.hpp>
+#include <algorithm>
 #include <stack>
 
+#include <gtsam/base/ThreadPool.h>
 #include <gtsam/base/timing.h>
 #include <gtsam/base/treeTraversal-inst.h>
 #include <gtsam/inference/EliminationTree.h>
@@ -45,7 +47,9 @@ namespace gtsam {
     FactorGraphType gatheredFactors;
     gatheredFactors.reserve(factors.size() + children.size());
     gatheredFactors.push_back(factors.begin(), factors.end());
-    gatheredFactors.push_back(childrenResults.begin(), childrenResults.end());
+    for(const sharedFactor& childFactor: childrenResults)
+      if(childFactor)
+        gatheredFactors.push_back(childFactor);
 
     // Do dense elimination step
     KeyVector keyAsVector(1); keyAsVector[0] = key;
@@ -132,6 +136,8 @@ namespace gtsam {
           }
           prevCol[i] = j;
         }
+        for(const sharedNode& child: node->children)
+          node->problemSize_ += child->problemSize_;
         nodes[j] = node;
       }
     } catch(std::invalid_argument& e) {
@@ -182,22 +188,104 @@ namespace gtsam {
     return *this;
   }
 
+  /* ************************************************************************* */
+  // Data for the elimination of a node.  Every child writes its remaining factor into its own
+  // slot of the parent's childFactors, and its conditional into its own slot of the Bayes net,
+  // so that subtrees can be eliminated in parallel.  The slot in the Bayes net is the position
+  // of the node in a serial post-order traversal, computed from the sizes of the subtrees.
+  template<class ETREE>
+  struct EliminationTreeData {
+    EliminationTreeData* const parentData;
+    size_t myIndexInParent;
+    size_t nextPosition; ///< Position of the first node of the next child subtree
+    size_t position; ///< Position of this node's conditional in the Bayes net
+    FastVector<typename ETREE::sharedFactor> childFactors;
+
+    EliminationTreeData(EliminationTreeData* _parentData, size_t nChildren, size_t problemSize) :
+      parentData(_parentData), myIndexInParent(0), nextPosition(0), position(0)
+    {
+      childFactors.reserve(nChildren);
+      if(parentData) {
+        myIndexInParent = parentData->childFactors.size();
+        parentData->childFactors.push_back(typename ETREE::sharedFactor());
+        nextPosition = parentData->nextPosition;
+        position = nextPosition + problemSize - 1;
+        parentData->nextPosition += problemSize;
+      }
+    }
+
+    static EliminationTreeData EliminationPreOrderVisitor(
+      const typename ETREE::sharedNode& node, EliminationTreeData& parentData)
+    {
+      return EliminationTreeData(&parentData, node->children.size(), node->problemSize());
+    }
+
+    class EliminationPostOrderVisitor {
+      typename ETREE::BayesNetType& result_;
+      const typename ETREE::Eliminate& function_;
+
+    public:
+      EliminationPostOrderVisitor(typename ETREE::BayesNetType& result,
+        const typename ETREE::Eliminate& function) : result_(result), function_(function) {}
+
+      void operator()(const typename ETREE::sharedNode& node, EliminationTreeData& myData)
+      {
+        // Gather factors
+        typename ETREE::FactorGraphType gatheredFactors;
+        gatheredFactors.reserve(node->factors.size() + node->children.size());
+        gatheredFactors.push_back(node->factors.begin(), node->factors.end());
+        for(const typename ETREE::sharedFactor& childFactor: myData.childFactors)
+          if(childFactor)
+            gatheredFactors.push_back(childFactor);
+
+        // Do dense elimination step
+        KeyVector keyAsVector(1); keyAsVector[0] = node->key;
+        auto eliminationResult = function_(gatheredFactors, Ordering(keyAsVector));
+
+        // Store the conditional in its slot, and the remaining factor in the parent's slot
+        result_[myData.position] = eliminationResult.first;
+        if(eliminationResult.second && !eliminationResult.second->empty())
+          myData.parentData->childFactors[myData.myIndexInParent] = eliminationResult.second;
+      }
+    };
+  };
+
   /* ************************************************************************* */
   template<class BAYESNET, class GRAPH>
   std::pair<boost::shared_ptr<BAYESNET>, boost::shared_ptr<GRAPH> >
-    EliminationTree<BAYESNET,GRAPH>::eliminate(Eliminate function) const
+    EliminationTree<BAYESNET,GRAPH>::eliminate(Eliminate function, size_t numThreads) const
   {
     gttic(EliminationTree_eliminate);
-    // Allocate result
+    // Allocate result, with one slot per node
+    size_t nrNodes = 0;
+    for(const sharedNode& root: roots_)
+      nrNodes += root->problemSize();
     auto result = boost::make_shared<BayesNetType>();
+    result->resize(nrNodes);
+
+    // Subtrees with fewer nodes are eliminated as a whole by one thread
+    int problemSizeThreshold = 10;
+#ifndef GTSAM_USE_TBB
+    const size_t nrThreads = ThreadPool::Shared(numThreads).numThreads();
+    problemSizeThreshold = std::max(problemSizeThreshold, int(nrNodes / (4 * nrThreads)));
+#endif
 
     // Run tree elimination algorithm
-    FastVector<sharedFactor> remainingFactors = inference::EliminateTree(result, *this, function);
+    typedef EliminationTreeData<This> Data;
+    Data rootData(0, roots_.size(), 0);
+    typename Data::EliminationPostOrderVisitor visitorPost(*result, function);
+    {
+      TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+      treeTraversal::DepthFirstForestParallel(*this, rootData, Data::EliminationPreOrderVisitor,
+        visitorPost, problemSizeThreshold, numThreads);
+    }
 
     // Add remaining factors that were not involved with eliminated variables
     auto allRemainingFactors = boost::make_shared<FactorGraphType>();
     allRemainingFactors->push_back(remainingFactors_.begin(), remainingFactors_.end());
-    allRemainingFactors->push_back(remainingFactors.begin(), remainingFactors.end());
+    for(const sharedFactor& factor: rootData.childFactors)
+      if(factor)
+        allRemainingFactors->push_back(factor);
 
     // Return result
     return std::make_pair(result, allRemainingFactors);
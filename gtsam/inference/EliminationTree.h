@@ -70,6 +70,10 @@ namespace gtsam {
       Key key; ///< key associated with root
       Factors factors; ///< factors associated with root
       Children children; ///< sub-trees
+      int problemSize_ = 1; ///< number of nodes in this sub-tree
+
+      /// Number of nodes in this sub-tree, used to decide what to eliminate in parallel
+      int problemSize() const { return problemSize_; }
 
       sharedFactor eliminate(const boost::shared_ptr<BayesNetType>& output,
         const Eliminate& function, const FastVector<sharedFactor>& childrenFactors) const;
@@ -121,13 +125,17 @@ namespace gtsam {
     /// @name Standard Interface
     /// @{
 
-    /** Eliminate the factors to a Bayes net and remaining factor graph
+    /** Eliminate the factors to a Bayes net and remaining factor graph.  Independent subtrees
+    * are eliminated in parallel with TBB or, without TBB, on \c numThreads threads of the
+    * built-in ThreadPool.  The conditionals are in the same order as in a serial elimination.
     * @param function The function to use to eliminate, see the namespace functions
     * in GaussianFactorGraph.h
+    * @param numThreads Without TBB, the number of threads to use (0 means one per hardware
+    * thread, 1 eliminates serially).  Ignored with TBB.
     * @return The Bayes net and factor graph resulting from elimination
     */
     std::pair<boost::shared_ptr<BayesNetType>, boost::shared_ptr<FactorGraphType> >
-      eliminate(Eliminate function) const;
+      eliminate(Eliminate function, size_t numThreads = 1) const;
 
     /// @}
     /// @name Testable
@@ -22,6 +22,7 @@
 #include <boost/format.hpp>
 
 #include <gtsam/inference/Ordering.h>
+#include <gtsam/base/ThreadPool.h>
 #include <gtsam/3rdparty/CCOLAMD/Include/ccolamd.h>
 
 #ifdef GTSAM_SUPPORT_NESTED_DISSECTION
@@ -32,6 +33,144 @@ using namespace std;
 
 namespace gtsam {
 
+namespace {
+
+/* ************************************************************************* */
+// Call CCOLAMD on the column-compressed pattern (A, p) with nRows rows and
+// p.size() - 1 columns.  A has to be of the size recommended by CCOLAMD, and
+// the column permutation is returned in p.
+void callCcolamd(size_t nRows, vector<int>& A, vector<int>& p,
+    vector<int>& cmember) {
+  double knobs[CCOLAMD_KNOBS];
+  ccolamd_set_defaults(knobs);
+  knobs[CCOLAMD_DENSE_ROW] = -1;
+  knobs[CCOLAMD_DENSE_COL] = -1;
+
+  int stats[CCOLAMD_STATS];
+  int rv = ccolamd((int) nRows, (int) p.size() - 1, (int) A.size(), &A[0],
+      &p[0], knobs, stats, &cmember[0]);
+  if (rv != 1)
+    throw runtime_error(
+        (boost::format("ccolamd failed with return value %1%") % rv).str());
+}
+
+/* ************************************************************************* */
+// The variables of a VariableIndex by position, with their factors, and the
+// variables of each factor.  Two variables are adjacent if they share a factor.
+struct BipartiteGraph {
+  vector<const VariableIndex::Factors*> factors;  // Of each variable
+  vector<size_t> starts;  // Of the variables of each factor, in variables
+  vector<size_t> variables;
+
+  explicit BipartiteGraph(const VariableIndex& variableIndex) {
+    factors.reserve(variableIndex.size());
+    starts.assign(variableIndex.nFactors() + 1, 0);
+    for (const VariableIndex::value_type& key_factors : variableIndex) {
+      factors.push_back(&key_factors.second);
+      for (size_t i : key_factors.second) ++starts[i + 1];
+    }
+    for (size_t i = 0; i + 1 < starts.size(); ++i) starts[i + 1] += starts[i];
+    variables.resize(starts.back());
+    vector<size_t> next(starts.begin(), starts.end() - 1);
+    for (size_t j = 0; j < factors.size(); ++j)
+      for (size_t i : *factors[j]) variables[next[i]++] = j;
+  }
+
+  // Breadth-first search from root over the unmarked variables, which are
+  // marked and appended to order.  Returns the start of each level in order.
+  vector<size_t> breadthFirst(size_t root, vector<char>& marked,
+      vector<size_t>& order) const {
+    vector<size_t> levelStarts;
+    marked[root] = 1;
+    order.push_back(root);
+    for (size_t level = order.size() - 1; level < order.size();) {
+      levelStarts.push_back(level);
+      const size_t levelEnd = order.size();
+      for (size_t q = level; q < levelEnd; ++q)
+        for (size_t i : *factors[order[q]])
+          for (size_t k = starts[i]; k < starts[i + 1]; ++k)
+            if (!marked[variables[k]]) {
+              marked[variables[k]] = 1;
+              order.push_back(variables[k]);
+            }
+      level = levelEnd;
+    }
+    return levelStarts;
+  }
+};
+
+/* ************************************************************************* */
+// Order the variables of one part by constrained COLAMD on the factors that
+// involve them, with the separator variables of those factors last, and
+// return the keys of the part in that order.  The factors of the part are
+// numbered in localRow, which the other parts do not touch: the variables of
+// a factor are adjacent, so they are in at most one part and the separators.
+KeyVector orderPart(const BipartiteGraph& graph, const KeyVector& keys,
+    const vector<size_t>& part, size_t p, const vector<size_t>& members,
+    vector<int>& localRow) {
+  if (members.size() <= 1) {
+    KeyVector result;
+    for (size_t j : members) result.push_back(keys[j]);
+    return result;
+  }
+
+  // Factors of the part, in the order of the graph like the variables
+  vector<size_t> rows;
+  for (size_t j : members)
+    for (size_t i : *graph.factors[j])
+      if (localRow[i] < 0) {
+        localRow[i] = 0;
+        rows.push_back(i);
+      }
+  sort(rows.begin(), rows.end());
+  for (size_t r = 0; r < rows.size(); ++r) localRow[rows[r]] = (int) r;
+
+  // Entries of the separator variables in those factors, by variable
+  vector<pair<size_t, int> > separatorEntries;
+  for (size_t r = 0; r < rows.size(); ++r)
+    for (size_t k = graph.starts[rows[r]]; k < graph.starts[rows[r] + 1]; ++k)
+      if (part[graph.variables[k]] != p)
+        separatorEntries.push_back(make_pair(graph.variables[k], (int) r));
+  sort(separatorEntries.begin(), separatorEntries.end());
+  size_t nEntries = separatorEntries.size(), nColumns = members.size();
+  for (size_t e = 0; e < separatorEntries.size(); ++e)
+    if (e == 0 || separatorEntries[e].first != separatorEntries[e - 1].first)
+      ++nColumns;
+  for (size_t j : members) nEntries += graph.factors[j]->size();
+
+  // Column-compressed pattern, the part's variables followed by the separators
+  vector<int> A(ccolamd_recommended((int) nEntries, (int) rows.size(),
+      (int) nColumns));
+  vector<int> pointers(1, 0);
+  pointers.reserve(nColumns + 1);
+  vector<size_t> columns(members);
+  int count = 0;
+  for (size_t j : members) {
+    for (size_t i : *graph.factors[j]) A[count++] = localRow[i];
+    pointers.push_back(count);
+  }
+  for (size_t e = 0; e < separatorEntries.size(); ++e) {
+    A[count++] = separatorEntries[e].second;
+    if (e + 1 == separatorEntries.size() ||
+        separatorEntries[e + 1].first != separatorEntries[e].first) {
+      columns.push_back(separatorEntries[e].first);
+      pointers.push_back(count);
+    }
+  }
+  vector<int> cmember(nColumns, 0);
+  fill(cmember.begin() + members.size(), cmember.end(), 1);
+  callCcolamd(rows.size(), A, pointers, cmember);
+
+  KeyVector result;
+  result.reserve(members.size());
+  for (size_t c = 0; c < nColumns; ++c)
+    if ((size_t) pointers[c] < members.size())
+      result.push_back(keys[columns[pointers[c]]]);
+  return result;
+}
+
+}  // namespace
+
 /* ************************************************************************* */
 FastMap<Key, size_t> Ordering::invert() const {
   FastMap<Key, size_t> inverted;
@@ -91,26 +230,12 @@ Ordering Ordering::ColamdConstrained(const VariableIndex& variableIndex,
 
   assert((size_t)count == variableIndex.nEntries());
 
-  //double* knobs = NULL; /* colamd arg 6: parameters (uses defaults if NULL) */
-  double knobs[CCOLAMD_KNOBS];
-  ccolamd_set_defaults(knobs);
-  knobs[CCOLAMD_DENSE_ROW] = -1;
-  knobs[CCOLAMD_DENSE_COL] = -1;
-
-  int stats[CCOLAMD_STATS]; /* colamd arg 7: colamd output statistics and error codes */
-
   gttoc(Prepare);
 
   // call colamd, result will be in p
-  /* returns (1) if successful, (0) otherwise*/
-  if (nVars > 0) {
-    gttic(ccolamd);
-    int rv = ccolamd((int) nFactors, (int) nVars, (int) Alen, &A[0], &p[0],
-        knobs, stats, &cmember[0]);
-    if (rv != 1)
-      throw runtime_error(
-          (boost::format("ccolamd failed with return value %1%") % rv).str());
-  }
+  gttic(ccolamd);
+  callCcolamd(nFactors, A, p, cmember);
+  gttoc(ccolamd);
 
   //  ccolamd_report(stats);
 
@@ -208,6 +333,75 @@ Ordering Ordering::ColamdConstrained(const VariableIndex& variableIndex,
   return Ordering::ColamdConstrained(variableIndex, cmember);
 }
 
+/* ************************************************************************* */
+Ordering Ordering::ColamdParallel(const VariableIndex& variableIndex,
+    size_t numThreads) {
+  gttic(Ordering_COLAMDParallel);
+  ThreadPool& pool = ThreadPool::Shared(numThreads);
+  const size_t numParts = pool.numThreads(), nVars = variableIndex.size();
+  static const size_t kMinPartSize = 1000;
+  if (numParts == 1 || nVars < kMinPartSize * numParts)
+    return Colamd(variableIndex);
+
+  const BipartiteGraph graph(variableIndex);
+  KeyVector keys;
+  keys.reserve(nVars);
+  for (const VariableIndex::value_type& key_factors : variableIndex)
+    keys.push_back(key_factors.first);
+
+  // Level structure of each connected component, from its first variable,
+  // which in SLAM is usually the start of the trajectory
+  gttic(levels);
+  vector<char> marked(nVars, 0);
+  vector<size_t> order, levelStarts;
+  order.reserve(nVars);
+  for (size_t root = 0; root < nVars; ++root) {
+    if (marked[root]) continue;
+    const vector<size_t> starts = graph.breadthFirst(root, marked, order);
+    levelStarts.insert(levelStarts.end(), starts.begin(), starts.end());
+  }
+  levelStarts.push_back(nVars);
+  gttoc(levels);
+
+  // Cut the levels into parts of about equal size, each separated from the
+  // next one by the level that crosses the boundary
+  const size_t separator = numParts;
+  vector<size_t> part(nVars);
+  vector<vector<size_t> > members(numParts);
+  KeyVector separators;
+  size_t p = 0;
+  for (size_t l = 0; l + 1 < levelStarts.size(); ++l) {
+    const size_t begin = levelStarts[l], end = levelStarts[l + 1];
+    const bool cut = p + 1 < numParts && end >= (p + 1) * nVars / numParts;
+    for (size_t q = begin; q < end; ++q) {
+      part[order[q]] = cut ? separator : p;
+      if (cut)
+        separators.push_back(keys[order[q]]);
+      else
+        members[p].push_back(order[q]);
+    }
+    if (cut) ++p;
+  }
+
+  // COLAMD is faster on variables in key order than in breadth-first order
+  for (vector<size_t>& partMembers : members)
+    sort(partMembers.begin(), partMembers.end());
+
+  // Order the parts in parallel, followed by the separators
+  vector<KeyVector> partOrders(numParts);
+  vector<int> localRow(variableIndex.nFactors(), -1);
+  pool.parallelFor(numParts, [&](size_t begin, size_t end) {
+    for (size_t q = begin; q < end; ++q)
+      partOrders[q] = orderPart(graph, keys, part, q, members[q], localRow);
+  });
+  Ordering result;
+  result.reserve(nVars);
+  for (const KeyVector& partOrder : partOrders)
+    result.insert(result.end(), partOrder.begin(), partOrder.end());
+  result.insert(result.end(), separators.begin(), separators.end());
+  return result;
+}
+
 /* ************************************************************************* */
 Ordering Ordering::Metis(const MetisIndex& met) {
 #ifdef GTSAM_SUPPORT_NESTED_DISSECTION
@@ -246,6 +440,38 @@ Ordering Ordering::Metis(const MetisIndex& met) {
 #endif
 }
 
+/* ************************************************************************* */
+Ordering Ordering::MetisConstrained(const MetisIndex& met,
+    const FastMap<Key, int>& groups) {
+  gttic(Ordering_METISConstrained);
+
+  // METIS needs at least one edge to partition
+  Ordering result;
+  if (met.adj().empty()) {
+    for (size_t j = 0; j < met.nValues(); ++j)
+      result.push_back(met.intToKey((int32_t) j));
+  } else {
+    result = Metis(met);
+  }
+  if (groups.empty())
+    return result;
+
+  // Stable sort by group, keeping the METIS order within each group
+  vector<pair<int, Key> > grouped;
+  grouped.reserve(result.size());
+  for (Key key : result) {
+    FastMap<Key, int>::const_iterator group = groups.find(key);
+    grouped.push_back(make_pair(group == groups.end() ? 0 : group->second, key));
+  }
+  std::stable_sort(grouped.begin(), grouped.end(),
+      [](const pair<int, Key>& a, const pair<int, Key>& b) {
+        return a.first < b.first;
+      });
+  for (size_t j = 0; j < grouped.size(); ++j)
+    result[j] = grouped[j].second;
+  return result;
+}
+
 /* ************************************************************************* */
 void Ordering::print(const std::string& str,
     const KeyFormatter& keyFormatter) const {
@@ -172,6 +172,26 @@ public:
   static GTSAM_EXPORT Ordering ColamdConstrained(
       const VariableIndex& variableIndex, const FastMap<Key, int>& groups);
 
+  /// Compute a fill-reducing ordering using COLAMD in parallel from a factor graph, building
+  /// the VariableIndex in parallel too, see below.
+  template<class FACTOR_GRAPH>
+  static Ordering ColamdParallel(const FACTOR_GRAPH& graph, size_t numThreads) {
+    if (graph.empty())
+      return Ordering();
+    else
+      return ColamdParallel(VariableIndex(graph, numThreads), numThreads);
+  }
+
+  /// Compute a fill-reducing ordering using COLAMD in parallel, with \c numThreads threads (0
+  /// means one per hardware thread).  The variables are cut into one part per thread along the
+  /// breadth-first levels of the graph, starting from the first variable of each connected
+  /// component, and the level at each cut separates consecutive parts (one-way dissection).
+  /// Each part is ordered by constrained COLAMD in its own thread, and the separators are
+  /// ordered last.  Unlike the other orderings, the result depends on the number of threads.
+  /// Graphs with less than a thousand variables per thread are ordered by COLAMD.
+  static GTSAM_EXPORT Ordering ColamdParallel(const VariableIndex& variableIndex,
+      size_t numThreads);
+
   /// Return a natural Ordering. Typically used by iterative solvers
   template<class FACTOR_GRAPH>
   static Ordering Natural(const FACTOR_GRAPH &fg) {
@@ -194,19 +214,39 @@ public:
     return Metis(MetisIndex(graph));
   }
 
+  /// Compute a nested dissection ordering using METIS, with the variables of each group in
+  /// \c groups appearing in group index order, as in ColamdConstrained.  Any variables not
+  /// present in \c groups are assigned to group 0.  Within a group, variables keep their METIS
+  /// order, so that constraining a few variables to the end preserves the balanced separators.
+  template<class FACTOR_GRAPH>
+  static Ordering MetisConstrained(const FACTOR_GRAPH& graph,
+      const FastMap<Key, int>& groups) {
+    if (graph.empty())
+      return Ordering();
+    else
+      return MetisConstrained(MetisIndex(graph), groups);
+  }
+
+  /// Compute a constrained nested dissection ordering from a MetisIndex, see above
+  static GTSAM_EXPORT Ordering MetisConstrained(const MetisIndex& met,
+      const FastMap<Key, int>& groups);
+
   /// @}
 
   /// @name Named Constructors @{
 
+  /// Compute an ordering of the given type.  With more than one thread, the VariableIndex
+  /// for COLAMD is built in parallel, which does not change the ordering.
   template<class FACTOR_GRAPH>
   static Ordering Create(OrderingType orderingType,
-      const FACTOR_GRAPH& graph) {
+      const FACTOR_GRAPH& graph, size_t numThreads = 1) {
     if (graph.empty())
       return Ordering();
 
     switch (orderingType) {
     case COLAMD:
-      return Colamd(graph);
+      return numThreads == 1 ? Colamd(graph)
+                             : Colamd(VariableIndex(graph, numThreads));
     case METIS:
       return Metis(graph);
     case NATURAL:
@@ -18,10 +18,43 @@
 #pragma once
 
 #include <gtsam/inference/VariableIndex.h>
+#include <gtsam/base/ThreadPool.h>
 #include <gtsam/base/timing.h>
 
+#include <algorithm>
+
 namespace gtsam {
 
+/* ************************************************************************* */
+template<class FG>
+VariableIndex::VariableIndex(const FG& factors, size_t numThreads) :
+    nFactors_(0), nEntries_(0) {
+  if (numThreads == 1) {
+    augment(factors);
+    return;
+  }
+  gttic(VariableIndex_parallel);
+
+  // Sorted entries of one range of factors per thread
+  ThreadPool& pool = ThreadPool::Shared(numThreads);
+  const size_t n = factors.size();
+  std::vector<Entries> ranges(std::max<size_t>(1, std::min(pool.numThreads(), n)));
+  const size_t numRanges = ranges.size();
+  pool.parallelFor(numRanges, [&](size_t begin, size_t end) {
+    for (size_t r = begin; r < end; ++r) {
+      Entries& entries = ranges[r];
+      for (size_t i = r * n / numRanges; i < (r + 1) * n / numRanges; ++i)
+        if (factors[i])
+          for (const Key key : *factors[i])
+            entries.push_back(std::make_pair(key, i));
+      std::sort(entries.begin(), entries.end());
+    }
+  });
+
+  mergeSortedEntries(ranges, numThreads);
+  nFactors_ = n;
+}
+
 /* ************************************************************************* */
 template<class FG>
 void VariableIndex::augment(const FG& factors,
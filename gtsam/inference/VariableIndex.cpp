@@ -18,6 +18,7 @@
 #include <iostream>
 
 #include <gtsam/inference/VariableIndex.h>
+#include <gtsam/base/ThreadPool.h>
 
 namespace gtsam {
 
@@ -42,6 +43,63 @@ void VariableIndex::print(const string& str, const KeyFormatter& keyFormatter) c
   cout.flush();
 }
 
+/* ************************************************************************* */
+void VariableIndex::mergeSortedEntries(const std::vector<Entries>& ranges,
+    size_t numThreads) {
+  // Split the keys into intervals at the quantiles of the largest range, and
+  // merge the entries of each interval in parallel
+  size_t largest = 0;
+  for (size_t r = 1; r < ranges.size(); ++r)
+    if (ranges[r].size() > ranges[largest].size()) largest = r;
+  const Entries& sample = ranges[largest];
+  const size_t numIntervals = sample.empty() ? 1 : ranges.size();
+  KeyVector splits;
+  for (size_t t = 1; t < numIntervals; ++t)
+    splits.push_back(sample[t * sample.size() / numIntervals].first);
+
+  const auto byKey = [](const Entries::value_type& entry, Key key) {
+    return entry.first < key;
+  };
+  vector<vector<pair<Key, Factors> > > merged(numIntervals);
+  ThreadPool::Shared(numThreads).parallelFor(numIntervals,
+      [&](size_t begin, size_t end) {
+    for (size_t t = begin; t < end; ++t) {
+      // Positions of the interval in each range
+      vector<Entries::const_iterator> first, last;
+      for (const Entries& entries : ranges) {
+        first.push_back(t == 0 ? entries.begin() :
+            lower_bound(entries.begin(), entries.end(), splits[t - 1], byKey));
+        last.push_back(t + 1 == numIntervals ? entries.end() :
+            lower_bound(entries.begin(), entries.end(), splits[t], byKey));
+      }
+      // Smallest key left, then its factors from all ranges in range order
+      for (;;) {
+        bool done = true;
+        Key key = 0;
+        for (size_t r = 0; r < ranges.size(); ++r)
+          if (first[r] != last[r] && (done || first[r]->first < key)) {
+            key = first[r]->first;
+            done = false;
+          }
+        if (done) break;
+        Factors factors;
+        for (size_t r = 0; r < ranges.size(); ++r)
+          for (; first[r] != last[r] && first[r]->first == key; ++first[r])
+            factors.push_back(first[r]->second);
+        merged[t].push_back(make_pair(key, std::move(factors)));
+      }
+    }
+  });
+
+  // The intervals are in key order, so each key goes at the end of the map
+  for (vector<pair<Key, Factors> >& interval : merged)
+    for (pair<Key, Factors>& key_factors : interval) {
+      nEntries_ += key_factors.second.size();
+      index_.emplace_hint(index_.end(), key_factors.first,
+                          std::move(key_factors.second));
+    }
+}
+
 /* ************************************************************************* */
 void VariableIndex::outputMetisFormat(ostream& os) const {
   os << size() << " " << nFactors() << "\n";
@@ -28,6 +28,8 @@
 
 #include <cassert>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace gtsam {
 
@@ -74,6 +76,15 @@ public:
   template<class FG>
   VariableIndex(const FG& factorGraph) : nFactors_(0), nEntries_(0) { augment(factorGraph); }
 
+  /**
+   * Create a VariableIndex using \c numThreads threads (0 means one per
+   * hardware thread).  Each thread indexes a contiguous range of factors, and
+   * the partial indices are merged in factor order, so the result is the same
+   * as with the single-threaded constructor.
+   */
+  template<class FG>
+  VariableIndex(const FG& factorGraph, size_t numThreads);
+
   /// @}
   /// @name Standard Interface
   /// @{
@@ -152,6 +163,13 @@ public:
   const_iterator find(Key key) const { return index_.find(key); }
 
 protected:
+  /// (key, factor index) pairs, used to build the index in parallel
+  typedef std::vector<std::pair<Key, size_t> > Entries;
+
+  /// Merge entries into the empty index, each sorted by key and factor index
+  /// and covering a range of factors after those of the previous one
+  void mergeSortedEntries(const std::vector<Entries>& ranges, size_t numThreads);
+
   Factor_iterator factorsBegin(Key variable) { return internalAt(variable).begin(); }
   Factor_iterator factorsEnd(Key variable) { return internalAt(variable).end(); }
 
@@ -17,6 +17,7 @@
 
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/symbolic/SymbolicFactorGraph.h>
+#include <gtsam/symbolic/SymbolicBayesNet.h>
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/inference/MetisIndex.h>
 #include <gtsam/base/TestableAssertions.h>
@@ -293,6 +294,95 @@ TEST(Ordering, MetisLoop) {
 #endif
 }
 #endif
+/* ************************************************************************* */
+TEST(Ordering, csr_format_isolated) {
+  // Key 2 is only in a unary factor, but still needs its entry in xadj
+  SymbolicFactorGraph symbolicGraph;
+  symbolicGraph.push_factor(0, 1);
+  symbolicGraph.push_factor(2);
+  symbolicGraph.push_factor(1, 3);
+
+  MetisIndex mi(symbolicGraph);
+
+  vector<int> xadjExpected, adjExpected;
+  xadjExpected += 0, 1, 3, 3, 4;
+  adjExpected += 1, 0, 3, 1;
+
+  EXPECT_LONGS_EQUAL(4, mi.nValues());
+  EXPECT(xadjExpected == mi.xadj());
+  EXPECT(adjExpected == mi.adj());
+}
+
+/* ************************************************************************* */
+#ifdef GTSAM_SUPPORT_NESTED_DISSECTION
+TEST(Ordering, MetisConstrained) {
+  // create linear graph with a loop closure
+  SymbolicFactorGraph symbolicGraph = example::symbolicChain();
+  symbolicGraph.push_factor(0, 5);
+
+  // Without groups, this is the METIS ordering
+  const Ordering metis = Ordering::Metis(symbolicGraph);
+  EXPECT(assert_equal(metis,
+      Ordering::MetisConstrained(symbolicGraph, FastMap<Key, int>())));
+
+  // Group 1 goes after group 0, and group 2 last, keeping the METIS order
+  // within each group
+  FastMap<Key, int> groups;
+  groups[1] = 1;
+  groups[3] = 1;
+  groups[4] = 2;
+  const Ordering actual = Ordering::MetisConstrained(symbolicGraph, groups);
+  Ordering expected;
+  for (int group = 0; group < 3; ++group)
+    for (Key key : metis) {
+      FastMap<Key, int>::const_iterator it = groups.find(key);
+      if ((it == groups.end() ? 0 : it->second) == group)
+        expected.push_back(key);
+    }
+  EXPECT(assert_equal(expected, actual));
+  EXPECT_LONGS_EQUAL(4, actual.back());
+
+  // A graph without binary factors is not partitioned
+  SymbolicFactorGraph unary;
+  unary.push_factor(0);
+  unary.push_factor(1);
+  groups.clear();
+  groups[0] = 1;
+  EXPECT(assert_equal(Ordering(list_of(1)(0)),
+      Ordering::MetisConstrained(unary, groups)));
+}
+#endif
+
+/* ************************************************************************* */
+TEST(Ordering, ColamdParallel) {
+  // Too small to split, same as COLAMD
+  SymbolicFactorGraph chain = example::symbolicChain();
+  EXPECT(assert_equal(Ordering::Colamd(chain), Ordering::ColamdParallel(chain, 2)));
+
+  // 60x60 grid, split in three parts
+  SymbolicFactorGraph grid;
+  for (Key i = 0; i < 60; ++i)
+    for (Key j = 0; j < 60; ++j) {
+      if (i + 1 < 60) grid.push_factor(60 * i + j, 60 * (i + 1) + j);
+      if (j + 1 < 60) grid.push_factor(60 * i + j, 60 * i + j + 1);
+    }
+  const Ordering actual = Ordering::ColamdParallel(grid, 3);
+  KeyVector sorted(actual.begin(), actual.end());
+  sort(sorted.begin(), sorted.end());
+  LONGS_EQUAL(3600, sorted.size());
+  for (size_t k = 0; k < sorted.size(); ++k)
+    LONGS_EQUAL(k, sorted[k]);
+
+  // Fill-in comparable to COLAMD
+  const Ordering colamd = Ordering::Colamd(grid);
+  const SymbolicBayesNet::shared_ptr colamdR = grid.eliminateSequential(colamd),
+                                     parallelR = grid.eliminateSequential(actual);
+  size_t colamdFill = 0, parallelFill = 0;
+  for (const auto& conditional : *colamdR) colamdFill += conditional->size();
+  for (const auto& conditional : *parallelR) parallelFill += conditional->size();
+  EXPECT(parallelFill < 2 * colamdFill);
+}
+
 /* ************************************************************************* */
 TEST(Ordering, Create) {
 
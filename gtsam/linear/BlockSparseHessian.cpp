@@ -0,0 +1,218 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    BlockSparseHessian.cpp
+ * @brief   The Hessian of a GaussianFactorGraph in block compressed sparse row
+ * format, for the matrix-vector products of iterative solvers
+ * @date    Oct 16, 2026
+ */
+
+#include <gtsam/linear/BlockSparseHessian.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/IterativeSolver.h>
+#include <gtsam/base/ThreadPool.h>
+#include <gtsam/base/timing.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+BlockSparseHessian::BlockSparseHessian(const GaussianFactorGraph& graph,
+                                       const KeyInfo& keyInfo,
+                                       size_t numThreads)
+    : numThreads_(numThreads) {
+  gttic(BlockSparseHessian);
+  const size_t n = keyInfo.size();
+  dims_.resize(n);
+  starts_.resize(n);
+  for (const KeyInfo::value_type& item : keyInfo) {
+    dims_[item.second.index] = item.second.dim;
+    starts_[item.second.index] = item.second.start;
+  }
+
+  // Block indices of the variables of each factor
+  vector<vector<size_t> > factorIndices(graph.size());
+  for (size_t f = 0; f < graph.size(); ++f) {
+    if (!graph[f]) continue;
+    for (Key key : *graph[f]) {
+      KeyInfo::const_iterator item = keyInfo.find(key);
+      if (item == keyInfo.end())
+        throw invalid_argument(
+            "BlockSparseHessian: the graph has a variable not in KeyInfo");
+      factorIndices[f].push_back(item->second.index);
+    }
+  }
+
+  // Sparsity pattern, with sorted columns in each block row
+  vector<vector<size_t> > columns(n);
+  for (size_t i = 0; i < n; ++i) columns[i].push_back(i);
+  for (const vector<size_t>& indices : factorIndices)
+    for (size_t i : indices)
+      columns[i].insert(columns[i].end(), indices.begin(), indices.end());
+  for (size_t i = 0; i < n; ++i) {
+    sort(columns[i].begin(), columns[i].end());
+    columns[i].erase(unique(columns[i].begin(), columns[i].end()),
+                     columns[i].end());
+  }
+  setPattern(columns);
+
+  // Add the augmented information matrix of each factor
+  for (size_t f = 0; f < graph.size(); ++f) {
+    if (!graph[f]) continue;
+    const Matrix info = graph[f]->augmentedInformation();
+    const vector<size_t>& indices = factorIndices[f];
+    const DenseIndex last = info.cols() - 1;
+    DenseIndex row = 0;
+    for (size_t a = 0; a < indices.size(); ++a) {
+      const size_t i = indices[a];
+      DenseIndex col = 0;
+      for (size_t b = 0; b < indices.size(); ++b) {
+        const size_t j = indices[b];
+        Eigen::Map<Matrix>(&values_[blockValues_[find(i, j)]], dims_[i],
+                           dims_[j]) += info.block(row, col, dims_[i], dims_[j]);
+        col += dims_[j];
+      }
+      linearTerm_.segment(starts_[i], dims_[i]) +=
+          info.block(row, last, dims_[i], 1);
+      row += dims_[i];
+    }
+  }
+}
+
+/* ************************************************************************* */
+BlockSparseHessian::BlockSparseHessian(
+    const vector<size_t>& dims,
+    const map<pair<size_t, size_t>, Matrix>& blocks, size_t numThreads)
+    : numThreads_(numThreads), dims_(dims) {
+  starts_.resize(dims_.size());
+  size_t start = 0;
+  for (size_t i = 0; i < dims_.size(); ++i) {
+    starts_[i] = start;
+    start += dims_[i];
+  }
+
+  // The blocks are sorted by row, then column
+  vector<vector<size_t> > columns(dims_.size());
+  typedef map<pair<size_t, size_t>, Matrix>::value_type Block;
+  for (const Block& block : blocks)
+    columns[block.first.first].push_back(block.first.second);
+  setPattern(columns);
+  for (const Block& block : blocks) {
+    const size_t i = block.first.first, j = block.first.second;
+    Eigen::Map<Matrix>(&values_[blockValues_[find(i, j)]], dims_[i], dims_[j]) =
+        block.second;
+  }
+}
+
+/* ************************************************************************* */
+void BlockSparseHessian::setPattern(const vector<vector<size_t> >& columns) {
+  const size_t n = dims_.size();
+  rowStarts_.resize(n + 1);
+  rowStarts_[0] = 0;
+  blockColumns_.clear();
+  blockValues_.clear();
+  size_t numValues = 0, numCols = 0;
+  for (size_t i = 0; i < n; ++i) {
+    rowStarts_[i + 1] = rowStarts_[i] + columns[i].size();
+    for (size_t j : columns[i]) {
+      blockColumns_.push_back(j);
+      blockValues_.push_back(numValues);
+      numValues += dims_[i] * dims_[j];
+    }
+    numCols += dims_[i];
+  }
+  values_.assign(numValues, 0.0);
+  linearTerm_ = Vector::Zero(numCols);
+}
+
+/* ************************************************************************* */
+size_t BlockSparseHessian::find(size_t i, size_t j) const {
+  const vector<size_t>::const_iterator begin =
+      blockColumns_.begin() + rowStarts_[i];
+  const vector<size_t>::const_iterator end =
+      blockColumns_.begin() + rowStarts_[i + 1];
+  return lower_bound(begin, end, j) - blockColumns_.begin();
+}
+
+/* ************************************************************************* */
+namespace {
+// y += H * x for a D*D block
+template <int D>
+inline void multiplyBlock(const double* H, const double* x, double* y) {
+  typedef Eigen::Matrix<double, D, 1> VectorD;
+  Eigen::Map<VectorD>(y).noalias() +=
+      Eigen::Map<const Eigen::Matrix<double, D, D> >(H) *
+      Eigen::Map<const VectorD>(x);
+}
+}  // namespace
+
+/* ************************************************************************* */
+void BlockSparseHessian::multiplyRow(size_t i, const double* x,
+                                     double* y) const {
+  const size_t di = dims_[i];
+  double* yi = y + starts_[i];
+  Eigen::Map<Vector>(yi, di).setZero();
+  for (size_t k = rowStarts_[i]; k < rowStarts_[i + 1]; ++k) {
+    const size_t j = blockColumns_[k], dj = dims_[j];
+    const double* H = &values_[blockValues_[k]];
+    const double* xj = x + starts_[j];
+    if (di == dj) {
+      switch (di) {
+        case 2: multiplyBlock<2>(H, xj, yi); continue;
+        case 3: multiplyBlock<3>(H, xj, yi); continue;
+        case 6: multiplyBlock<6>(H, xj, yi); continue;
+        case 9: multiplyBlock<9>(H, xj, yi); continue;
+        default: break;
+      }
+    }
+    Eigen::Map<Vector>(yi, di).noalias() +=
+        Eigen::Map<const Matrix>(H, di, dj) *
+        Eigen::Map<const Vector>(xj, dj);
+  }
+}
+
+/* ************************************************************************* */
+void BlockSparseHessian::multiply(const Vector& x, Vector& y) const {
+  gttic(BlockSparseHessian_multiply);
+  y.resize(dim());
+  const double* px = x.data();
+  double* py = y.data();
+  const size_t n = dims_.size();
+  ThreadPool& pool = ThreadPool::Shared(numThreads_);
+  if (pool.numThreads() == 1) {
+    for (size_t i = 0; i < n; ++i) multiplyRow(i, px, py);
+  } else {
+    pool.parallelFor(
+        n, [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i) multiplyRow(i, px, py);
+        });
+  }
+}
+
+/* ************************************************************************* */
+Matrix BlockSparseHessian::matrix() const {
+  Matrix H = Matrix::Zero(dim(), dim());
+  for (size_t i = 0; i < dims_.size(); ++i)
+    for (size_t k = rowStarts_[i]; k < rowStarts_[i + 1]; ++k) {
+      const size_t j = blockColumns_[k];
+      H.block(starts_[i], starts_[j], dims_[i], dims_[j]) =
+          Eigen::Map<const Matrix>(&values_[blockValues_[k]], dims_[i],
+                                   dims_[j]);
+    }
+  return H;
+}
+
+}  // namespace gtsam
@@ -0,0 +1,124 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    BlockSparseHessian.h
+ * @brief   The Hessian of a GaussianFactorGraph in block compressed sparse row
+ * format, for the matrix-vector products of iterative solvers
+ * @date    Oct 16, 2026
+ */
+
+#pragma once
+
+#include <gtsam/base/Matrix.h>
+#include <gtsam/dllexport.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace gtsam {
+
+class GaussianFactorGraph;
+class KeyInfo;
+
+/**
+ * The Hessian A'A of a GaussianFactorGraph, and its linear term A'b, on
+ * contiguous vectors laid out as in a KeyInfo.  The graph is flattened once,
+ * so that a product with the Hessian needs no key lookups: the blocks of each
+ * block row are stored next to each other, with the column offsets of the
+ * blocks precomputed.  Both triangles are stored, so that block rows can be
+ * multiplied independently, on several threads.  Blocks between variables of
+ * the same dimension 2, 3, 6 or 9 use fixed-size kernels.
+ */
+class GTSAM_EXPORT BlockSparseHessian {
+public:
+  /**
+   * Flatten \c graph, whose variables are all in \c keyInfo.
+   * @param numThreads number of threads used by multiply(), 0 for one per
+   * hardware thread
+   */
+  BlockSparseHessian(const GaussianFactorGraph& graph, const KeyInfo& keyInfo,
+                     size_t numThreads = 1);
+
+  /**
+   * A symmetric matrix with blocks of dimensions \c dims, given by its
+   * non-zero \c blocks indexed by block row and column, in both triangles.
+   * The linear term is zero.
+   */
+  BlockSparseHessian(const std::vector<size_t>& dims,
+                     const std::map<std::pair<size_t, size_t>, Matrix>& blocks,
+                     size_t numThreads = 1);
+
+  /// y = A'A x
+  void multiply(const Vector& x, Vector& y) const;
+
+  /// The linear term A'b
+  const Vector& linearTerm() const { return linearTerm_; }
+
+  /// Number of scalar rows and columns
+  size_t dim() const { return linearTerm_.size(); }
+
+  /// Number of non-zero blocks, counting both triangles
+  size_t nnzBlocks() const { return blockColumns_.size(); }
+
+  /// Dense matrix, for testing
+  Matrix matrix() const;
+
+  /// @name Block access, e.g. for preconditioners
+  /// @{
+
+  /// Number of block rows and columns
+  size_t numBlocks() const { return dims_.size(); }
+
+  /// Dimension of block row i
+  size_t blockDim(size_t i) const { return dims_[i]; }
+
+  /// First scalar row of block row i
+  size_t blockStart(size_t i) const { return starts_[i]; }
+
+  /// The blocks k of block row i are rowBegin(i) <= k < rowEnd(i), sorted by
+  /// column
+  size_t rowBegin(size_t i) const { return rowStarts_[i]; }
+  size_t rowEnd(size_t i) const { return rowStarts_[i + 1]; }
+
+  /// Block column of block k
+  size_t column(size_t k) const { return blockColumns_[k]; }
+
+  /// Block k, which is in block row i
+  Eigen::Map<const Matrix> block(size_t i, size_t k) const {
+    return Eigen::Map<const Matrix>(&values_[blockValues_[k]], dims_[i],
+                                    dims_[blockColumns_[k]]);
+  }
+
+  /// @}
+
+private:
+  /// Set the pattern from the sorted block columns of each block row, and
+  /// zero the values
+  void setPattern(const std::vector<std::vector<size_t> >& columns);
+
+  /// Index of block (i, j) in blockColumns_, which must be in the pattern
+  size_t find(size_t i, size_t j) const;
+
+  /// y_i = row i of A'A times x
+  void multiplyRow(size_t i, const double* x, double* y) const;
+
+  size_t numThreads_;
+  std::vector<size_t> dims_, starts_;   ///< Of each variable, from KeyInfo
+  std::vector<size_t> rowStarts_;       ///< First block of each block row
+  std::vector<size_t> blockColumns_;    ///< Block column of each block
+  std::vector<size_t> blockValues_;     ///< Offset of each block in values_
+  std::vector<double> values_;          ///< Column-major blocks
+  Vector linearTerm_;
+};
+
+}  // namespace gtsam
@@ -0,0 +1,212 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    CachedGaussianJunctionTree.cpp
+ * @brief   Multifrontal elimination that re-uses the symbolic structure of
+ * the previous factor graph when the sparsity pattern did not change
+ * @date    Oct 16, 2026
+ */
+
+#include <gtsam/linear/CachedGaussianJunctionTree.h>
+#include <gtsam/linear/GaussianEliminationTree.h>
+#include <gtsam/linear/GaussianConditional.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/linearExceptions.h>
+#include <gtsam/inference/VariableIndex.h>
+#include <gtsam/inference/inferenceExceptions.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/FastSet.h>
+#include <gtsam/base/timing.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+typedef pair<GaussianConditional::shared_ptr, GaussianFactor::shared_ptr>
+    EliminationResult;
+
+/* ************************************************************************* */
+bool CachedGaussianJunctionTree::matches(
+    const GaussianFactorGraph& graph,
+    boost::optional<const Ordering&> ordering) const {
+  if (ordering && static_cast<const KeyVector&>(*ordering) != ordering_)
+    return false;
+  if (graph.size() != factorKeys_.size()) return false;
+  for (size_t i = 0; i < graph.size(); ++i) {
+    if (graph[i] ? graph[i]->keys() != factorKeys_[i]
+                 : !factorKeys_[i].empty())
+      return false;
+  }
+  return true;
+}
+
+/* ************************************************************************* */
+void CachedGaussianJunctionTree::build(
+    const GaussianFactorGraph& graph,
+    boost::optional<const Ordering&> ordering) {
+  gttic(CachedGaussianJunctionTree_build);
+  ++numBuilds_;
+  VariableIndex variableIndex(graph);
+  ordering_ = ordering ? *ordering : Ordering::Colamd(variableIndex);
+  GaussianEliminationTree etree(graph, variableIndex, ordering_);
+  junctionTree_ = boost::make_shared<GaussianJunctionTree>(etree);
+
+  factorKeys_.resize(graph.size());
+  for (size_t i = 0; i < graph.size(); ++i)
+    factorKeys_[i] = graph[i] ? graph[i]->keys() : KeyVector();
+
+  // Indices of each factor in the graph.  A factor that was added twice has
+  // the same keys, so it is in the same cluster twice.
+  FastMap<const GaussianFactor*, FastVector<size_t> > indices;
+  for (size_t i = graph.size(); i-- > 0;)
+    if (graph[i]) indices[graph[i].get()].push_back(i);
+
+  // Record where the factors of each cluster come from
+  clusters_.clear();
+  clusterFactors_.clear();
+  clusterOf_.clear();
+  FastVector<GaussianJunctionTree::sharedNode> stack(
+      junctionTree_->roots().begin(), junctionTree_->roots().end());
+  while (!stack.empty()) {
+    GaussianJunctionTree::sharedNode cluster = stack.back();
+    stack.pop_back();
+    clusterOf_[&cluster->orderedFrontalKeys] = clusters_.size();
+    clusters_.push_back(cluster);
+    clusterFactors_.push_back(vector<size_t>());
+    for (const GaussianFactor::shared_ptr& factor : cluster->factors) {
+      FastVector<size_t>& slots = indices.at(factor.get());
+      clusterFactors_.back().push_back(slots.back());
+      slots.pop_back();
+    }
+    stack.insert(stack.end(), cluster->children.begin(),
+                 cluster->children.end());
+  }
+  scatters_.assign(clusters_.size(), boost::none);
+
+  // Size the workspace for the largest front.  The clusters are in pre-order,
+  // so the children of a cluster come after it.
+  FastMap<Key, size_t> dims;
+  for (const GaussianFactor::shared_ptr& factor : graph)
+    if (factor)
+      for (GaussianFactor::const_iterator key = factor->begin();
+           key != factor->end(); ++key)
+        dims[*key] = factor->getDim(key);
+  map<const GaussianJunctionTree::Node*, FastSet<Key> > separators;
+  size_t largestFront = 0;
+  for (size_t c = clusters_.size(); c-- > 0;) {
+    const GaussianJunctionTree::Node& cluster = *clusters_[c];
+    FastSet<Key>& separator = separators[&cluster];
+    for (const GaussianFactor::shared_ptr& factor : cluster.factors)
+      if (factor) separator.insert(factor->begin(), factor->end());
+    for (const GaussianJunctionTree::sharedNode& child : cluster.children) {
+      const FastSet<Key>& childSeparator = separators[child.get()];
+      separator.insert(childSeparator.begin(), childSeparator.end());
+      separators.erase(child.get());
+    }
+    size_t front = 1;
+    for (Key key : separator) front += dims[key];
+    largestFront = std::max(largestFront, front);
+    for (Key key : cluster.orderedFrontalKeys) separator.erase(key);
+  }
+  workspace_.reserve(largestFront);
+}
+
+/* ************************************************************************* */
+void CachedGaussianJunctionTree::bind(const GaussianFactorGraph& graph) {
+  gttic(CachedGaussianJunctionTree_bind);
+  for (size_t c = 0; c < clusters_.size(); ++c) {
+    GaussianFactorGraph& factors = clusters_[c]->factors;
+    for (size_t k = 0; k < factors.size(); ++k)
+      factors[k] = graph[clusterFactors_[c][k]];
+  }
+}
+
+/* ************************************************************************* */
+void CachedGaussianJunctionTree::release() {
+  for (const GaussianJunctionTree::sharedNode& cluster : clusters_)
+    for (GaussianFactor::shared_ptr& factor : cluster->factors) factor.reset();
+}
+
+/* ************************************************************************* */
+void CachedGaussianJunctionTree::invalidate() {
+  ordering_.clear();
+  factorKeys_.clear();
+  junctionTree_.reset();
+  clusters_.clear();
+  clusterFactors_.clear();
+  clusterOf_.clear();
+  scatters_.clear();
+  workspace_.clear();
+}
+
+/* ************************************************************************* */
+GaussianBayesTree::shared_ptr CachedGaussianJunctionTree::eliminate(
+    const GaussianFactorGraph& graph, const Eliminate& function,
+    boost::optional<const Ordering&> ordering) {
+  gttic(CachedGaussianJunctionTree_eliminate);
+  if (valid() && matches(graph, ordering))
+    bind(graph);
+  else
+    build(graph, ordering);
+
+  // The Scatter of a clique only depends on the keys of its factors, so it can
+  // be kept when eliminating with Cholesky
+  typedef EliminationResult (*PreferCholesky)(const GaussianFactorGraph&,
+                                              const Ordering&);
+  typedef pair<GaussianConditional::shared_ptr, HessianFactor::shared_ptr> (
+      *Cholesky)(const GaussianFactorGraph&, const Ordering&);
+  const bool cholesky =
+      (function.target<PreferCholesky>() &&
+       *function.target<PreferCholesky>() == &EliminatePreferCholesky) ||
+      (function.target<Cholesky>() &&
+       *function.target<Cholesky>() == &EliminateCholesky);
+
+  // Each cluster only writes its own Scatter, so this is safe to call from
+  // parallel elimination
+  const Eliminate cached = [&](const GaussianFactorGraph& factors,
+                               const Ordering& keys) -> EliminationResult {
+    map<const Ordering*, size_t>::const_iterator cluster = clusterOf_.find(&keys);
+    if (!cholesky || cluster == clusterOf_.end() || hasConstraints(factors))
+      return function(factors, keys);
+    boost::optional<Scatter>& scatter = scatters_[cluster->second];
+    try {
+      if (!scatter) scatter = Scatter(factors, keys);
+    } catch (std::invalid_argument&) {
+      throw InvalidDenseElimination(
+          "EliminateCholesky was called with a request to eliminate variables "
+          "that are not\ninvolved in the provided factors.");
+    }
+    return EliminateCholeskyInWorkspace(factors, keys, *scatter, workspace_);
+  };
+
+  GaussianBayesTree::shared_ptr bayesTree;
+  GaussianFactorGraph::shared_ptr remaining;
+  try {
+    boost::tie(bayesTree, remaining) = junctionTree_->eliminate(cached);
+  } catch (...) {
+    release();
+    throw;
+  }
+
+  // Do not keep the factors of graph alive until the next call, so that their
+  // owner can overwrite them in place, see NonlinearFactor::linearizeInto
+  release();
+
+  // If any factors are remaining, the ordering was incomplete
+  if (!remaining->empty()) throw InconsistentEliminationRequested();
+  return bayesTree;
+}
+
+}  // namespace gtsam
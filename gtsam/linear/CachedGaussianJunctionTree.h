@@ -0,0 +1,121 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    CachedGaussianJunctionTree.h
+ * @brief   Multifrontal elimination that re-uses the symbolic structure of
+ * the previous factor graph when the sparsity pattern did not change
+ * @date    Oct 16, 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/GaussianJunctionTree.h>
+#include <gtsam/linear/EliminationWorkspace.h>
+#include <gtsam/linear/Scatter.h>
+#include <gtsam/linear/VectorValues.h>
+
+#include <boost/optional.hpp>
+
+#include <map>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Eliminates a sequence of GaussianFactorGraphs with the same sparsity
+ * pattern, as linearized by the iterations of a nonlinear optimizer, without
+ * repeating the symbolic work for each of them.
+ *
+ * The first call computes the ordering (COLAMD unless one is given), the
+ * variable index, the elimination tree and the junction tree.  Later calls
+ * check that the graph has the same factors on the same keys, in the same
+ * order, and then only re-bind the factors of each cluster before the numeric
+ * elimination.  The factors are released again after the elimination, so the
+ * cache does not keep the factors of the graph alive.  With EliminateCholesky
+ * or EliminatePreferCholesky the Scatter of each clique is kept as well, and
+ * the joint Hessian of each clique is formed in an EliminationWorkspace sized
+ * for the largest clique.  A graph with a different structure, or a different
+ * ordering, rebuilds the cache automatically; invalidate() drops it
+ * explicitly.
+ */
+class GTSAM_EXPORT CachedGaussianJunctionTree {
+public:
+  typedef GaussianFactorGraph::Eliminate Eliminate;
+
+  /// Create an empty cache, the structure is computed by the first elimination
+  CachedGaussianJunctionTree() : numBuilds_(0) {}
+
+  /**
+   * Eliminate \c graph with \c function, as
+   * GaussianFactorGraph::eliminateMultifrontal does.  The cached structure is
+   * re-used if \c graph has the same structure as the last graph and either
+   * no ordering, or the same ordering, is given.
+   */
+  GaussianBayesTree::shared_ptr eliminate(
+      const GaussianFactorGraph& graph, const Eliminate& function,
+      boost::optional<const Ordering&> ordering = boost::none);
+
+  /// Eliminate and back-substitute, as GaussianFactorGraph::optimize does
+  VectorValues optimize(const GaussianFactorGraph& graph,
+                        const Eliminate& function,
+                        boost::optional<const Ordering&> ordering = boost::none) {
+    return eliminate(graph, function, ordering)->optimize();
+  }
+
+  /// Drop the cached structure, the next elimination recomputes it
+  void invalidate();
+
+  /// Whether a structure is cached
+  bool valid() const { return static_cast<bool>(junctionTree_); }
+
+  /// Number of times the structure was computed
+  size_t numBuilds() const { return numBuilds_; }
+
+  /// The cached ordering, only meaningful if valid()
+  const Ordering& ordering() const { return ordering_; }
+
+  /// Storage of the Cholesky fronts, e.g. for its high-water mark
+  const EliminationWorkspace& workspace() const { return workspace_; }
+
+private:
+  /// Whether graph and ordering match the cached structure
+  bool matches(const GaussianFactorGraph& graph,
+               boost::optional<const Ordering&> ordering) const;
+
+  /// Compute the structure of graph
+  void build(const GaussianFactorGraph& graph,
+             boost::optional<const Ordering&> ordering);
+
+  /// Replace the factors of all clusters by those of graph
+  void bind(const GaussianFactorGraph& graph);
+
+  /// Reset the factors of all clusters, keeping their slots for bind()
+  void release();
+
+  size_t numBuilds_;
+  Ordering ordering_;
+  std::vector<KeyVector> factorKeys_;  ///< Keys of each factor, empty if null
+  boost::shared_ptr<GaussianJunctionTree> junctionTree_;
+
+  /// The clusters, and the index in the graph of each of their factors
+  std::vector<GaussianJunctionTree::sharedNode> clusters_;
+  std::vector<std::vector<size_t> > clusterFactors_;
+
+  /// Scatter of each cluster, found through the address of its frontal keys,
+  /// computed by its first elimination
+  std::map<const Ordering*, size_t> clusterOf_;
+  std::vector<boost::optional<Scatter> > scatters_;
+
+  EliminationWorkspace workspace_;
+};
+
+}  // namespace gtsam
@@ -89,8 +89,9 @@ public:
 /*
  * A template for the linear preconditioned conjugate gradient method.
  * System class should support residual(v, g), multiply(v,Av), scal(alpha,v), dot(v,v), axpy(alpha,x,y)
- * leftPrecondition(v, L^{-1}v, rightPrecondition(v, L^{-T}v) where preconditioner M = L*L^T
- * Note that the residual is in the preconditioned domain. Refer to Section 9.2 of Saad's book.
+ * and precondition(v, M^{-1}v), where M is the preconditioner.
+ * The squared norm of the residual used for the stopping criteria is the one in the
+ * preconditioned domain, r'*M^{-1}*r. Refer to Section 9.2 of Saad's book.
  *
  ** REFERENCES:
  * [1] Y. Saad, "Preconditioned Iterations," in Iterative Methods for Sparse Linear Systems,
@@ -103,11 +104,10 @@ V preconditionedConjugateGradient(const S &system, const V &initial,
   V estimate, residual, direction, q1, q2;
   estimate = residual = direction = q1 = q2 = initial;
 
-  system.residual(estimate, q1);                /* q1 = b-Ax */
-  system.leftPrecondition(q1, residual);        /* r = L^{-1} (b-Ax) */
-  system.rightPrecondition(residual, direction);/* p = L^{-T} r */
+  system.residual(estimate, residual);          /* r = b-Ax */
+  system.precondition(residual, direction);     /* p = M^{-1} r */
 
-  double currentGamma = system.dot(residual, residual), prevGamma, alpha, beta;
+  double currentGamma = system.dot(residual, direction), prevGamma, alpha, beta;
 
   const size_t iMaxIterations = parameters.maxIterations(),
                iMinIterations = parameters.minIterations(),
@@ -126,22 +126,20 @@ V preconditionedConjugateGradient(const S &system, const V &initial,
   for ( k = 1 ; k <= iMaxIterations && (currentGamma > threshold || k <= iMinIterations) ; k++ ) {
 
     if ( k % iReset == 0 ) {
-      system.residual(estimate, q1);                      /* q1 = b-Ax */
-      system.leftPrecondition(q1, residual);              /* r = L^{-1} (b-Ax) */
-      system.rightPrecondition(residual, direction);      /* p = L^{-T} r */
-      currentGamma = system.dot(residual, residual);
+      system.residual(estimate, residual);                /* r = b-Ax */
+      system.precondition(residual, direction);           /* p = M^{-1} r */
+      currentGamma = system.dot(residual, direction);
     }
     system.multiply(direction, q1);                       /* q1 = A p */
     alpha = currentGamma / system.dot(direction, q1);     /* alpha = gamma / (p' A p) */
     system.axpy(alpha, direction, estimate);              /* estimate += alpha * p */
-    system.leftPrecondition(q1, q2);                      /* q2 = L^{-1} * q1 */
-    system.axpy(-alpha, q2, residual);                    /* r -= alpha * q2 */
+    system.axpy(-alpha, q1, residual);                    /* r -= alpha * A p */
+    system.precondition(residual, q2);                    /* q2 = M^{-1} r */
     prevGamma = currentGamma;
-    currentGamma = system.dot(residual, residual);        /* gamma = |r|^2 */
+    currentGamma = system.dot(residual, q2);              /* gamma = r' M^{-1} r */
     beta = currentGamma / prevGamma;
-    system.rightPrecondition(residual, q1);               /* q1 = L^{-T} r */
     system.scal(beta, direction);
-    system.axpy(1.0, q1, direction);                      /* p = q1 + beta * p */
+    system.axpy(1.0, q2, direction);                      /* p = q2 + beta * p */
 
     if (parameters.verbosity() >= ConjugateGradientParameters::ERROR )
        std::cout << "[PCG] k = " << k
@@ -0,0 +1,86 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    EliminationWorkspace.cpp
+ * @brief   Per-thread storage for the frontal matrices of multifrontal
+ * elimination
+ * @date    Oct 16, 2026
+ */
+
+#include <gtsam/linear/EliminationWorkspace.h>
+
+#include <algorithm>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+void EliminationWorkspace::reserve(size_t dim) {
+  lock_guard<mutex> lock(mutex_);
+  reserved_ = std::max(reserved_, dim);
+}
+
+/* ************************************************************************* */
+SymmetricBlockMatrix& EliminationWorkspace::acquire(
+    const FastVector<DenseIndex>& dims) {
+  DenseIndex size = 1;
+  for (DenseIndex dim : dims) size += dim;
+
+  lock_guard<mutex> lock(mutex_);
+  SymmetricBlockMatrix& matrix = matrices_[this_thread::get_id()];
+  if (matrix.capacity() < size) {
+    // Grow to the reserved size at once, if that is large enough
+    if (size_t(size) <= reserved_)
+      matrix.resetBlocks(FastVector<DenseIndex>(1, reserved_));
+    ++numAllocations_;
+  }
+  matrix.resetBlocks(dims, true);
+  highWaterMark_ = std::max(highWaterMark_, size_t(size * size) * sizeof(double));
+  return matrix;
+}
+
+/* ************************************************************************* */
+void EliminationWorkspace::clear() {
+  lock_guard<mutex> lock(mutex_);
+  matrices_.clear();
+}
+
+/* ************************************************************************* */
+size_t EliminationWorkspace::numThreads() const {
+  lock_guard<mutex> lock(mutex_);
+  return matrices_.size();
+}
+
+/* ************************************************************************* */
+size_t EliminationWorkspace::numAllocations() const {
+  lock_guard<mutex> lock(mutex_);
+  return numAllocations_;
+}
+
+/* ************************************************************************* */
+size_t EliminationWorkspace::highWaterMark() const {
+  lock_guard<mutex> lock(mutex_);
+  return highWaterMark_;
+}
+
+/* ************************************************************************* */
+size_t EliminationWorkspace::bytes() const {
+  lock_guard<mutex> lock(mutex_);
+  size_t result = 0;
+  for (const auto& thread_matrix : matrices_)
+    result += thread_matrix.second.capacity() * thread_matrix.second.capacity() *
+              sizeof(double);
+  return result;
+}
+
+}  // namespace gtsam
@@ -0,0 +1,79 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    EliminationWorkspace.h
+ * @brief   Per-thread storage for the frontal matrices of multifrontal
+ * elimination
+ * @date    Oct 16, 2026
+ */
+
+#pragma once
+
+#include <gtsam/base/SymmetricBlockMatrix.h>
+#include <gtsam/base/FastVector.h>
+
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace gtsam {
+
+/**
+ * One dense matrix per thread, in which multifrontal Cholesky elimination
+ * forms the joint Hessian of each clique, see EliminateCholeskyInWorkspace.
+ * A matrix is only re-allocated when a clique is larger than any before on
+ * the same thread, so after reserve() with the size of the largest clique an
+ * elimination allocates one frontal matrix per thread rather than one per
+ * clique.  The conditionals and the factors passed to the parent cliques are
+ * still copied out into storage of their own.
+ */
+class GTSAM_EXPORT EliminationWorkspace {
+public:
+  /// Create an empty workspace
+  EliminationWorkspace() : reserved_(0), numAllocations_(0), highWaterMark_(0) {}
+
+  /// Allocate frontal matrices for cliques of up to \c dim dimensions,
+  /// including the column of the right-hand side, when a thread first uses
+  /// the workspace
+  void reserve(size_t dim);
+
+  /**
+   * The matrix of the calling thread, with blocks of dimensions \c dims and a
+   * final block of dimension 1 for the right-hand side.  Its entries are not
+   * initialized.  The reference stays valid until clear().
+   */
+  SymmetricBlockMatrix& acquire(const FastVector<DenseIndex>& dims);
+
+  /// Free all matrices, this must not be called while any is in use
+  void clear();
+
+  /// Number of threads that used the workspace
+  size_t numThreads() const;
+
+  /// Number of frontal matrices allocated
+  size_t numAllocations() const;
+
+  /// Size in bytes of the largest frontal matrix used so far
+  size_t highWaterMark() const;
+
+  /// Bytes held by the matrices of all threads
+  size_t bytes() const;
+
+private:
+  mutable std::mutex mutex_;
+  std::map<std::thread::id, SymmetricBlockMatrix> matrices_;
+  size_t reserved_;
+  size_t numAllocations_;
+  size_t highWaterMark_;
+};
+
+}  // namespace gtsam
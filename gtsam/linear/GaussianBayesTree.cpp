@@ -50,9 +50,9 @@ namespace gtsam {
   }
 
   /* ************************************************************************* */
-  VectorValues GaussianBayesTree::optimize() const
+  VectorValues GaussianBayesTree::optimize(size_t numThreads) const
   {
-    return internal::linearAlgorithms::optimizeBayesTree(*this);
+    return internal::linearAlgorithms::optimizeBayesTree(*this, numThreads);
   }
 
   /* ************************************************************************* */
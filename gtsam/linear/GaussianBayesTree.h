@@ -62,8 +62,10 @@ namespace gtsam {
     /** Check equality */
     bool equals(const This& other, double tol = 1e-9) const;
 
-    /** Recursively optimize the BayesTree to produce a vector solution. */
-    VectorValues optimize() const;
+    /** Recursively optimize the BayesTree to produce a vector solution.  With TBB, subtrees are
+     *  back-substituted in parallel; without TBB, \c numThreads threads of the built-in
+     *  ThreadPool are used (0 means one per hardware thread). */
+    VectorValues optimize(size_t numThreads = 1) const;
 
     /**
      * Optimize along the gradient direction, with a closed-form computation to perform the line
@@ -20,6 +20,7 @@
 #include <gtsam/linear/GaussianConditional.h>
 #include <gtsam/linear/GaussianFactor.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/EliminationWorkspace.h>
 #include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/linearExceptions.h>
 #include <gtsam/base/cholesky.h>
@@ -548,6 +549,49 @@ EliminateCholesky(const GaussianFactorGraph& factors, const Ordering& keys) {
   return make_pair(conditional, jointFactor);
 }
 
+/* ************************************************************************* */
+std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
+EliminateCholeskyInWorkspace(const GaussianFactorGraph& factors, const Ordering& keys,
+                             const Scatter& scatter, EliminationWorkspace& workspace) {
+  gttic(EliminateCholeskyInWorkspace);
+
+  // Form A' * A in the workspace
+  KeyVector jointKeys;
+  FastVector<DenseIndex> dims;
+  jointKeys.reserve(scatter.size());
+  dims.reserve(scatter.size());
+  for (const SlotEntry& slot : scatter) {
+    jointKeys.push_back(slot.key);
+    dims.push_back(slot.dimension);
+  }
+  SymmetricBlockMatrix& info = workspace.acquire(dims);
+  info.setZero();
+  for (const auto& factor : factors)
+    if (factor)
+      factor->updateHessian(jointKeys, &info);
+
+  // Do dense elimination
+  const size_t nFrontals = keys.size();
+  try {
+    info.choleskyPartial(nFrontals);
+  } catch (const CholeskyFailed&) {
+    throw IndeterminantLinearSystemException(keys.front());
+  }
+
+  // Copy the conditional, split also moves the active view to the separator
+  auto conditional =
+      boost::make_shared<GaussianConditional>(jointKeys, nFrontals, info.split(nFrontals));
+
+  // Copy the remaining factor
+  Scatter separator;
+  for (size_t j = nFrontals; j < scatter.size(); ++j)
+    separator.add(scatter[j].key, scatter[j].dimension);
+  boost::shared_ptr<HessianFactor> remaining(new HessianFactor(separator));
+  remaining->info_.setFullMatrix(info.selfadjointView().nestedExpression());
+
+  return make_pair(conditional, remaining);
+}
+
 /* ************************************************************************* */
 std::pair<boost::shared_ptr<GaussianConditional>,
     boost::shared_ptr<GaussianFactor> > EliminatePreferCholesky(
@@ -34,6 +34,7 @@ namespace gtsam {
   class GaussianConditional;
   class GaussianBayesNet;
   class GaussianFactorGraph;
+  class EliminationWorkspace;
 
   /**
    * @brief A Gaussian factor using the canonical parameters (information form)
@@ -362,6 +363,9 @@ namespace gtsam {
 
     friend class NonlinearFactorGraph;
     friend class NonlinearClusterTree;
+    friend GTSAM_EXPORT std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
+      EliminateCholeskyInWorkspace(const GaussianFactorGraph& factors, const Ordering& keys,
+                                   const Scatter& scatter, EliminationWorkspace& workspace);
 
     /** Serialization function */
     friend class boost::serialization::access;
@@ -409,6 +413,24 @@ GTSAM_EXPORT std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr
 GTSAM_EXPORT std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<GaussianFactor> >
   EliminatePreferCholesky(const GaussianFactorGraph& factors, const Ordering& keys);
 
+/**
+*   Same as EliminateCholesky, but the joint Hessian of \c factors is formed and factorized in the
+*   storage that \c workspace holds for the calling thread, rather than in a newly allocated
+*   HessianFactor.  Only the conditional and the remaining factor on the separator are copied out
+*   of it.  \c scatter must be the Scatter of \c factors with the frontal \c keys first, as
+*   computed by Scatter(factors, keys).
+*
+*   @param factors Factors to combine and eliminate
+*   @param keys The variables to eliminate and their elimination ordering
+*   @param scatter The joint keys and their dimensions
+*   @param workspace Storage for the joint Hessian, see EliminationWorkspace
+*   @return The conditional and remaining factor
+*
+*   \addtogroup LinearSolving */
+GTSAM_EXPORT std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
+  EliminateCholeskyInWorkspace(const GaussianFactorGraph& factors, const Ordering& keys,
+                               const Scatter& scatter, EliminationWorkspace& workspace);
+
 /// traits
 template<>
 struct traits<HessianFactor> : public Testable<HessianFactor> {};
@@ -0,0 +1,167 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    IncompleteCholeskyPreconditioner.cpp
+ * @brief   Block incomplete Cholesky preconditioner for PCG
+ * @date    Oct 16, 2026
+ */
+
+#include <gtsam/linear/IncompleteCholeskyPreconditioner.h>
+#include <gtsam/linear/BlockSparseHessian.h>
+#include <gtsam/linear/IterativeSolver.h>
+#include <gtsam/base/timing.h>
+
+#include <iostream>
+#include <map>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/*****************************************************************************/
+void IncompleteCholeskyPreconditionerParameters::print(ostream &os) const {
+  Base::print(os);
+  os << "dropTolerance: " << dropTolerance_ << endl;
+}
+
+/*****************************************************************************/
+IncompleteCholeskyPreconditioner::IncompleteCholeskyPreconditioner(
+    const IncompleteCholeskyPreconditionerParameters &p)
+    : Base(), dropTolerance_(p.dropTolerance_) {}
+
+/*****************************************************************************/
+void IncompleteCholeskyPreconditioner::build(
+    const GaussianFactorGraph &gfg, const KeyInfo &keyInfo,
+    const map<Key, Vector> &lambda) {
+  gttic(IncompleteCholeskyPreconditioner_build);
+  const BlockSparseHessian hessian(gfg, keyInfo);
+  const size_t n = hessian.numBlocks();
+  dims_.resize(n);
+  starts_.resize(n);
+
+  // Diagonal blocks, and the blocks below the diagonal by column
+  vector<Matrix> diagonal(n);
+  vector<map<size_t, Matrix> > below(n);
+  for (size_t i = 0; i < n; ++i) {
+    dims_[i] = hessian.blockDim(i);
+    starts_[i] = hessian.blockStart(i);
+    for (size_t k = hessian.rowBegin(i); k < hessian.rowEnd(i); ++k) {
+      const size_t j = hessian.column(k);
+      if (j == i)
+        diagonal[i] = hessian.block(i, k);
+      else if (j < i)
+        below[j].emplace(i, hessian.block(i, k));
+    }
+  }
+
+  diagonal_.resize(n);
+  columnStarts_.resize(n + 1);
+  rows_.clear();
+  offsets_.clear();
+  values_.clear();
+  for (size_t j = 0; j < n; ++j) {
+    // Factor the diagonal block, shifting it if needed
+    Matrix& D = diagonal[j];
+    Eigen::LLT<Matrix> llt(D);
+    double shift = 1e-9 * std::max(1.0, D.diagonal().cwiseAbs().maxCoeff());
+    for (size_t attempt = 0; llt.info() != Eigen::Success; ++attempt) {
+      if (attempt == 40)
+        throw runtime_error(
+            "IncompleteCholeskyPreconditioner: diagonal block is not finite");
+      llt.compute(D + shift * Matrix::Identity(D.rows(), D.cols()));
+      shift *= 10.0;
+    }
+    const Matrix Ljj = llt.matrixL();
+
+    // Column j of L, dropping small blocks for ICT
+    map<size_t, Matrix>& column = below[j];
+    const double threshold = dropTolerance_ * Ljj.norm();
+    for (map<size_t, Matrix>::iterator it = column.begin(); it != column.end();) {
+      Ljj.transpose().triangularView<Eigen::Upper>()
+          .solveInPlace<Eigen::OnTheRight>(it->second);
+      if (dropTolerance_ > 0.0 && it->second.norm() < threshold)
+        it = column.erase(it);
+      else
+        ++it;
+    }
+
+    // Update the columns to the right
+    for (map<size_t, Matrix>::const_iterator a = column.begin();
+         a != column.end(); ++a) {
+      diagonal[a->first].noalias() -= a->second * a->second.transpose();
+      map<size_t, Matrix>& target = below[a->first];
+      map<size_t, Matrix>::const_iterator b = a;
+      for (++b; b != column.end(); ++b) {
+        map<size_t, Matrix>::iterator block = target.find(b->first);
+        if (block == target.end()) {
+          if (dropTolerance_ <= 0.0) continue;
+          block = target.emplace(b->first,
+                                 Matrix::Zero(dims_[b->first], dims_[a->first]))
+                      .first;
+        }
+        block->second.noalias() -= b->second * a->second.transpose();
+      }
+    }
+
+    // Store the column
+    diagonal_[j] = values_.size();
+    values_.insert(values_.end(), Ljj.data(), Ljj.data() + Ljj.size());
+    columnStarts_[j] = rows_.size();
+    for (const map<size_t, Matrix>::value_type& block : column) {
+      rows_.push_back(block.first);
+      offsets_.push_back(values_.size());
+      values_.insert(values_.end(), block.second.data(),
+                     block.second.data() + block.second.size());
+    }
+    map<size_t, Matrix>().swap(column);
+  }
+  columnStarts_[n] = rows_.size();
+}
+
+/*****************************************************************************/
+void IncompleteCholeskyPreconditioner::solve(const Vector& y, Vector &x) const {
+  // Forward substitution, by column
+  x = y;
+  for (size_t j = 0; j < dims_.size(); ++j) {
+    Eigen::Map<Vector> xj(x.data() + starts_[j], dims_[j]);
+    Eigen::Map<const Matrix>(&values_[diagonal_[j]], dims_[j], dims_[j])
+        .triangularView<Eigen::Lower>().solveInPlace(xj);
+    for (size_t k = columnStarts_[j]; k < columnStarts_[j + 1]; ++k) {
+      const size_t i = rows_[k];
+      x.segment(starts_[i], dims_[i]).noalias() -=
+          Eigen::Map<const Matrix>(&values_[offsets_[k]], dims_[i], dims_[j]) *
+          xj;
+    }
+  }
+}
+
+/*****************************************************************************/
+void IncompleteCholeskyPreconditioner::transposeSolve(const Vector& y,
+                                                      Vector& x) const {
+  // Back substitution with L^T, by row of L^T
+  x = y;
+  for (size_t j = dims_.size(); j-- > 0;) {
+    Eigen::Map<Vector> xj(x.data() + starts_[j], dims_[j]);
+    for (size_t k = columnStarts_[j]; k < columnStarts_[j + 1]; ++k) {
+      const size_t i = rows_[k];
+      xj.noalias() -=
+          Eigen::Map<const Matrix>(&values_[offsets_[k]], dims_[i], dims_[j])
+              .transpose() *
+          x.segment(starts_[i], dims_[i]);
+    }
+    Eigen::Map<const Matrix>(&values_[diagonal_[j]], dims_[j], dims_[j])
+        .transpose().triangularView<Eigen::Upper>().solveInPlace(xj);
+  }
+}
+
+}  // namespace gtsam
@@ -0,0 +1,81 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    IncompleteCholeskyPreconditioner.h
+ * @brief   Block incomplete Cholesky preconditioner for PCG
+ * @date    Oct 16, 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/Preconditioner.h>
+
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Parameters for IncompleteCholeskyPreconditioner.  A drop tolerance of 0
+ * gives IC(0), which keeps the block sparsity pattern of the Hessian.  A
+ * positive drop tolerance gives ICT: fill-in is allowed, but off-diagonal
+ * blocks of the factor whose norm is below dropTolerance_ times the norm of
+ * the diagonal block of their column are dropped.
+ */
+struct GTSAM_EXPORT IncompleteCholeskyPreconditionerParameters
+    : public PreconditionerParameters {
+  typedef PreconditionerParameters Base;
+  typedef boost::shared_ptr<IncompleteCholeskyPreconditionerParameters> shared_ptr;
+
+  double dropTolerance_;
+
+  IncompleteCholeskyPreconditionerParameters(double dropTolerance = 0.0)
+      : Base(), dropTolerance_(dropTolerance) {}
+  virtual ~IncompleteCholeskyPreconditionerParameters() {}
+
+  void print(std::ostream &os) const override;
+};
+
+/**
+ * Block incomplete Cholesky factorization L*L^T of the Hessian A'A, with one
+ * block per variable, in the order of the KeyInfo.  Elimination updates that
+ * fall outside the kept pattern are discarded.  A diagonal block that is not
+ * positive definite, because of the discarded updates, is shifted until it is.
+ */
+class GTSAM_EXPORT IncompleteCholeskyPreconditioner : public Preconditioner {
+public:
+  typedef Preconditioner Base;
+
+  IncompleteCholeskyPreconditioner(
+      const IncompleteCholeskyPreconditionerParameters &p =
+          IncompleteCholeskyPreconditionerParameters());
+  virtual ~IncompleteCholeskyPreconditioner() {}
+
+  /* Computation Interfaces for raw vector */
+  void solve(const Vector& y, Vector &x) const override;
+  void transposeSolve(const Vector& y, Vector& x) const override;
+  void build(const GaussianFactorGraph &gfg, const KeyInfo &info,
+             const std::map<Key, Vector> &lambda) override;
+
+  /// Number of blocks of L, including the diagonal
+  size_t nnzBlocks() const { return dims_.size() + rows_.size(); }
+
+protected:
+  double dropTolerance_;
+  std::vector<size_t> dims_, starts_;  ///< Of each variable, from KeyInfo
+  std::vector<size_t> diagonal_;       ///< Offset of each diagonal block
+  std::vector<size_t> columnStarts_;   ///< First block below the diagonal
+  std::vector<size_t> rows_;           ///< Block row of each such block
+  std::vector<size_t> offsets_;        ///< Offset of each such block
+  std::vector<double> values_;         ///< Column-major blocks
+};
+
+}  // namespace gtsam
@@ -502,6 +502,68 @@ map<Key, Matrix> JacobianFactor::hessianBlockDiagonal() const {
   return blocks;
 }
 
+/* ************************************************************************* */
+namespace {
+static const DenseIndex kMaxFixedSizeBlocks = 4;
+
+// I += A'*A for M rows and blocks of D columns, whitened row by row, with
+// fixed-size products written straight into the blocks of I
+template <int M, int D>
+void updateHessianFixedSize(const VerticalBlockMatrix& Ab, const KeyVector& keys,
+                            const SharedDiagonal& model,
+                            const KeyVector& infoKeys,
+                            SymmetricBlockMatrix* info) {
+  typedef Eigen::Matrix<double, M, 1> VectorM;
+  typedef Eigen::Matrix<double, M, D> MatrixMD;
+  const DenseIndex n = Ab.nBlocks() - 1, N = info->nBlocks() - 1;
+  const VectorM sqrtWeights =
+      model && !model->isUnit() ? VectorM(model->invsigmas()) : VectorM::Ones();
+  const VectorM b = sqrtWeights.cwiseProduct(Ab(n).col(0).head<M>());
+
+  DenseIndex slots[kMaxFixedSizeBlocks];
+  for (DenseIndex j = 0; j < n; ++j) {
+    const MatrixMD Aj = sqrtWeights.asDiagonal() * Ab(j).block<M, D>(0, 0);
+    const DenseIndex J = slots[j] = GaussianFactor::Slot(infoKeys, keys[j]);
+    for (DenseIndex i = 0; i < j; ++i) {
+      const MatrixMD Ai = sqrtWeights.asDiagonal() * Ab(i).block<M, D>(0, 0);
+      if (slots[i] < J)
+        info->fixedBlock<D, D>(slots[i], J).noalias() += Ai.transpose() * Aj;
+      else
+        info->fixedBlock<D, D>(J, slots[i]).noalias() += Aj.transpose() * Ai;
+    }
+    info->fixedBlock<D, D>(J, J).template triangularView<Eigen::Upper>() +=
+        Aj.transpose() * Aj;
+    info->fixedBlock<D, 1>(J, N).noalias() += Aj.transpose() * b;
+  }
+  info->fixedBlock<1, 1>(N, N)(0, 0) += b.squaredNorm();
+}
+
+// Calls the fixed-size update for the common sizes of factors on poses and
+// cameras, where all blocks have the same width, returns false otherwise
+bool updateHessianFixedSize(const VerticalBlockMatrix& Ab, const KeyVector& keys,
+                            const SharedDiagonal& model,
+                            const KeyVector& infoKeys,
+                            SymmetricBlockMatrix* info) {
+  const DenseIndex n = Ab.nBlocks() - 1;
+  if (n == 0 || n > kMaxFixedSizeBlocks) return false;
+  const DenseIndex m = Ab.rows(), d = Ab(0).cols();
+  for (DenseIndex j = 1; j < n; ++j)
+    if (Ab(j).cols() != d) return false;
+
+  if (m == 2 && d == 6)
+    updateHessianFixedSize<2, 6>(Ab, keys, model, infoKeys, info);
+  else if (m == 3 && d == 6)
+    updateHessianFixedSize<3, 6>(Ab, keys, model, infoKeys, info);
+  else if (m == 6 && d == 6)
+    updateHessianFixedSize<6, 6>(Ab, keys, model, infoKeys, info);
+  else if (m == 2 && d == 9)
+    updateHessianFixedSize<2, 9>(Ab, keys, model, infoKeys, info);
+  else
+    return false;
+  return true;
+}
+}  // namespace
+
 /* ************************************************************************* */
 void JacobianFactor::updateHessian(const KeyVector& infoKeys,
                                    SymmetricBlockMatrix* info) const {
@@ -509,13 +571,16 @@ void JacobianFactor::updateHessian(const KeyVector& infoKeys,
 
   if (rows() == 0) return;
 
-  // Whiten the factor if it has a noise model
   const SharedDiagonal& model = get_model();
+  if (model && model->isConstrained())
+    throw invalid_argument(
+        "JacobianFactor::updateHessian: cannot update information with "
+        "constrained noise model");
+
+  if (updateHessianFixedSize(Ab_, keys_, model, infoKeys, info)) return;
+
+  // Whiten the factor if it has a noise model
   if (model && !model->isUnit()) {
-    if (model->isConstrained())
-      throw invalid_argument(
-          "JacobianFactor::updateHessian: cannot update information with "
-          "constrained noise model");
     JacobianFactor whitenedFactor = whiten();
     whitenedFactor.updateHessian(infoKeys, info);
   } else {
@@ -0,0 +1,212 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    MultigridPreconditioner.cpp
+ * @brief   Algebraic multigrid preconditioner for PCG
+ * @date    Oct 16, 2026
+ */
+
+#include <gtsam/linear/MultigridPreconditioner.h>
+#include <gtsam/linear/IterativeSolver.h>
+#include <gtsam/base/timing.h>
+
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+namespace gtsam {
+
+static const size_t kNone = numeric_limits<size_t>::max();
+
+/*****************************************************************************/
+void MultigridPreconditionerParameters::print(ostream &os) const {
+  Base::print(os);
+  os << "maxLevels:       " << maxLevels_ << endl
+     << "coarsestDim:     " << coarsestDim_ << endl
+     << "smoothingSweeps: " << smoothingSweeps_ << endl;
+}
+
+/*****************************************************************************/
+MultigridPreconditioner::MultigridPreconditioner(
+    const MultigridPreconditionerParameters &p)
+    : Base(), parameters_(p) {}
+
+/*****************************************************************************/
+void MultigridPreconditioner::build(const GaussianFactorGraph &gfg,
+                                    const KeyInfo &keyInfo,
+                                    const map<Key, Vector> &lambda) {
+  gttic(MultigridPreconditioner_build);
+  levels_.clear();
+  levels_.emplace_back(BlockSparseHessian(gfg, keyInfo));
+  while (levels_.size() < parameters_.maxLevels_ &&
+         levels_.back().A.dim() > parameters_.coarsestDim_ && coarsen()) {
+  }
+
+  // A coarsest level that is still large is smoothed rather than factored
+  if (levels_.back().A.dim() <= parameters_.coarsestDim_)
+    coarsest_.compute(levels_.back().A.matrix());
+  else
+    factorDiagonal(levels_.back());
+}
+
+/*****************************************************************************/
+void MultigridPreconditioner::factorDiagonal(Level& level) {
+  const BlockSparseHessian& A = level.A;
+  level.diagonal.resize(A.numBlocks());
+  for (size_t i = 0; i < A.numBlocks(); ++i)
+    for (size_t k = A.rowBegin(i); k < A.rowEnd(i); ++k)
+      if (A.column(k) == i) level.diagonal[i].compute(A.block(i, k));
+}
+
+/*****************************************************************************/
+bool MultigridPreconditioner::coarsen() {
+  Level& fine = levels_.back();
+  const BlockSparseHessian& A = fine.A;
+  const size_t n = A.numBlocks();
+
+  // Neighbours of the same dimension.  Pose graphs have few neighbours per
+  // variable with similar weights, so all of them are considered strongly
+  // connected.
+  vector<vector<size_t> > strong(n);
+  for (size_t i = 0; i < n; ++i)
+    for (size_t k = A.rowBegin(i); k < A.rowEnd(i); ++k) {
+      const size_t j = A.column(k);
+      if (j != i && A.blockDim(j) == A.blockDim(i)) strong[i].push_back(j);
+    }
+
+  // Greedy aggregation: first whole neighbourhoods, then attach the rest to a
+  // neighbouring aggregate, and group what is left
+  vector<size_t>& aggregate = fine.aggregate;
+  aggregate.assign(n, kNone);
+  size_t numAggregates = 0;
+  for (size_t i = 0; i < n; ++i) {
+    if (aggregate[i] != kNone) continue;
+    bool free = true;
+    for (size_t j : strong[i]) free = free && aggregate[j] == kNone;
+    if (!free) continue;
+    aggregate[i] = numAggregates;
+    for (size_t j : strong[i]) aggregate[j] = numAggregates;
+    ++numAggregates;
+  }
+  vector<size_t> attached(aggregate);
+  for (size_t i = 0; i < n; ++i) {
+    if (aggregate[i] != kNone) continue;
+    for (size_t j : strong[i])
+      if (aggregate[j] != kNone) {
+        attached[i] = aggregate[j];
+        break;
+      }
+  }
+  aggregate.swap(attached);
+  for (size_t i = 0; i < n; ++i) {
+    if (aggregate[i] != kNone) continue;
+    aggregate[i] = numAggregates;
+    for (size_t j : strong[i])
+      if (aggregate[j] == kNone) aggregate[j] = numAggregates;
+    ++numAggregates;
+  }
+  if (numAggregates * 10 > n * 9) {
+    aggregate.clear();
+    return false;
+  }
+
+  // Galerkin coarse operator P'AP, with P the identity on each aggregate
+  vector<size_t> coarseDims(numAggregates);
+  for (size_t i = 0; i < n; ++i) coarseDims[aggregate[i]] = A.blockDim(i);
+  map<pair<size_t, size_t>, Matrix> blocks;
+  for (size_t i = 0; i < n; ++i)
+    for (size_t k = A.rowBegin(i); k < A.rowEnd(i); ++k) {
+      const pair<size_t, size_t> index(aggregate[i], aggregate[A.column(k)]);
+      map<pair<size_t, size_t>, Matrix>::iterator block = blocks.find(index);
+      if (block == blocks.end())
+        blocks.emplace(index, A.block(i, k));
+      else
+        block->second += A.block(i, k);
+    }
+
+  factorDiagonal(fine);
+  levels_.emplace_back(BlockSparseHessian(coarseDims, blocks));
+  return true;
+}
+
+/*****************************************************************************/
+void MultigridPreconditioner::smooth(const Level& level, const Vector& b,
+                                     Vector& x, bool forward) const {
+  const BlockSparseHessian& A = level.A;
+  const size_t n = A.numBlocks();
+  for (size_t step = 0; step < n; ++step) {
+    const size_t i = forward ? step : n - 1 - step;
+    const size_t start = A.blockStart(i), dim = A.blockDim(i);
+    Vector r = b.segment(start, dim);
+    for (size_t k = A.rowBegin(i); k < A.rowEnd(i); ++k) {
+      const size_t j = A.column(k);
+      if (j != i)
+        r.noalias() -= A.block(i, k) * x.segment(A.blockStart(j), A.blockDim(j));
+    }
+    x.segment(start, dim) = level.diagonal[i].solve(r);
+  }
+}
+
+/*****************************************************************************/
+void MultigridPreconditioner::vcycle(size_t l, const Vector& b,
+                                     Vector& x) const {
+  const Level& level = levels_[l];
+  if (l + 1 == levels_.size()) {
+    if (level.diagonal.empty()) {
+      x = coarsest_.solve(b);
+    } else {
+      x = Vector::Zero(level.A.dim());
+      for (size_t s = 0; s < parameters_.smoothingSweeps_; ++s) {
+        smooth(level, b, x, true);
+        smooth(level, b, x, false);
+      }
+    }
+    return;
+  }
+  const BlockSparseHessian& A = level.A;
+  const BlockSparseHessian& coarse = levels_[l + 1].A;
+
+  // Pre-smoothing
+  x = Vector::Zero(A.dim());
+  for (size_t s = 0; s < parameters_.smoothingSweeps_; ++s)
+    smooth(level, b, x, true);
+
+  // Restrict the residual, correct on the coarse level and prolong
+  Vector r;
+  A.multiply(x, r);
+  r = b - r;
+  Vector rc = Vector::Zero(coarse.dim()), xc;
+  for (size_t i = 0; i < A.numBlocks(); ++i)
+    rc.segment(coarse.blockStart(level.aggregate[i]), A.blockDim(i)) +=
+        r.segment(A.blockStart(i), A.blockDim(i));
+  vcycle(l + 1, rc, xc);
+  for (size_t i = 0; i < A.numBlocks(); ++i)
+    x.segment(A.blockStart(i), A.blockDim(i)) +=
+        xc.segment(coarse.blockStart(level.aggregate[i]), A.blockDim(i));
+
+  // Post-smoothing, in the opposite order to keep the V-cycle symmetric
+  for (size_t s = 0; s < parameters_.smoothingSweeps_; ++s)
+    smooth(level, b, x, false);
+}
+
+/*****************************************************************************/
+void MultigridPreconditioner::solve(const Vector& y, Vector &x) const {
+  vcycle(0, y, x);
+}
+
+/*****************************************************************************/
+void MultigridPreconditioner::precondition(const Vector& y, Vector &x) const {
+  vcycle(0, y, x);
+}
+
+}  // namespace gtsam
@@ -0,0 +1,108 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    MultigridPreconditioner.h
+ * @brief   Algebraic multigrid preconditioner for PCG
+ * @date    Oct 16, 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/Preconditioner.h>
+#include <gtsam/linear/BlockSparseHessian.h>
+
+#include <Eigen/Cholesky>
+
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Parameters for MultigridPreconditioner
+ */
+struct GTSAM_EXPORT MultigridPreconditionerParameters
+    : public PreconditionerParameters {
+  typedef PreconditionerParameters Base;
+  typedef boost::shared_ptr<MultigridPreconditionerParameters> shared_ptr;
+
+  size_t maxLevels_;        ///< Maximum number of levels, including the finest
+  size_t coarsestDim_;      ///< Coarsen until at most this many unknowns remain
+  size_t smoothingSweeps_;  ///< Gauss-Seidel sweeps before and after correction
+
+  MultigridPreconditionerParameters()
+      : Base(), maxLevels_(10), coarsestDim_(500), smoothingSweeps_(1) {}
+  virtual ~MultigridPreconditionerParameters() {}
+
+  void print(std::ostream &os) const override;
+};
+
+/**
+ * Aggregation-based algebraic multigrid on the variables of the Hessian A'A.
+ * Each level greedily groups neighbouring variables of the same dimension
+ * into aggregates, which are the variables of the next level, with a
+ * piecewise constant prolongation.  The coarsest level is solved with a dense
+ * Cholesky factorization, or smoothed if coarsening stopped before it was
+ * small enough.  One V-cycle with forward block Gauss-Seidel before, and
+ * backward block Gauss-Seidel after the coarse correction, is a symmetric
+ * positive definite approximation of the inverse of A'A.
+ *
+ * The V-cycle is not available as a factorization L*L^T: solve() applies it
+ * and transposeSolve() is the identity, so that precondition() is the V-cycle.
+ */
+class GTSAM_EXPORT MultigridPreconditioner : public Preconditioner {
+public:
+  typedef Preconditioner Base;
+
+  MultigridPreconditioner(const MultigridPreconditionerParameters &p =
+                              MultigridPreconditionerParameters());
+  virtual ~MultigridPreconditioner() {}
+
+  /* Computation Interfaces for raw vector */
+  void solve(const Vector& y, Vector &x) const override;
+  void transposeSolve(const Vector& y, Vector& x) const override { x = y; }
+  void precondition(const Vector& y, Vector& x) const override;
+  void build(const GaussianFactorGraph &gfg, const KeyInfo &info,
+             const std::map<Key, Vector> &lambda) override;
+
+  /// Number of levels, including the finest and the coarsest
+  size_t numLevels() const { return levels_.size(); }
+
+  /// Number of scalar unknowns on a level
+  size_t levelDim(size_t level) const { return levels_[level].A.dim(); }
+
+protected:
+  struct Level {
+    BlockSparseHessian A;
+    std::vector<Eigen::LDLT<Matrix> > diagonal;  ///< For Gauss-Seidel
+    std::vector<size_t> aggregate;  ///< Variable of the next level
+    explicit Level(const BlockSparseHessian& A) : A(A) {}
+  };
+
+  /// Coarsen the last level, returns false if it does not coarsen well
+  bool coarsen();
+
+  /// Factor the diagonal blocks of a level, for the smoother
+  static void factorDiagonal(Level& level);
+
+  /// One Gauss-Seidel sweep on a level, forward or backward
+  void smooth(const Level& level, const Vector& b, Vector& x,
+              bool forward) const;
+
+  /// x = V-cycle applied to b, from the given level down
+  void vcycle(size_t l, const Vector& b, Vector& x) const;
+
+  MultigridPreconditionerParameters parameters_;
+  std::vector<Level> levels_;
+  Eigen::LDLT<Matrix> coarsest_;
+};
+
+}  // namespace gtsam
@@ -307,6 +307,11 @@ void Diagonal::WhitenInPlace(Eigen::Block<Matrix> H) const {
   H = invsigmas().asDiagonal() * H;
 }
 
+/* ************************************************************************* */
+void Diagonal::whitenInPlace(Eigen::Block<Vector>& v) const {
+  v = v.cwiseProduct(invsigmas_);
+}
+
 /* ************************************************************************* */
 // Constrained
 /* ************************************************************************* */
@@ -370,6 +375,14 @@ Vector Constrained::whiten(const Vector& v) const {
   return c;
 }
 
+/* ************************************************************************* */
+void Constrained::whitenInPlace(Eigen::Block<Vector>& v) const {
+  // Same as whiten, element by element so that no temporary is allocated
+  assert(v.size() == sigmas_.size());
+  for (DenseIndex i = 0; i < v.size(); ++i)
+    if (sigmas_(i) != 0.0) v(i, 0) /= sigmas_(i);
+}
+
 /* ************************************************************************* */
 double Constrained::distance(const Vector& v) const {
   Vector w = Diagonal::whiten(v); // get noisemodel for constrained elements
@@ -604,6 +617,11 @@ void Isotropic::whitenInPlace(Vector& v) const {
   v *= invsigma_;
 }
 
+/* ************************************************************************* */
+void Isotropic::whitenInPlace(Eigen::Block<Vector>& v) const {
+  v *= invsigma_;
+}
+
 /* ************************************************************************* */
 void Isotropic::WhitenInPlace(Eigen::Block<Matrix> H) const {
   H *= invsigma_;
@@ -319,6 +319,8 @@ namespace gtsam {
       virtual Matrix Whiten(const Matrix& H) const;
       virtual void WhitenInPlace(Matrix& H) const;
       virtual void WhitenInPlace(Eigen::Block<Matrix> H) const;
+      using Base::whitenInPlace;
+      virtual void whitenInPlace(Eigen::Block<Vector>& v) const;
 
       /**
        * Return standard deviations (sqrt of diagonal)
@@ -475,6 +477,8 @@ namespace gtsam {
 
       /// Calculates error vector with weights applied
       virtual Vector whiten(const Vector& v) const;
+      using Diagonal::whitenInPlace;
+      virtual void whitenInPlace(Eigen::Block<Vector>& v) const;
 
       /// Whitening functions will perform partial whitening on rows
       /// with a non-zero sigma.  Other rows remain untouched.
@@ -560,6 +564,7 @@ namespace gtsam {
       virtual Matrix Whiten(const Matrix& H) const;
       virtual void WhitenInPlace(Matrix& H) const;
       virtual void whitenInPlace(Vector& v) const;
+      virtual void whitenInPlace(Eigen::Block<Vector>& v) const;
       virtual void WhitenInPlace(Eigen::Block<Matrix> H) const;
 
       /**
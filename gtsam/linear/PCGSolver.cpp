@@ -53,7 +53,8 @@ VectorValues PCGSolver::optimize(const GaussianFactorGraph &gfg,
   preconditioner_->build(gfg, keyInfo, lambda);
 
   /* apply pcg */
-  GaussianFactorGraphSystem system(gfg, *preconditioner_, keyInfo, lambda);
+  GaussianFactorGraphSystem system(gfg, *preconditioner_, keyInfo, lambda,
+      parameters_.numThreads_);
   Vector x0 = initial.vector(keyInfo.ordering());
   const Vector sol = preconditionedConjugateGradient(system, x0, parameters_);
 
@@ -63,9 +64,10 @@ VectorValues PCGSolver::optimize(const GaussianFactorGraph &gfg,
 /*****************************************************************************/
 GaussianFactorGraphSystem::GaussianFactorGraphSystem(
     const GaussianFactorGraph &gfg, const Preconditioner &preconditioner,
-    const KeyInfo &keyInfo, const std::map<Key, Vector> &lambda) :
+    const KeyInfo &keyInfo, const std::map<Key, Vector> &lambda,
+    size_t numThreads) :
     gfg_(gfg), preconditioner_(preconditioner), keyInfo_(keyInfo), lambda_(
-        lambda) {
+        lambda), hessian_(gfg, keyInfo, numThreads) {
 }
 
 /*****************************************************************************/
@@ -84,29 +86,15 @@ void GaussianFactorGraphSystem::residual(const Vector &x, Vector &r) const {
 /*****************************************************************************/
 void GaussianFactorGraphSystem::multiply(const Vector &x, Vector& AtAx) const {
   /* implement A^T*(A*x), assume x and AtAx are pre-allocated */
-
-  // Build a VectorValues for Vector x
-  VectorValues vvX = buildVectorValues(x, keyInfo_);
-
-  // VectorValues form of A'Ax for multiplyHessianAdd
-  VectorValues vvAtAx = keyInfo_.x0(); // crucial for performance
-
-  // vvAtAx += 1.0 * A'Ax for each factor
-  gfg_.multiplyHessianAdd(1.0, vvX, vvAtAx);
-
-  // Make the result as Vector form
-  AtAx = vvAtAx.vector(keyInfo_.ordering());
+  hessian_.multiply(x, AtAx);
 }
 
 /*****************************************************************************/
 void GaussianFactorGraphSystem::getb(Vector &b) const {
   /* compute rhs, assume b pre-allocated */
 
-  // Get whitened r.h.s (A^T * b) from each factor in the form of VectorValues
-  VectorValues vvb = gfg_.gradientAtZero();
-
-  // Make the result as Vector form
-  b = -vvb.vector(keyInfo_.ordering());
+  // Whitened r.h.s A^T * b
+  b = hessian_.linearTerm();
 }
 
 /**********************************************************************************/
@@ -125,6 +113,13 @@ void GaussianFactorGraphSystem::rightPrecondition(const Vector &x,
   preconditioner_.transposeSolve(x, y);
 }
 
+/**********************************************************************************/
+void GaussianFactorGraphSystem::precondition(const Vector &x,
+    Vector &y) const {
+  // Calculate y = M^{-1} x
+  preconditioner_.precondition(x, y);
+}
+
 /**********************************************************************************/
 VectorValues buildVectorValues(const Vector &v, const Ordering &ordering,
     const map<Key, size_t> & dimensions) {
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <gtsam/linear/ConjugateGradientSolver.h>
+#include <gtsam/linear/BlockSparseHessian.h>
 #include <string>
 
 namespace gtsam {
@@ -38,7 +39,7 @@ public:
   typedef ConjugateGradientParameters Base;
   typedef boost::shared_ptr<PCGSolverParameters> shared_ptr;
 
-  PCGSolverParameters() {
+  PCGSolverParameters() : numThreads_(1) {
   }
 
   virtual void print(std::ostream &os) const;
@@ -49,6 +50,10 @@ public:
   }
 
   boost::shared_ptr<PreconditionerParameters> preconditioner_;
+
+  /// Number of threads for the products with the Hessian (default: 1, 0
+  /// means one per hardware thread)
+  size_t numThreads_;
 };
 
 /**
@@ -79,24 +84,28 @@ public:
 };
 
 /**
- * System class needed for calling preconditionedConjugateGradient
+ * System class needed for calling preconditionedConjugateGradient.  The graph
+ * is flattened into a BlockSparseHessian on construction, so that the
+ * products of the CG iterations need no key lookups.
  */
 class GTSAM_EXPORT GaussianFactorGraphSystem {
 public:
 
   GaussianFactorGraphSystem(const GaussianFactorGraph &gfg,
       const Preconditioner &preconditioner, const KeyInfo &info,
-      const std::map<Key, Vector> &lambda);
+      const std::map<Key, Vector> &lambda, size_t numThreads = 1);
 
   const GaussianFactorGraph &gfg_;
   const Preconditioner &preconditioner_;
   const KeyInfo &keyInfo_;
   const std::map<Key, Vector> &lambda_;
+  const BlockSparseHessian hessian_;
 
   void residual(const Vector &x, Vector &r) const;
   void multiply(const Vector &x, Vector& y) const;
   void leftPrecondition(const Vector &x, Vector &y) const;
   void rightPrecondition(const Vector &x, Vector &y) const;
+  void precondition(const Vector &x, Vector &y) const;
   inline void scal(const double alpha, Vector &x) const {
     x *= alpha;
   }
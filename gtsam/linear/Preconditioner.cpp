@@ -11,6 +11,8 @@
 #include <gtsam/linear/PCGSolver.h>
 #include <gtsam/linear/Preconditioner.h>
 #include <gtsam/linear/SubgraphPreconditioner.h>
+#include <gtsam/linear/IncompleteCholeskyPreconditioner.h>
+#include <gtsam/linear/MultigridPreconditioner.h>
 #include <gtsam/linear/NoiseModel.h>
 #include <boost/shared_ptr.hpp>
 #include <boost/algorithm/string.hpp>
@@ -191,6 +193,12 @@ boost::shared_ptr<Preconditioner> createPreconditioner(const boost::shared_ptr<P
   else if ( BlockJacobiPreconditionerParameters::shared_ptr blockJacobi = boost::dynamic_pointer_cast<BlockJacobiPreconditionerParameters>(parameters) ) {
     return boost::make_shared<BlockJacobiPreconditioner>();
   }
+  else if ( IncompleteCholeskyPreconditionerParameters::shared_ptr incompleteCholesky = boost::dynamic_pointer_cast<IncompleteCholeskyPreconditionerParameters>(parameters) ) {
+    return boost::make_shared<IncompleteCholeskyPreconditioner>(*incompleteCholesky);
+  }
+  else if ( MultigridPreconditionerParameters::shared_ptr multigrid = boost::dynamic_pointer_cast<MultigridPreconditionerParameters>(parameters) ) {
+    return boost::make_shared<MultigridPreconditioner>(*multigrid);
+  }
   else if ( SubgraphPreconditionerParameters::shared_ptr subgraph = boost::dynamic_pointer_cast<SubgraphPreconditionerParameters>(parameters) ) {
     return boost::make_shared<SubgraphPreconditioner>(*subgraph);
   }
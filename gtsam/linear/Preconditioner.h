@@ -13,6 +13,7 @@
 #include <iosfwd>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace gtsam {
 
@@ -83,6 +84,13 @@ public:
   /// implement x = L^{-T} y
   virtual void transposeSolve(const Vector& y, Vector& x) const = 0;
 
+  /// implement x = M^{-1} y = L^{-T} L^{-1} y, as used by PCG
+  virtual void precondition(const Vector& y, Vector& x) const {
+    Vector z(y.size());
+    solve(y, z);
+    transposeSolve(z, x);
+  }
+
   /// build/factorize the preconditioner
   virtual void build(
     const GaussianFactorGraph &gfg,
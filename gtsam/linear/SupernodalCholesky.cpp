@@ -0,0 +1,381 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    SupernodalCholesky.cpp
+ * @brief   Sparse supernodal Cholesky factorization of the Hessian of a
+ * GaussianFactorGraph
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam/linear/SupernodalCholesky.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/linearExceptions.h>
+#include <gtsam/base/timing.h>
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+SupernodalCholesky::SupernodalCholesky(const GaussianFactorGraph& graph,
+                                       const Ordering& ordering,
+                                       Precision precision)
+    : precision_(precision),
+      singlePrecision_(false),
+      maxRefinementSteps_(10),
+      refinementTolerance_(1e-10),
+      refinementSteps_(0) {
+  gttic(SupernodalCholesky_analyze);
+  const size_t n = ordering.size();
+  keys_.assign(ordering.begin(), ordering.end());
+  for (size_t p = 0; p < n; ++p)
+    if (!positions_.emplace(keys_[p], p).second)
+      throw invalid_argument("SupernodalCholesky: ordering contains key " +
+                             DefaultKeyFormatter(keys_[p]) + " twice");
+
+  // Dimensions, and the pattern of the lower triangle of the Hessian
+  dims_.assign(n, 0);
+  vector<vector<size_t> > below(n);
+  FastVector<size_t> factorPositions;
+  for (const GaussianFactor::shared_ptr& factor : graph) {
+    if (!factor) continue;
+    factorPositions.clear();
+    for (GaussianFactor::const_iterator it = factor->begin();
+         it != factor->end(); ++it) {
+      FastMap<Key, size_t>::const_iterator found = positions_.find(*it);
+      if (found == positions_.end())
+        throw invalid_argument("SupernodalCholesky: key " +
+                               DefaultKeyFormatter(*it) +
+                               " is not in the ordering");
+      dims_[found->second] = factor->getDim(it);
+      factorPositions.push_back(found->second);
+    }
+    for (size_t a : factorPositions)
+      for (size_t b : factorPositions)
+        if (a > b) below[b].push_back(a);
+  }
+  for (size_t p = 0; p < n; ++p)
+    if (dims_[p] == 0)
+      throw invalid_argument("SupernodalCholesky: key " +
+                             DefaultKeyFormatter(keys_[p]) +
+                             " is not in the factor graph");
+
+  // Pattern of each column of L: the pattern of the Hessian plus the fill-in
+  // from its children in the elimination tree, whose parent is the first row.
+  // Consecutive columns form a supernode when the pattern of the first is the
+  // second plus the pattern of the second.
+  vector<vector<size_t> > children(n);
+  vector<size_t> patternSize(n);
+  supernodeOf_.resize(n);
+  for (size_t j = 0; j < n; ++j) {
+    vector<size_t>& pattern = below[j];
+    for (size_t c : children[j]) {
+      pattern.insert(pattern.end(), below[c].begin() + 1, below[c].end());
+      vector<size_t>().swap(below[c]);
+    }
+    sort(pattern.begin(), pattern.end());
+    pattern.erase(unique(pattern.begin(), pattern.end()), pattern.end());
+    patternSize[j] = pattern.size();
+    if (!pattern.empty()) children[pattern.front()].push_back(j);
+
+    const bool extend = j > 0 && patternSize[j - 1] == patternSize[j] + 1 &&
+                        supernodes_.back().endColumn == j &&
+                        supernodes_.back().rows.front() == j;
+    if (!extend) {
+      supernodes_.push_back(Supernode());
+      supernodes_.back().firstColumn = j;
+    }
+    Supernode& s = supernodes_.back();
+    s.endColumn = j + 1;
+    s.rows = pattern;
+    supernodeOf_[j] = supernodes_.size() - 1;
+  }
+
+  // Offsets of variables within the panels and in the right-hand side
+  offsets_.resize(n);
+  columnOffsets_.resize(n);
+  size_t offset = 0;
+  for (Supernode& s : supernodes_) {
+    s.width = 0;
+    for (size_t p = s.firstColumn; p < s.endColumn; ++p) {
+      offsets_[p] = offset;
+      columnOffsets_[p] = s.width;
+      offset += dims_[p];
+      s.width += dims_[p];
+    }
+    size_t height = s.width;
+    s.rowOffsets.resize(s.rows.size());
+    for (size_t i = 0; i < s.rows.size(); ++i) {
+      s.rowOffsets[i] = height;
+      height += dims_[s.rows[i]];
+    }
+    s.height = height;
+  }
+  rhs_.resize(offset);
+}
+
+/* ************************************************************************* */
+size_t SupernodalCholesky::nnz() const {
+  size_t result = 0;
+  for (const Supernode& s : supernodes_)
+    result += s.width * (s.width + 1) / 2 + (s.height - s.width) * s.width;
+  return result;
+}
+
+/* ************************************************************************* */
+size_t SupernodalCholesky::panelRow(const Supernode& s, size_t p) const {
+  if (p >= s.firstColumn && p < s.endColumn) return columnOffsets_[p];
+  vector<size_t>::const_iterator it =
+      lower_bound(s.rows.begin(), s.rows.end(), p);
+  if (it == s.rows.end() || *it != p)
+    throw invalid_argument(
+        "SupernodalCholesky: the factor graph has a Hessian block outside of "
+        "the analyzed pattern");
+  return s.rowOffsets[it - s.rows.begin()];
+}
+
+/* ************************************************************************* */
+template <class PANEL>
+void SupernodalCholesky::assemble(const GaussianFactor& factor,
+                                  PANEL Supernode::*panel) {
+  typedef typename PANEL::Scalar Scalar;
+  const JacobianFactor* jacobian = dynamic_cast<const JacobianFactor*>(&factor);
+  if (jacobian && jacobian->isConstrained())
+    throw invalid_argument(
+        "SupernodalCholesky: constrained noise models are not supported");
+
+  // Positions of the factor's variables, and their offsets in its Hessian
+  const size_t k = factor.size();
+  FastVector<size_t> positions(k), offsets(k);
+  size_t offset = 0;
+  for (size_t a = 0; a < k; ++a) {
+    FastMap<Key, size_t>::const_iterator found =
+        positions_.find(factor.keys()[a]);
+    if (found == positions_.end() ||
+        dims_[found->second] != size_t(factor.getDim(factor.begin() + a)))
+      throw invalid_argument(
+          "SupernodalCholesky: the factor graph has different variables than "
+          "the analyzed one");
+    positions[a] = found->second;
+    offsets[a] = offset;
+    offset += dims_[found->second];
+  }
+
+  // Add the lower triangle of [A b]'[A b]
+  const Matrix information = factor.augmentedInformation();
+  for (size_t b = 0; b < k; ++b) {
+    const size_t pb = positions[b], db = dims_[pb];
+    Supernode& s = supernodes_[supernodeOf_[pb]];
+    const size_t column = columnOffsets_[pb];
+    for (size_t a = 0; a < k; ++a) {
+      const size_t pa = positions[a];
+      if (pa < pb) continue;
+      (s.*panel).block(panelRow(s, pa), column, dims_[pa], db) +=
+          information.block(offsets[a], offsets[b], dims_[pa], db)
+              .template cast<Scalar>();
+    }
+    rhs_.segment(offsets_[pb], db) += information.block(offsets[b], offset, db, 1);
+  }
+}
+
+/* ************************************************************************* */
+template <class PANEL>
+void SupernodalCholesky::eliminate(Supernode& s, PANEL Supernode::*panel,
+                                   PANEL& update) {
+  const size_t w = s.width, r = s.height - w;
+
+  // Dense Cholesky of the diagonal block, in place
+  Eigen::Ref<PANEL> D = (s.*panel).topLeftCorner(w, w);
+  Eigen::LLT<Eigen::Ref<PANEL> > llt(D);
+  if (llt.info() != Eigen::Success || !D.diagonal().allFinite())
+    throw IndeterminantLinearSystemException(keys_[s.firstColumn]);
+  if (r == 0) return;
+
+  // Off-diagonal block of L, and the update -B*B' to the later supernodes
+  Eigen::Ref<PANEL> B = (s.*panel).bottomRows(r);
+  D.template triangularView<Eigen::Lower>()
+      .transpose()
+      .template solveInPlace<Eigen::OnTheRight>(B);
+  update.setZero(r, r);
+  update.template selfadjointView<Eigen::Lower>().rankUpdate(B, -1);
+
+  // The rows of s are columns or rows of the supernode of each of them, in
+  // increasing order, so each column block is scattered with a single pass
+  for (size_t a = 0; a < s.rows.size(); ++a) {
+    const size_t pa = s.rows[a], da = dims_[pa], ua = s.rowOffsets[a] - w;
+    Supernode& t = supernodes_[supernodeOf_[pa]];
+    const size_t column = columnOffsets_[pa];
+    size_t next = 0;
+    for (size_t b = a; b < s.rows.size(); ++b) {
+      const size_t pb = s.rows[b];
+      size_t row;
+      if (pb < t.endColumn) {
+        row = columnOffsets_[pb];
+      } else {
+        while (t.rows[next] < pb) ++next;
+        assert(t.rows[next] == pb);
+        row = t.rowOffsets[next];
+      }
+      (t.*panel).block(row, column, dims_[pb], da) +=
+          update.block(s.rowOffsets[b] - w, ua, dims_[pb], da);
+    }
+  }
+}
+
+/* ************************************************************************* */
+void SupernodalCholesky::factorize(const GaussianFactorGraph& graph) {
+  gttic(SupernodalCholesky_factorize);
+  if (precision_ == MIXED) {
+    try {
+      factorize(graph, &Supernode::singlePanel);
+      for (Supernode& s : supernodes_) s.panel.resize(0, 0);
+      singlePrecision_ = true;
+      return;
+    } catch (const IndeterminantLinearSystemException&) {
+      // Not positive definite in single precision, try again in double
+      for (Supernode& s : supernodes_) s.singlePanel.resize(0, 0);
+    }
+  }
+  factorize(graph, &Supernode::panel);
+  singlePrecision_ = false;
+}
+
+/* ************************************************************************* */
+template <class PANEL>
+void SupernodalCholesky::factorize(const GaussianFactorGraph& graph,
+                                   PANEL Supernode::*panel) {
+  gttic(assemble);
+  rhs_.setZero();
+  for (Supernode& s : supernodes_) (s.*panel).setZero(s.height, s.width);
+  for (const GaussianFactor::shared_ptr& factor : graph)
+    if (factor) assemble(*factor, panel);
+  gttoc(assemble);
+
+  gttic(eliminate);
+  PANEL update;
+  for (Supernode& s : supernodes_) eliminate(s, panel, update);
+  gttoc(eliminate);
+}
+
+/* ************************************************************************* */
+template <class PANEL>
+void SupernodalCholesky::substitute(
+    PANEL Supernode::*panel,
+    Eigen::Matrix<typename PANEL::Scalar, Eigen::Dynamic, 1>& x) const {
+  Eigen::Matrix<typename PANEL::Scalar, Eigen::Dynamic, 1> y;
+
+  // Forward substitution L*y = b
+  for (const Supernode& s : supernodes_) {
+    const size_t w = s.width, r = s.height - w;
+    const PANEL& L = s.*panel;
+    auto xs = x.segment(offsets_[s.firstColumn], w);
+    L.topLeftCorner(w, w)
+        .template triangularView<Eigen::Lower>()
+        .solveInPlace(xs);
+    if (r == 0) continue;
+    y.noalias() = L.bottomRows(r) * xs;
+    for (size_t b = 0; b < s.rows.size(); ++b)
+      x.segment(offsets_[s.rows[b]], dims_[s.rows[b]]) -=
+          y.segment(s.rowOffsets[b] - w, dims_[s.rows[b]]);
+  }
+
+  // Back substitution L'*x = y
+  for (vector<Supernode>::const_reverse_iterator s = supernodes_.rbegin();
+       s != supernodes_.rend(); ++s) {
+    const size_t w = s->width, r = s->height - w;
+    const PANEL& L = (*s).*panel;
+    auto xs = x.segment(offsets_[s->firstColumn], w);
+    if (r > 0) {
+      y.resize(r);
+      for (size_t b = 0; b < s->rows.size(); ++b)
+        y.segment(s->rowOffsets[b] - w, dims_[s->rows[b]]) =
+            x.segment(offsets_[s->rows[b]], dims_[s->rows[b]]);
+      xs.noalias() -= L.bottomRows(r).transpose() * y;
+    }
+    L.topLeftCorner(w, w)
+        .template triangularView<Eigen::Lower>()
+        .transpose()
+        .solveInPlace(xs);
+  }
+}
+
+/* ************************************************************************* */
+Vector SupernodalCholesky::substitute(const Vector& b) const {
+  if (singlePrecision_) {
+    Eigen::VectorXf x = b.cast<float>();
+    substitute(&Supernode::singlePanel, x);
+    return x.cast<double>();
+  }
+  Vector x = b;
+  substitute(&Supernode::panel, x);
+  return x;
+}
+
+/* ************************************************************************* */
+VectorValues SupernodalCholesky::toValues(const Vector& x) const {
+  VectorValues result;
+  for (size_t p = 0; p < keys_.size(); ++p)
+    result.insert(keys_[p], x.segment(offsets_[p], dims_[p]));
+  return result;
+}
+
+/* ************************************************************************* */
+Vector SupernodalCholesky::multiplyHessian(const GaussianFactorGraph& graph,
+                                           const Vector& x) const {
+  const VectorValues values = toValues(x);
+  VectorValues product = VectorValues::Zero(values);
+  graph.multiplyHessianAdd(1.0, values, product);
+  Vector result(x.size());
+  for (size_t p = 0; p < keys_.size(); ++p)
+    result.segment(offsets_[p], dims_[p]) = product.at(keys_[p]);
+  return result;
+}
+
+/* ************************************************************************* */
+VectorValues SupernodalCholesky::solve() const {
+  gttic(SupernodalCholesky_solve);
+  return toValues(substitute(rhs_));
+}
+
+/* ************************************************************************* */
+VectorValues SupernodalCholesky::optimize(const GaussianFactorGraph& graph) {
+  factorize(graph);
+  refinementSteps_ = 0;
+  if (!singlePrecision_) return solve();
+
+  // Conjugate gradient, preconditioned with the single precision factor
+  gttic(SupernodalCholesky_refine);
+  Vector x = substitute(rhs_);
+  Vector r = rhs_ - multiplyHessian(graph, x);
+  Vector z = substitute(r), p = z;
+  double rz = r.dot(z);
+  const double target = refinementTolerance_ * rhs_.norm();
+  while (refinementSteps_ < maxRefinementSteps_ && r.norm() > target) {
+    const Vector q = multiplyHessian(graph, p);
+    const double alpha = rz / p.dot(q);
+    x += alpha * p;
+    r -= alpha * q;
+    ++refinementSteps_;
+    z = substitute(r);
+    const double previous = rz;
+    rz = r.dot(z);
+    p = z + (rz / previous) * p;
+  }
+  return toValues(x);
+}
+
+}  // namespace gtsam
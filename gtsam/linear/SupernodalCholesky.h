@@ -0,0 +1,176 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    SupernodalCholesky.h
+ * @brief   Sparse supernodal Cholesky factorization of the Hessian of a
+ * GaussianFactorGraph
+ * @date    Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/Matrix.h>
+
+#include <vector>
+
+namespace gtsam {
+
+// Forward declarations
+class GaussianFactor;
+class GaussianFactorGraph;
+
+/**
+ * Solves the normal equations \f$ A^T A x = A^T b \f$ of a GaussianFactorGraph
+ * with a sparse supernodal Cholesky factorization \f$ L L^T \f$ of the whole
+ * Hessian, the backend of NonlinearOptimizerParams::CHOLMOD.
+ *
+ * The constructor does the symbolic analysis once: it computes the elimination
+ * tree and the sparsity pattern of L in the given ordering, at the level of
+ * variables rather than scalars, and groups consecutive variables with the
+ * same pattern into supernodes.  Each supernode stores its columns of L as a
+ * single dense panel, so factorize() assembles the Hessian of every factor
+ * directly into the panels and then eliminates whole supernodes with dense
+ * Cholesky, triangular solve and rank-k update kernels.
+ *
+ * Unlike the multifrontal solver, no intermediate factors or conditionals are
+ * created.  Constrained noise models are not supported.
+ *
+ * A symbolic analysis can be re-used to factorize any graph on the same
+ * variables whose Hessian has the same, or a subset of the, sparsity pattern.
+ *
+ * With MIXED precision the panels are stored and factored in single
+ * precision, which halves the memory traffic of the dense kernels, and
+ * optimize() recovers double precision accuracy by refinement.  A Hessian
+ * that is too badly conditioned to be factored in single precision is
+ * factored in double precision instead.
+ */
+class GTSAM_EXPORT SupernodalCholesky {
+public:
+  /// Precision of the numerical factorization
+  enum Precision {
+    DOUBLE,  ///< Factor and solve in double precision
+    MIXED    ///< Factor in single precision, refine the solution in double
+  };
+
+  /// Symbolic analysis of \c graph in the elimination order \c ordering, which
+  /// has to contain exactly the keys of \c graph
+  SupernodalCholesky(const GaussianFactorGraph& graph, const Ordering& ordering,
+                     Precision precision = DOUBLE);
+
+  /**
+   * Assemble the Hessian and gradient of \c graph and factor it, throws
+   * IndeterminantLinearSystemException if it is not positive definite.
+   * Throws std::invalid_argument if \c graph has a non-zero block outside of
+   * the analyzed pattern.
+   */
+  void factorize(const GaussianFactorGraph& graph);
+
+  /// Solve with the last factorization, only to single precision accuracy
+  /// if it was done in single precision
+  VectorValues solve() const;
+
+  /**
+   * Factorize \c graph and solve.  After a single precision factorization,
+   * the solution is then refined with conjugate gradient iterations on
+   * \f$ A^T A x = A^T b \f$, with products computed from \c graph in double
+   * precision and preconditioned with the factorization, until the norm of
+   * the residual is below the refinement tolerance times the norm of
+   * \f$ A^T b \f$.  The first iteration is a step of classical iterative
+   * refinement, the later ones also converge when the Hessian is too badly
+   * conditioned for those steps to.
+   */
+  VectorValues optimize(const GaussianFactorGraph& graph);
+
+  /// Set the maximum number of refinement steps (default 10) and the relative
+  /// residual at which to stop (default 1e-10), for MIXED precision
+  void setRefinement(size_t maxSteps, double tolerance) {
+    maxRefinementSteps_ = maxSteps;
+    refinementTolerance_ = tolerance;
+  }
+
+  /// Number of refinement steps taken by the last call to optimize()
+  size_t refinementSteps() const { return refinementSteps_; }
+
+  /// Precision requested in the constructor
+  Precision precision() const { return precision_; }
+
+  /// Whether the last factorization was done in single precision
+  bool singlePrecision() const { return singlePrecision_; }
+
+  /// Number of supernodes
+  size_t numSupernodes() const { return supernodes_.size(); }
+
+  /// Number of stored entries of L, including the zeros inside supernodes
+  size_t nnz() const;
+
+private:
+  /// A set of consecutive columns (variables) of L with the same pattern
+  struct Supernode {
+    size_t firstColumn, endColumn;   ///< Range of variable positions
+    size_t width;                    ///< Number of scalar columns
+    std::vector<size_t> rows;        ///< Positions of the variables below
+    std::vector<size_t> rowOffsets;  ///< Offset of each of those in panel
+    size_t height;                   ///< Number of scalar rows of the panel
+    Matrix panel;  ///< Lower triangle of the diagonal block, rows below it
+    Eigen::MatrixXf singlePanel;  ///< The same, with MIXED precision
+  };
+
+  /// Row in the panel of supernode s of variable position p
+  size_t panelRow(const Supernode& s, size_t p) const;
+
+  /// Assemble \c graph into the given panels and factor them
+  template <class PANEL>
+  void factorize(const GaussianFactorGraph& graph, PANEL Supernode::*panel);
+
+  /// Add the contribution of one factor to the panels and rhs_
+  template <class PANEL>
+  void assemble(const GaussianFactor& factor, PANEL Supernode::*panel);
+
+  /// Eliminate supernode s and add its update to the later supernodes
+  template <class PANEL>
+  void eliminate(Supernode& s, PANEL Supernode::*panel, PANEL& update);
+
+  /// Solve L L' x = b in place, with the given panels
+  template <class PANEL>
+  void substitute(PANEL Supernode::*panel,
+                  Eigen::Matrix<typename PANEL::Scalar, Eigen::Dynamic, 1>& x) const;
+
+  /// Solve L L' x = b in double precision, whatever the precision of L
+  Vector substitute(const Vector& b) const;
+
+  /// The product A'A x of graph, in double precision
+  Vector multiplyHessian(const GaussianFactorGraph& graph,
+                         const Vector& x) const;
+
+  /// Split a vector in the layout of the positions by key
+  VectorValues toValues(const Vector& x) const;
+
+  std::vector<Key> keys_;       ///< Key of each position
+  std::vector<size_t> dims_;    ///< Dimension of each position
+  std::vector<size_t> offsets_; ///< Scalar offset of each position
+  std::vector<size_t> columnOffsets_;  ///< Offset within its supernode
+  std::vector<size_t> supernodeOf_;    ///< Supernode of each position
+  FastMap<Key, size_t> positions_;
+  std::vector<Supernode> supernodes_;
+  Vector rhs_;  ///< A^T b after factorize()
+
+  Precision precision_;
+  bool singlePrecision_;  ///< Whether the panels were factored in single
+  size_t maxRefinementSteps_;
+  double refinementTolerance_;
+  size_t refinementSteps_;
+};
+
+}  // namespace gtsam
@@ -22,6 +22,8 @@
 #include <boost/optional.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <mutex>
+
 namespace gtsam
 {
   namespace internal
@@ -47,6 +49,9 @@ namespace gtsam
       struct OptimizeClique
       {
         VectorValues collectedResult;
+#ifndef GTSAM_USE_TBB
+        std::mutex mutex; ///< Protects collectedResult
+#endif
 
         OptimizeData operator()(
           const boost::shared_ptr<CLIQUE>& clique,
@@ -98,6 +103,10 @@ namespace gtsam
             // Insert solution into a VectorValues
             DenseIndex vectorPosition = 0;
             for(GaussianConditional::const_iterator frontal = c.beginFrontals(); frontal != c.endFrontals(); ++frontal) {
+#ifndef GTSAM_USE_TBB
+              // Without TBB the result is a std::map, cliques may be solved by ThreadPool workers
+              std::lock_guard<std::mutex> lock(mutex);
+#endif
               VectorValues::const_iterator r =
                 collectedResult.emplace(*frontal, solution.segment(vectorPosition, c.getDim(frontal)));
               myData.cliqueResults.emplace(r->first, r);
@@ -132,7 +141,7 @@ namespace gtsam
 
       /* ************************************************************************* */
       template<class BAYESTREE>
-      VectorValues optimizeBayesTree(const BAYESTREE& bayesTree)
+      VectorValues optimizeBayesTree(const BAYESTREE& bayesTree, size_t numThreads = 1)
       {
         gttic(linear_optimizeBayesTree);
         //internal::OptimizeData rootData; // Will hold final solution
@@ -142,7 +151,8 @@ namespace gtsam
         OptimizeClique<typename BAYESTREE::Clique> preVisitor;
         treeTraversal::no_op postVisitor;
         TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
-        treeTraversal::DepthFirstForestParallel(bayesTree, rootData, preVisitor, postVisitor);
+        treeTraversal::DepthFirstForestParallel(bayesTree, rootData, preVisitor, postVisitor, 10,
+                                                numThreads);
         return preVisitor.collectedResult;
       }
     }
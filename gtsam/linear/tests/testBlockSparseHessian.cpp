@@ -0,0 +1,85 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testBlockSparseHessian.cpp
+ * @brief   Unit tests for BlockSparseHessian
+ */
+
+#include <gtsam/linear/BlockSparseHessian.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/IterativeSolver.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <tests/gridExample.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace gtsam;
+
+/* ************************************************************************* */
+// A 2x2 grid of variables of dimension 3, connected to variables of dimension
+// 6 and 4, to exercise both the fixed-size and the dynamic kernels, and a
+// HessianFactor
+static GaussianFactorGraph createGraph() {
+  GaussianFactorGraph graph = example::createGaussianGrid(2, 2, 3);
+  const SharedDiagonal model3 = noiseModel::Isotropic::Sigma(3, 0.5);
+  const Matrix36 A = (Matrix36() << 1, 2, 0, 0, 1, 0,
+                                    0, 1, 3, 1, 0, 2,
+                                    1, 0, 1, 0, 2, 1).finished();
+  const Matrix34 B = (Matrix34() << 1, 0, 2, 1,
+                                    0, 3, 0, 1,
+                                    2, 1, 1, 0).finished();
+  graph.add(1, I_3x3, 10, A, Vector3(-1.0, 0.0, 1.0), model3);
+  graph.add(2, -I_3x3, 10, A, 20, B, Vector3(0.5, 0.5, 0.5), model3);
+  graph.add(20, Matrix4::Identity(), Vector4(1, 2, 3, 4),
+            noiseModel::Unit::Create(4));
+  graph.add(10, Matrix66::Identity(), Vector6::Ones(),
+            noiseModel::Unit::Create(6));
+  graph.push_back(boost::make_shared<HessianFactor>(
+      JacobianFactor(3, I_3x3, 0, 0.5 * I_3x3, Vector3(1.0, 1.0, 1.0))));
+  return graph;
+}
+
+/* ************************************************************************* */
+TEST(BlockSparseHessian, matrix) {
+  const GaussianFactorGraph graph = createGraph();
+  const KeyInfo keyInfo(graph);
+  const BlockSparseHessian hessian(graph, keyInfo);
+
+  const std::pair<Matrix, Vector> expected = graph.hessian(keyInfo.ordering());
+  EXPECT(assert_equal(expected.first, hessian.matrix(), 1e-9));
+  EXPECT(assert_equal(expected.second, hessian.linearTerm(), 1e-9));
+  EXPECT_LONGS_EQUAL(24, hessian.nnzBlocks());
+}
+
+/* ************************************************************************* */
+TEST(BlockSparseHessian, multiply) {
+  const GaussianFactorGraph graph = createGraph();
+  const KeyInfo keyInfo(graph);
+  const Matrix H = graph.hessian(keyInfo.ordering()).first;
+  Vector x(keyInfo.numCols());
+  for (DenseIndex i = 0; i < x.size(); ++i) x(i) = 0.1 * i - 1.0;
+
+  for (size_t numThreads = 1; numThreads <= 3; ++numThreads) {
+    const BlockSparseHessian hessian(graph, keyInfo, numThreads);
+    Vector y;
+    hessian.multiply(x, y);
+    EXPECT(assert_equal(Vector(H * x), y, 1e-9));
+  }
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
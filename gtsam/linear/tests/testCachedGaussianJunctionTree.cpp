@@ -0,0 +1,116 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testCachedGaussianJunctionTree.cpp
+ * @brief   Unit tests for CachedGaussianJunctionTree
+ */
+
+#include <gtsam/linear/CachedGaussianJunctionTree.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <tests/gridExample.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace gtsam;
+
+/* ************************************************************************* */
+// A 3x3 grid of 2-dimensional variables, with values that depend on scale
+static GaussianFactorGraph createGrid(double scale) {
+  return example::createGaussianGrid(3, 3, 2, scale);
+}
+
+/* ************************************************************************* */
+TEST(CachedGaussianJunctionTree, reuse) {
+  CachedGaussianJunctionTree cache;
+  EXPECT(!cache.valid());
+
+  const GaussianFactorGraph graph1 = createGrid(1.0);
+  EXPECT(assert_equal(graph1.optimize(),
+                      cache.optimize(graph1, EliminatePreferCholesky)));
+  EXPECT_LONGS_EQUAL(1, cache.numBuilds());
+
+  // Same structure, different values: only numeric elimination
+  const GaussianFactorGraph graph2 = createGrid(2.0);
+  EXPECT(assert_equal(graph2.optimize(),
+                      cache.optimize(graph2, EliminatePreferCholesky)));
+  EXPECT(assert_equal(graph2.optimize(boost::none, EliminateQR),
+                      cache.optimize(graph2, EliminateQR)));
+  EXPECT_LONGS_EQUAL(1, cache.numBuilds());
+
+  // The same ordering as the cached one keeps the structure, another not
+  const Ordering ordering = cache.ordering();
+  cache.optimize(graph1, EliminatePreferCholesky, ordering);
+  EXPECT_LONGS_EQUAL(1, cache.numBuilds());
+  const Ordering natural = Ordering::Natural(graph1);
+  EXPECT(assert_equal(graph1.optimize(natural),
+                      cache.optimize(graph1, EliminatePreferCholesky, natural)));
+  EXPECT_LONGS_EQUAL(2, cache.numBuilds());
+
+  // A different structure is detected
+  GaussianFactorGraph graph3 = createGrid(1.5);
+  graph3.push_back(boost::make_shared<HessianFactor>(*graph3[1]));
+  EXPECT(assert_equal(graph3.optimize(natural),
+                      cache.optimize(graph3, EliminatePreferCholesky, natural)));
+  EXPECT_LONGS_EQUAL(3, cache.numBuilds());
+
+  // Explicit invalidation
+  cache.invalidate();
+  EXPECT(!cache.valid());
+  cache.optimize(graph3, EliminatePreferCholesky);
+  EXPECT_LONGS_EQUAL(4, cache.numBuilds());
+}
+
+/* ************************************************************************* */
+TEST(CachedGaussianJunctionTree, sharedFactors) {
+  // The same factor twice, and a null factor
+  GaussianFactorGraph graph = createGrid(1.0);
+  graph.push_back(graph[2]);
+  graph.push_back(GaussianFactor::shared_ptr());
+  CachedGaussianJunctionTree cache;
+  cache.optimize(graph, EliminatePreferCholesky);
+
+  GaussianFactorGraph other = createGrid(3.0);
+  other.push_back(boost::make_shared<JacobianFactor>(*createGrid(4.0)[2]));
+  other.push_back(GaussianFactor::shared_ptr());
+  EXPECT(assert_equal(other.optimize(),
+                      cache.optimize(other, EliminatePreferCholesky)));
+  EXPECT_LONGS_EQUAL(1, cache.numBuilds());
+}
+
+/* ************************************************************************* */
+TEST(CachedGaussianJunctionTree, workspace) {
+  CachedGaussianJunctionTree cache;
+  const GaussianFactorGraph graph = createGrid(1.0);
+  const Ordering ordering = Ordering::Colamd(graph);
+  EXPECT(assert_equal(*graph.eliminateMultifrontal(ordering),
+                      *cache.eliminate(graph, EliminateCholesky, ordering)));
+
+  // All cliques were eliminated in a single front, allocated for the largest
+  const EliminationWorkspace& workspace = cache.workspace();
+  EXPECT_LONGS_EQUAL(1, workspace.numThreads());
+  EXPECT_LONGS_EQUAL(1, workspace.numAllocations());
+  EXPECT(workspace.highWaterMark() > 0);
+  EXPECT_LONGS_EQUAL(workspace.highWaterMark(), workspace.bytes());
+
+  // Later eliminations do not allocate
+  cache.eliminate(createGrid(2.0), EliminateCholesky, ordering);
+  EXPECT_LONGS_EQUAL(1, workspace.numAllocations());
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
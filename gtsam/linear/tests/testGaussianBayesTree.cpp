@@ -124,6 +124,33 @@ TEST( GaussianBayesTree, optimizeMultiFrontal )
   EXPECT(assert_equal(expected,actual));
 }
 
+/* ************************************************************************* */
+TEST(GaussianBayesTree, optimizeMultithreaded)
+{
+  // A 30x30 grid of scalar variables, which has large cliques near the root
+  // and many independent subtrees below them
+  const size_t n = 30;
+  const SharedDiagonal model = noiseModel::Isotropic::Sigma(1, 0.5);
+  GaussianFactorGraph grid;
+  grid += JacobianFactor(0, I_1x1, Vector1(1.0), model);
+  for (Key i = 0; i < n; ++i) {
+    for (Key j = 0; j < n; ++j) {
+      const Key key = i * n + j;
+      if (j + 1 < n)
+        grid += JacobianFactor(key, I_1x1, key + 1, -I_1x1,
+                               Vector1(0.01 * key), model);
+      if (i + 1 < n)
+        grid += JacobianFactor(key, I_1x1, key + n, -I_1x1,
+                               Vector1(-0.02 * key), model);
+    }
+  }
+  GaussianBayesTree bayesTree = *grid.eliminateMultifrontal();
+
+  const VectorValues expected = bayesTree.optimize();
+  EXPECT(assert_equal(expected, bayesTree.optimize(4)));
+  EXPECT(assert_equal(expected, bayesTree.optimize(0)));
+}
+
 /* ************************************************************************* */
 TEST(GaussianBayesTree, complicatedMarginal) {
 
@@ -408,6 +408,35 @@ TEST(GaussianFactorGraph, DenseSolve) {
   EXPECT(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST(GaussianFactorGraph, eliminateSequentialMultithreaded) {
+  // A 20x20 grid of scalar variables, whose elimination tree has many
+  // independent subtrees
+  const size_t n = 20;
+  const SharedDiagonal model = noiseModel::Isotropic::Sigma(1, 0.5);
+  GaussianFactorGraph grid;
+  grid += JacobianFactor(0, I_1x1, Vector1(1.0), model);
+  for (Key i = 0; i < n; ++i) {
+    for (Key j = 0; j < n; ++j) {
+      const Key key = i * n + j;
+      if (j + 1 < n)
+        grid += JacobianFactor(key, -I_1x1, key + 1, I_1x1, Vector1(0.1), model);
+      if (i + 1 < n)
+        grid += JacobianFactor(key, -I_1x1, key + n, I_1x1, Vector1(0.2), model);
+    }
+  }
+
+  const Ordering ordering = Ordering::Colamd(grid);
+  const GaussianBayesNet expected = *grid.eliminateSequential(ordering);
+  for (size_t numThreads : {2, 4}) {
+    const GaussianBayesNet actual =
+        *grid.eliminateSequential(ordering, EliminatePreferCholesky, boost::none,
+                                  boost::none, numThreads);
+    EXPECT(assert_equal(expected, actual));
+    EXPECT(assert_equal(grid.optimize(ordering), actual.optimize()));
+  }
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
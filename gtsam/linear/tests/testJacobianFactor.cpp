@@ -183,6 +183,39 @@ TEST(JabobianFactor, Hessian_conversion3) {
   EXPECT(assert_equal(jf, JacobianFactor(hessian), 1e-9));
 }
 
+/* ************************************************************************* */
+namespace fixed_size {
+// Hessian of a factor on keys 3 and 1 with M rows and blocks of D columns,
+// formed by updateHessian in a graph, where the keys are sorted, and directly
+template <int M, int D>
+bool updateHessianMatches(const SharedDiagonal& model) {
+  const Matrix A3 = Matrix::Random(M, D), A1 = Matrix::Random(M, D);
+  const Vector b = Vector::Random(M);
+  const JacobianFactor factor(3, A3, 1, A1, b, model);
+  const HessianFactor actual(GaussianFactorGraph(list_of(factor)));
+  const HessianFactor expected(JacobianFactor(1, A1, 3, A3, b, model));
+
+  // Single block, as in priors
+  const JacobianFactor prior(1, A1, b, model);
+  return assert_equal(expected, actual, 1e-9) &&
+         assert_equal(HessianFactor(prior),
+                      HessianFactor(GaussianFactorGraph(list_of(prior))), 1e-9);
+}
+}
+
+/* ************************************************************************* */
+TEST(JacobianFactor, updateHessianFixedSize) {
+  using namespace fixed_size;
+  EXPECT((updateHessianMatches<2, 6>(noiseModel::Isotropic::Sigma(2, 0.5))));
+  EXPECT((updateHessianMatches<3, 6>(SharedDiagonal())));
+  EXPECT((updateHessianMatches<6, 6>(
+      noiseModel::Diagonal::Sigmas(Vector::LinSpaced(6, 0.1, 2.0)))));
+  EXPECT((updateHessianMatches<2, 9>(noiseModel::Unit::Create(2))));
+
+  // Other sizes use the generic update
+  EXPECT((updateHessianMatches<4, 3>(noiseModel::Isotropic::Sigma(4, 0.5))));
+}
+
 /* ************************************************************************* */
 namespace simple_graph {
 
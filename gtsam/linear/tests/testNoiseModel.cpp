@@ -447,6 +447,24 @@ TEST(NoiseModel, WhitenInPlace)
   EXPECT(assert_equal(expected, A));
 }
 
+/* ************************************************************************* */
+TEST(NoiseModel, whitenInPlaceBlock)
+{
+  // Whitening a segment in place agrees with whiten, and leaves the rest alone
+  const Vector v = (Vector(5) << 1.0, 2.0, -3.0, 4.0, 5.0).finished();
+  const vector<SharedNoiseModel> models = {
+      Diagonal::Sigmas(Vector3(0.1, 0.2, 0.5)), Isotropic::Sigma(3, 0.5),
+      Unit::Create(3), Constrained::MixedSigmas(Vector3(0.0, 0.1, 1.0))};
+  for (const SharedNoiseModel& model : models) {
+    Vector actual = v;
+    Eigen::Block<Vector> segment(actual, 1, 0, 3, 1);
+    model->whitenInPlace(segment);
+    Vector expected = v;
+    expected.segment<3>(1) = model->whiten(v.segment<3>(1));
+    EXPECT(assert_equal(expected, actual));
+  }
+}
+
 /* ************************************************************************* */
 
 /*
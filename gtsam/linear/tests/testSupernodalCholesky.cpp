@@ -0,0 +1,104 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testSupernodalCholesky.cpp
+ * @brief   Unit tests for SupernodalCholesky
+ */
+
+#include <gtsam/linear/SupernodalCholesky.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/linearExceptions.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <tests/gridExample.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <stdexcept>
+
+using namespace gtsam;
+
+/* ************************************************************************* */
+// A 4x4 grid of 3-dimensional variables, elimination creates fill-in
+static GaussianFactorGraph createGrid() {
+  return example::createGaussianGrid(4, 4, 3);
+}
+
+/* ************************************************************************* */
+TEST(SupernodalCholesky, grid) {
+  const GaussianFactorGraph graph = createGrid();
+  const Ordering ordering = Ordering::Colamd(graph);
+  SupernodalCholesky cholesky(graph, ordering);
+  EXPECT(cholesky.numSupernodes() < 16);
+  EXPECT(assert_equal(graph.optimize(ordering), cholesky.optimize(graph), 1e-9));
+
+  // Natural ordering, and a HessianFactor
+  GaussianFactorGraph mixed = graph;
+  mixed.push_back(boost::make_shared<HessianFactor>(*graph[1]));
+  SupernodalCholesky natural(mixed, Ordering::Natural(mixed));
+  EXPECT(assert_equal(mixed.optimize(), natural.optimize(mixed), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(SupernodalCholesky, reuse) {
+  const GaussianFactorGraph graph = createGrid();
+  SupernodalCholesky cholesky(graph, Ordering::Colamd(graph));
+
+  // Same pattern, different values
+  GaussianFactorGraph scaled;
+  for (const GaussianFactor::shared_ptr& factor : graph) {
+    JacobianFactor::shared_ptr jacobian =
+        boost::make_shared<JacobianFactor>(*factor);
+    jacobian->setModel(false, Vector3::Constant(2.0));
+    scaled.push_back(jacobian);
+  }
+  EXPECT(assert_equal(scaled.optimize(), cholesky.optimize(scaled), 1e-9));
+
+  // A new block outside of the pattern
+  scaled.add(0, I_3x3, 15, I_3x3, Vector3::Zero(),
+             noiseModel::Unit::Create(3));
+  CHECK_EXCEPTION(cholesky.factorize(scaled), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(SupernodalCholesky, mixedPrecision) {
+  const GaussianFactorGraph graph = createGrid();
+  const Ordering ordering = Ordering::Colamd(graph);
+  const VectorValues expected = graph.optimize(ordering);
+  SupernodalCholesky cholesky(graph, ordering, SupernodalCholesky::MIXED);
+
+  // Single precision only, then refined to double precision accuracy
+  cholesky.factorize(graph);
+  EXPECT(assert_equal(expected, cholesky.solve(), 1e-4));
+  EXPECT(assert_equal(expected, cholesky.optimize(graph), 1e-9));
+  EXPECT(cholesky.refinementSteps() > 0);
+
+  // No refinement
+  cholesky.setRefinement(0, 1e-10);
+  cholesky.optimize(graph);
+  EXPECT_LONGS_EQUAL(0, cholesky.refinementSteps());
+}
+
+/* ************************************************************************* */
+TEST(SupernodalCholesky, indeterminant) {
+  GaussianFactorGraph graph;
+  graph.add(0, I_3x3, 1, -I_3x3, Vector3::Zero(), noiseModel::Unit::Create(3));
+  SupernodalCholesky cholesky(graph, Ordering::Natural(graph));
+  CHECK_EXCEPTION(cholesky.factorize(graph), IndeterminantLinearSystemException);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
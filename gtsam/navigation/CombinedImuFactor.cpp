@@ -23,6 +23,7 @@
 
 /* External or standard includes */
 #include <ostream>
+#include <stdexcept>
 
 namespace gtsam {
 
@@ -82,14 +83,6 @@ void PreintegratedCombinedMeasurements::integrateMeasurement(
   Matrix3 theta_H_biasOmega = -C.topRows<3>();
   Matrix3 vel_H_biasAcc = -B.bottomRows<3>();
 
-  // overall Jacobian wrt preintegrated measurements (df/dx)
-  Eigen::Matrix<double, 15, 15> F;
-  F.setZero();
-  F.block<9, 9>(0, 0) = A;
-  F.block<3, 3>(0, 12) = theta_H_biasOmega;
-  F.block<3, 3>(6, 9) = vel_H_biasAcc;
-  F.block<6, 6>(9, 9) = I_6x6;
-
   // propagate uncertainty
   // TODO(frank): use noiseModel routine so we can have arbitrary noise models.
   const Matrix3& aCov = p().accelerometerCovariance;
@@ -118,7 +111,52 @@ void PreintegratedCombinedMeasurements::integrateMeasurement(
       * theta_H_biasOmega.transpose();
   D_v_R(&G_measCov_Gt) = temp;
   D_R_v(&G_measCov_Gt) = temp.transpose();
-  preintMeasCov_ = F * preintMeasCov_ * F.transpose() + G_measCov_Gt;
+
+  // The overall Jacobian wrpt preintegrated measurements and biases is
+  // F = [A E; 0 I], where E only has the blocks theta_H_biasOmega and
+  // vel_H_biasAcc. With P = [P11 P12; P12' P22], F * P * F' is
+  // [A*P11*A' + newP12*E' + E*(A*P12)', newP12; newP12', P22], where
+  // newP12 = A*P12 + E*P22, computed block by block instead of 15x15 products.
+  const Eigen::Matrix<double, 9, 6> AP12 =
+      UpdateJacobianTimes(A, preintMeasCov_.topRightCorner<9, 6>());
+  Eigen::Matrix<double, 9, 6> newP12 = AP12;
+  newP12.topRows<3>().noalias() +=
+      theta_H_biasOmega * preintMeasCov_.block<3, 6>(12, 9);
+  newP12.bottomRows<3>().noalias() +=
+      vel_H_biasAcc * preintMeasCov_.block<3, 6>(9, 9);
+
+  const Matrix9 AP11 =
+      UpdateJacobianTimes(A, preintMeasCov_.topLeftCorner<9, 9>());
+  Matrix9 newP11 = UpdateJacobianTimes(A, AP11.transpose());
+  newP11.leftCols<3>().noalias() +=
+      newP12.rightCols<3>() * theta_H_biasOmega.transpose();
+  newP11.rightCols<3>().noalias() +=
+      newP12.leftCols<3>() * vel_H_biasAcc.transpose();
+  newP11.topRows<3>().noalias() +=
+      theta_H_biasOmega * AP12.rightCols<3>().transpose();
+  newP11.bottomRows<3>().noalias() +=
+      vel_H_biasAcc * AP12.leftCols<3>().transpose();
+
+  preintMeasCov_.topLeftCorner<9, 9>() = newP11;
+  preintMeasCov_.topRightCorner<9, 6>() = newP12;
+  preintMeasCov_.bottomLeftCorner<6, 9>() = newP12.transpose();
+  preintMeasCov_ += G_measCov_Gt;
+}
+
+//------------------------------------------------------------------------------
+void PreintegratedCombinedMeasurements::integrateMeasurements(
+    const Eigen::Matrix3Xd& measuredAccs, const Eigen::Matrix3Xd& measuredOmegas,
+    const Vector& dts) {
+  if (measuredAccs.cols() != dts.size() || measuredOmegas.cols() != dts.size()) {
+    throw std::invalid_argument(
+        "PreintegratedCombinedMeasurements::integrateMeasurements: "
+        "need one acceleration and angular velocity per time interval");
+  }
+  // A qualified call is bound statically, no virtual dispatch per sample
+  for (Eigen::Index j = 0; j < dts.size(); j++) {
+    PreintegratedCombinedMeasurements::integrateMeasurement(
+        measuredAccs.col(j), measuredOmegas.col(j), dts(j));
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -152,6 +190,7 @@ CombinedImuFactor::CombinedImuFactor(Key pose_i, Key vel_i, Key pose_j,
     const PreintegratedCombinedMeasurements& pim) :
     Base(noiseModel::Gaussian::Covariance(pim.preintMeasCov_), pose_i, vel_i,
         pose_j, vel_j, bias_i, bias_j), _PIM_(pim) {
+  cacheSqrtInformation();
 }
 
 //------------------------------------------------------------------------------
@@ -242,6 +281,86 @@ Vector CombinedImuFactor::evaluateError(const Pose3& pose_i,
   return r;
 }
 
+//------------------------------------------------------------------------------
+void CombinedImuFactor::cacheSqrtInformation() {
+  if (noiseModel_)
+    sqrtInformation_ =
+        boost::static_pointer_cast<noiseModel::Gaussian>(noiseModel_)->R();
+  else
+    sqrtInformation_.setIdentity();
+}
+
+//------------------------------------------------------------------------------
+bool CombinedImuFactor::refresh(const Values& x) {
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+  // Re-preintegrate once the bias estimate is too far from biasHat
+  if (needsRefresh(x)) {
+    _PIM_.repreintegrate(x.at<imuBias::ConstantBias>(key5()));
+    return true;
+  }
+#endif
+  return false;
+}
+
+//------------------------------------------------------------------------------
+bool CombinedImuFactor::needsRefresh(const Values& x) const {
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+  return _PIM_.needsRepreintegration(x.at<imuBias::ConstantBias>(key5()));
+#else
+  return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+boost::shared_ptr<GaussianFactor> CombinedImuFactor::linearize(
+    const Values& x) const {
+  if (!noiseModel_ || noiseModel_->isConstrained())
+    return Base::linearize(x);
+
+  const imuBias::ConstantBias& bias_i = x.at<imuBias::ConstantBias>(key5());
+  const imuBias::ConstantBias& bias_j = x.at<imuBias::ConstantBias>(key6());
+
+  // error wrt bias evolution model (random walk)
+  Matrix6 Hbias_i, Hbias_j;
+  const Vector6 fbias = traits<imuBias::ConstantBias>::Between(bias_j, bias_i,
+      Hbias_j, Hbias_i).vector();
+
+  // error wrt preintegrated measurements
+  Matrix96 D_r_pose_i, D_r_pose_j, D_r_bias_i;
+  Matrix93 D_r_vel_i, D_r_vel_j;
+  const Vector9 r_Rpv = _PIM_.computeErrorAndJacobians(x.at<Pose3>(key1()),
+      x.at<Vector3>(key2()), x.at<Pose3>(key3()), x.at<Vector3>(key4()),
+      bias_i, D_r_pose_i, D_r_vel_i, D_r_pose_j, D_r_vel_j, D_r_bias_i);
+
+  // Whiten with the upper-triangular square-root information R, in place.
+  // Only the bias blocks have Jacobians in the last 6 rows, so the others
+  // only need the top left 9x9 block of R.
+  static const DenseIndex dims[] = {6, 3, 6, 3, 6, 6};
+  boost::shared_ptr<GaussianFactor> factor = recycledLinearization();
+  VerticalBlockMatrix& Ab = writableJacobian(factor, dims, 15).matrixObject();
+  const auto R11 =
+      sqrtInformation_.topLeftCorner<9, 9>().triangularView<Eigen::Upper>();
+  const auto R12 = sqrtInformation_.topRightCorner<9, 6>();
+  const auto R22 =
+      sqrtInformation_.bottomRightCorner<6, 6>().triangularView<Eigen::Upper>();
+  Ab(0).topRows<9>().noalias() = R11 * D_r_pose_i;
+  Ab(1).topRows<9>().noalias() = R11 * D_r_vel_i;
+  Ab(2).topRows<9>().noalias() = R11 * D_r_pose_j;
+  Ab(3).topRows<9>().noalias() = R11 * D_r_vel_j;
+  for (size_t j = 0; j < 4; ++j)
+    Ab(j).bottomRows<6>().setZero();
+  Ab(4).topRows<9>().noalias() = R11 * D_r_bias_i;
+  Ab(4).topRows<9>().noalias() += R12 * Hbias_i;
+  Ab(4).bottomRows<6>().noalias() = R22 * Hbias_i;
+  Ab(5).topRows<9>().noalias() = R12 * Hbias_j;
+  Ab(5).bottomRows<6>().noalias() = R22 * Hbias_j;
+  auto b = Ab(6).col(0);
+  b.head<9>().noalias() = R11 * (-r_Rpv);
+  b.head<9>().noalias() -= R12 * fbias;
+  b.tail<6>().noalias() = R22 * (-fbias);
+  return factor;
+}
+
 //------------------------------------------------------------------------------
 #ifdef GTSAM_ALLOW_DEPRECATED_SINCE_V4
 CombinedImuFactor::CombinedImuFactor(
@@ -252,6 +371,7 @@ CombinedImuFactor::CombinedImuFactor(
 : Base(noiseModel::Gaussian::Covariance(pim.preintMeasCov_), pose_i, vel_i,
     pose_j, vel_j, bias_i, bias_j),
 _PIM_(pim) {
+  cacheSqrtInformation();
   using P = CombinedPreintegratedMeasurements::Params;
   auto p = boost::allocate_shared<P>(Eigen::aligned_allocator<P>(), pim.p());
   p->n_gravity = n_gravity;
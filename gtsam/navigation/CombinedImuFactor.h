@@ -177,6 +177,17 @@ public:
   void integrateMeasurement(const Vector3& measuredAcc,
       const Vector3& measuredOmega, const double dt) override;
 
+  /**
+   * Add a batch of IMU measurements, stored in the columns of contiguous
+   * arrays, without a virtual call per measurement.
+   * @param measuredAccs Measured accelerations, one per column
+   * @param measuredOmegas Measured angular velocities, one per column
+   * @param dts Time intervals, one per measurement
+   */
+  void integrateMeasurements(const Eigen::Matrix3Xd& measuredAccs,
+                             const Eigen::Matrix3Xd& measuredOmegas,
+                             const Vector& dts);
+
   /// @}
 
 #ifdef GTSAM_ALLOW_DEPRECATED_SINCE_V4
@@ -234,8 +245,12 @@ private:
 
   PreintegratedCombinedMeasurements _PIM_;
 
+  /// Square-root information of the noise model, cached for linearize
+  Eigen::Matrix<double, 15, 15> sqrtInformation_;
+
   /** Default constructor - only use for serialization */
-  CombinedImuFactor() {}
+  CombinedImuFactor()
+      : sqrtInformation_(Eigen::Matrix<double, 15, 15>::Identity()) {}
 
 public:
 
@@ -291,6 +306,25 @@ public:
       boost::optional<Matrix&> H4 = boost::none, boost::optional<Matrix&> H5 =
           boost::none, boost::optional<Matrix&> H6 = boost::none) const;
 
+  /**
+   * Linearize with fixed-size Jacobians, whitened with the cached square-root
+   * information straight into the blocks of the JacobianFactor, re-using the
+   * one linearizeInto offers if it has the right structure
+   */
+  boost::shared_ptr<GaussianFactor> linearize(const Values& x) const override;
+
+  /**
+   * If the preintegrated measurements store their samples (see
+   * TangentPreintegration::storeSamples), re-preintegrate them with the bias
+   * estimate in \c x once it is beyond their threshold from biasHat.
+   * Optimizers call this between iterations, linearize() never does.
+   */
+  bool refresh(const Values& x) override;
+
+  /// Whether the bias estimate in \c x is beyond the re-preintegration
+  /// threshold of samples stored by the preintegrated measurements
+  bool needsRefresh(const Values& x) const override;
+
 #ifdef GTSAM_ALLOW_DEPRECATED_SINCE_V4
   /// @deprecated typename
   typedef gtsam::PreintegratedCombinedMeasurements CombinedPreintegratedMeasurements;
@@ -312,6 +346,9 @@ public:
 
 private:
 
+  /// Set sqrtInformation_ from the Gaussian noise model, identity without one
+  void cacheSqrtInformation();
+
   /** Serialization function */
   friend class boost::serialization::access;
   template<class ARCHIVE>
@@ -319,6 +356,8 @@ private:
     ar & boost::serialization::make_nvp("NoiseModelFactor6",
          boost::serialization::base_object<Base>(*this));
     ar & BOOST_SERIALIZATION_NVP(_PIM_);
+    if (ARCHIVE::is_loading::value)
+      cacheSqrtInformation();
   }
 
 public:
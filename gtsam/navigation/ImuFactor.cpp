@@ -23,6 +23,7 @@
 
 /* External or standard includes */
 #include <ostream>
+#include <stdexcept>
 
 namespace gtsam {
 
@@ -73,7 +74,9 @@ void PreintegratedImuMeasurements::integrateMeasurement(
   const Matrix3& iCov = p().integrationCovariance;
 
   // (1/dt) allows to pass from continuous time noise to discrete time noise
-  preintMeasCov_ = A * preintMeasCov_ * A.transpose();
+  // NOTE: A * P * A' == A * (A * P)' as P is symmetric
+  const Matrix9 AP = UpdateJacobianTimes(A, preintMeasCov_);
+  preintMeasCov_ = UpdateJacobianTimes(A, AP.transpose());
   preintMeasCov_.noalias() += B * (aCov / dt) * B.transpose();
   preintMeasCov_.noalias() += C * (wCov / dt) * C.transpose();
 
@@ -83,16 +86,17 @@ void PreintegratedImuMeasurements::integrateMeasurement(
 
 //------------------------------------------------------------------------------
 void PreintegratedImuMeasurements::integrateMeasurements(
-    const Matrix& measuredAccs, const Matrix& measuredOmegas,
-    const Matrix& dts) {
-  assert(
-      measuredAccs.rows() == 3 && measuredOmegas.rows() == 3 && dts.rows() == 1);
-  assert(dts.cols() >= 1);
-  assert(measuredAccs.cols() == dts.cols());
-  assert(measuredOmegas.cols() == dts.cols());
-  size_t n = static_cast<size_t>(dts.cols());
-  for (size_t j = 0; j < n; j++) {
-    integrateMeasurement(measuredAccs.col(j), measuredOmegas.col(j), dts(0, j));
+    const Eigen::Matrix3Xd& measuredAccs, const Eigen::Matrix3Xd& measuredOmegas,
+    const Vector& dts) {
+  if (measuredAccs.cols() != dts.size() || measuredOmegas.cols() != dts.size()) {
+    throw std::invalid_argument(
+        "PreintegratedImuMeasurements::integrateMeasurements: "
+        "need one acceleration and angular velocity per time interval");
+  }
+  // A qualified call is bound statically, no virtual dispatch per sample
+  for (Eigen::Index j = 0; j < dts.size(); j++) {
+    PreintegratedImuMeasurements::integrateMeasurement(
+        measuredAccs.col(j), measuredOmegas.col(j), dts(j));
   }
 }
 
@@ -139,6 +143,7 @@ ImuFactor::ImuFactor(Key pose_i, Key vel_i, Key pose_j, Key vel_j, Key bias,
     const PreintegratedImuMeasurements& pim) :
     Base(noiseModel::Gaussian::Covariance(pim.preintMeasCov_), pose_i, vel_i,
         pose_j, vel_j, bias), _PIM_(pim) {
+  cacheSqrtInformation();
 }
 
 //------------------------------------------------------------------------------
@@ -181,6 +186,63 @@ Vector ImuFactor::evaluateError(const Pose3& pose_i, const Vector3& vel_i,
       H1, H2, H3, H4, H5);
 }
 
+//------------------------------------------------------------------------------
+void ImuFactor::cacheSqrtInformation() {
+  if (noiseModel_)
+    sqrtInformation_ =
+        boost::static_pointer_cast<noiseModel::Gaussian>(noiseModel_)->R();
+  else
+    sqrtInformation_.setIdentity();
+}
+
+//------------------------------------------------------------------------------
+bool ImuFactor::refresh(const Values& x) {
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+  // Re-preintegrate once the bias estimate is too far from biasHat
+  if (needsRefresh(x)) {
+    _PIM_.repreintegrate(x.at<imuBias::ConstantBias>(key5()));
+    return true;
+  }
+#endif
+  return false;
+}
+
+//------------------------------------------------------------------------------
+bool ImuFactor::needsRefresh(const Values& x) const {
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+  return _PIM_.needsRepreintegration(x.at<imuBias::ConstantBias>(key5()));
+#else
+  return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+boost::shared_ptr<GaussianFactor> ImuFactor::linearize(
+    const Values& x) const {
+  if (!noiseModel_ || noiseModel_->isConstrained())
+    return Base::linearize(x);
+
+  Matrix96 D_r_pose_i, D_r_pose_j, D_r_bias_i;
+  Matrix93 D_r_vel_i, D_r_vel_j;
+  const Vector9 r = _PIM_.computeErrorAndJacobians(x.at<Pose3>(key1()),
+      x.at<Vector3>(key2()), x.at<Pose3>(key3()), x.at<Vector3>(key4()),
+      x.at<imuBias::ConstantBias>(key5()), D_r_pose_i, D_r_vel_i, D_r_pose_j,
+      D_r_vel_j, D_r_bias_i);
+
+  // Whiten with the upper-triangular square-root information, in place
+  static const DenseIndex dims[] = {6, 3, 6, 3, 6};
+  boost::shared_ptr<GaussianFactor> factor = recycledLinearization();
+  VerticalBlockMatrix& Ab = writableJacobian(factor, dims, 9).matrixObject();
+  const auto R = sqrtInformation_.triangularView<Eigen::Upper>();
+  Ab(0).noalias() = R * D_r_pose_i;
+  Ab(1).noalias() = R * D_r_vel_i;
+  Ab(2).noalias() = R * D_r_pose_j;
+  Ab(3).noalias() = R * D_r_vel_j;
+  Ab(4).noalias() = R * D_r_bias_i;
+  Ab(5).col(0).noalias() = R * (-r);
+  return factor;
+}
+
 //------------------------------------------------------------------------------
 #ifdef GTSAM_TANGENT_PREINTEGRATION
 PreintegratedImuMeasurements ImuFactor::Merge(
@@ -235,6 +297,7 @@ ImuFactor::ImuFactor(Key pose_i, Key vel_i, Key pose_j, Key vel_j, Key bias,
     const bool use2ndOrderCoriolis) :
 Base(noiseModel::Gaussian::Covariance(pim.preintMeasCov_), pose_i, vel_i,
     pose_j, vel_j, bias), _PIM_(pim) {
+  cacheSqrtInformation();
   boost::shared_ptr<PreintegrationParams> p = boost::make_shared<
   PreintegrationParams>(pim.p());
   p->n_gravity = n_gravity;
@@ -128,9 +128,29 @@ public:
   void integrateMeasurement(const Vector3& measuredAcc,
       const Vector3& measuredOmega, const double dt) override;
 
-  /// Add multiple measurements, in matrix columns
-  void integrateMeasurements(const Matrix& measuredAccs, const Matrix& measuredOmegas,
-                             const Matrix& dts);
+  /**
+   * Add a batch of IMU measurements, stored in the columns of contiguous
+   * arrays, without a virtual call per measurement.
+   * @param measuredAccs Measured accelerations, one per column
+   * @param measuredOmegas Measured angular velocities, one per column
+   * @param dts Time intervals, one per measurement
+   */
+  void integrateMeasurements(const Eigen::Matrix3Xd& measuredAccs,
+                             const Eigen::Matrix3Xd& measuredOmegas,
+                             const Vector& dts);
+
+  /// Add multiple measurements, in matrix columns, with the time intervals in
+  /// a row or a column. A template, so that fixed-size arguments do not make
+  /// the call ambiguous with the overload above.
+  template <class ACCS, class OMEGAS, class DTS>
+  void integrateMeasurements(const Eigen::MatrixBase<ACCS>& measuredAccs,
+                             const Eigen::MatrixBase<OMEGAS>& measuredOmegas,
+                             const Eigen::MatrixBase<DTS>& dts) {
+    const Matrix rowOrColumn = dts;
+    integrateMeasurements(
+        Eigen::Matrix3Xd(measuredAccs), Eigen::Matrix3Xd(measuredOmegas),
+        Vector(Eigen::Map<const Vector>(rowOrColumn.data(), rowOrColumn.size())));
+  }
 
   /// Return pre-integrated measurement covariance
   Matrix preintMeasCov() const { return preintMeasCov_; }
@@ -190,6 +210,9 @@ private:
 
   PreintegratedImuMeasurements _PIM_;
 
+  /// Square-root information of the noise model, cached for linearize
+  Matrix9 sqrtInformation_;
+
 public:
 
   /** Shorthand for a smart pointer to a factor */
@@ -200,7 +223,7 @@ public:
 #endif
 
   /** Default constructor - only use for serialization */
-  ImuFactor() {}
+  ImuFactor() : sqrtInformation_(Matrix9::Identity()) {}
 
   /**
    * Constructor
@@ -243,6 +266,25 @@ public:
       boost::optional<Matrix&> H3 = boost::none, boost::optional<Matrix&> H4 =
           boost::none, boost::optional<Matrix&> H5 = boost::none) const;
 
+  /**
+   * Linearize with fixed-size Jacobians, whitened with the cached square-root
+   * information straight into the blocks of the JacobianFactor, re-using the
+   * one linearizeInto offers if it has the right structure
+   */
+  boost::shared_ptr<GaussianFactor> linearize(const Values& x) const override;
+
+  /**
+   * If the preintegrated measurements store their samples (see
+   * TangentPreintegration::storeSamples), re-preintegrate them with the bias
+   * estimate in \c x once it is beyond their threshold from biasHat.
+   * Optimizers call this between iterations, linearize() never does.
+   */
+  bool refresh(const Values& x) override;
+
+  /// Whether the bias estimate in \c x is beyond the re-preintegration
+  /// threshold of samples stored by the preintegrated measurements
+  bool needsRefresh(const Values& x) const override;
+
 #ifdef GTSAM_TANGENT_PREINTEGRATION
   /// Merge two pre-integrated measurement classes
   static PreintegratedImuMeasurements Merge(
@@ -274,6 +316,9 @@ public:
 
 private:
 
+  /// Set sqrtInformation_ from the Gaussian noise model, identity without one
+  void cacheSqrtInformation();
+
   /** Serialization function */
   friend class boost::serialization::access;
   template<class ARCHIVE>
@@ -281,6 +326,8 @@ private:
     ar & boost::serialization::make_nvp("NoiseModelFactor5",
          boost::serialization::base_object<Base>(*this));
     ar & BOOST_SERIALIZATION_NVP(_PIM_);
+    if (ARCHIVE::is_loading::value)
+      cacheSqrtInformation();
   }
 };
 // class ImuFactor
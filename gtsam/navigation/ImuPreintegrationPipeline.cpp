@@ -0,0 +1,290 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ImuPreintegrationPipeline.cpp
+ * @brief   Streaming preintegration of several IMUs between keyframes, on a
+ * background thread and a thread pool
+ * @date    Oct 16, 2026
+ */
+
+#include <gtsam/navigation/ImuPreintegrationPipeline.h>
+#include <gtsam/base/ThreadPool.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+template <class PIM>
+ImuPreintegrationPipeline<PIM>::ImuPreintegrationPipeline(
+    const std::vector<boost::shared_ptr<Params> >& params, size_t numThreads,
+    size_t capacity)
+    : numThreads_(numThreads),
+      numIntegrated_(0),
+      biasHats_(params.size()),
+      numKeyframesSeen_(0),
+      flushRequested_(0),
+      flushServed_(0),
+      stop_(false) {
+  size_t size = 2;
+  while (size < capacity) size *= 2;
+  mask_ = size - 1;
+  for (const boost::shared_ptr<Params>& p : params) {
+    std::unique_ptr<Sensor> sensor(new Sensor);
+    sensor->params = p;
+    sensor->ring.resize(size);
+    sensor->head = 0;
+    sensor->tail = 0;
+    sensor->lastPushed = -std::numeric_limits<double>::infinity();
+    sensor->nextKeyframe = 0;
+    sensors_.push_back(std::move(sensor));
+  }
+  worker_ = std::thread(&ImuPreintegrationPipeline::run, this);
+}
+
+/* ************************************************************************* */
+template <class PIM>
+ImuPreintegrationPipeline<PIM>::~ImuPreintegrationPipeline() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wakeUp_.notify_one();
+  worker_.join();
+}
+
+/* ************************************************************************* */
+template <class PIM>
+void ImuPreintegrationPipeline<PIM>::push(size_t sensor, double t,
+                                          const Vector3& measuredAcc,
+                                          const Vector3& measuredOmega) {
+  Sensor& s = *sensors_.at(sensor);
+  if (!(t > s.lastPushed))
+    throw std::invalid_argument(
+        "ImuPreintegrationPipeline::push: time stamps must increase");
+  s.lastPushed = t;
+
+  // Wait for the background thread if the ring buffer is full
+  const size_t tail = s.tail.load(std::memory_order_relaxed);
+  while (tail - s.head.load(std::memory_order_acquire) > mask_) {
+    wakeUp_.notify_one();
+    std::this_thread::yield();
+  }
+  Sample& sample = s.ring[tail & mask_];
+  sample.t = t;
+  sample.acc = measuredAcc;
+  sample.omega = measuredOmega;
+  s.tail.store(tail + 1);
+
+  // If the background thread had drained everything, it may be waiting.  Both
+  // this store and its store of head are sequentially consistent, so either
+  // it sees the new sample before it waits, or we see that it caught up and
+  // wake it.  Taking the lock makes sure it is waiting, not just about to.
+  if (s.head.load() == tail) {
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    wakeUp_.notify_one();
+  }
+}
+
+/* ************************************************************************* */
+template <class PIM>
+void ImuPreintegrationPipeline<PIM>::setBiasHat(size_t sensor,
+                                                const Bias& biasHat) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  biasHats_.at(sensor) = biasHat;
+}
+
+/* ************************************************************************* */
+template <class PIM>
+void ImuPreintegrationPipeline<PIM>::addKeyframe(double t) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!keyframes_.empty() && !(t > keyframes_.back()))
+    throw std::invalid_argument(
+        "ImuPreintegrationPipeline::addKeyframe: keyframe times must increase");
+  keyframes_.push_back(t);
+  keyframeBiasHats_.push_back(biasHats_);
+  wakeUp_.notify_one();
+}
+
+/* ************************************************************************* */
+template <class PIM>
+bool ImuPreintegrationPipeline<PIM>::tryPop(Interval& interval) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (ready_.empty()) return false;
+  interval = ready_.front();
+  ready_.pop_front();
+  return true;
+}
+
+/* ************************************************************************* */
+template <class PIM>
+void ImuPreintegrationPipeline<PIM>::flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  const size_t ticket = ++flushRequested_;
+  wakeUp_.notify_one();
+  flushed_.wait(lock, [&] { return flushServed_ >= ticket; });
+  if (error_) {
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+/* ************************************************************************* */
+template <class PIM>
+bool ImuPreintegrationPipeline<PIM>::pending() const {
+  for (const std::unique_ptr<Sensor>& sensor : sensors_)
+    if (sensor->tail.load() != sensor->head.load()) return true;
+  return false;
+}
+
+/* ************************************************************************* */
+template <class PIM>
+void ImuPreintegrationPipeline<PIM>::run() {
+  while (true) {
+    size_t ticket;
+    {
+      // Sleep until there are new samples or keyframes, see push()
+      std::unique_lock<std::mutex> lock(mutex_);
+      wakeUp_.wait(lock, [this] {
+        return stop_ || flushRequested_ > flushServed_ ||
+               keyframes_.size() > numKeyframesSeen_ || pending();
+      });
+      if (stop_) return;
+      ticket = flushRequested_;
+      numKeyframesSeen_ = keyframes_.size();
+    }
+
+    // Repeat while a full ring buffer may hold back more samples
+    try {
+      while (step()) {
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) error_ = std::current_exception();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      flushServed_ = ticket;
+    }
+    flushed_.notify_all();
+  }
+}
+
+/* ************************************************************************* */
+template <class PIM>
+bool ImuPreintegrationPipeline<PIM>::step() {
+  // Drain the ring buffers
+  bool drained = false;
+  for (const std::unique_ptr<Sensor>& sensor : sensors_) {
+    Sensor& s = *sensor;
+    const size_t head = s.head.load(std::memory_order_relaxed);
+    const size_t tail = s.tail.load(std::memory_order_acquire);
+    for (size_t i = head; i != tail; ++i) s.samples.push_back(s.ring[i & mask_]);
+    s.head.store(tail);  // sequentially consistent, see push()
+    drained = drained || tail != head;
+  }
+
+  // Collect the intervals for which every sample is there
+  std::vector<Job> jobs;
+  std::vector<size_t> nextKeyframes(sensors_.size());
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t j = 0; j < sensors_.size(); ++j) {
+      const Sensor& s = *sensors_[j];
+      size_t k = s.nextKeyframe;
+      for (; k + 1 < keyframes_.size(); ++k) {
+        if (s.samples.empty() || s.samples.back().t < keyframes_[k + 1]) break;
+        jobs.push_back(Job{j, k, keyframes_[k], keyframes_[k + 1],
+                           keyframeBiasHats_[k][j]});
+      }
+      nextKeyframes[j] = k;
+    }
+  }
+
+  // Preintegrate them concurrently, each into its own slot.  If this throws,
+  // nothing has been consumed yet.
+  std::vector<Interval, Eigen::aligned_allocator<Interval> > intervals(
+      jobs.size());
+  if (!jobs.empty())
+    ThreadPool::Shared(numThreads_).parallelFor(
+        jobs.size(), [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i) integrate(jobs[i], intervals[i]);
+        });
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  ready_.insert(ready_.end(), intervals.begin(), intervals.end());
+  for (size_t j = 0; j < sensors_.size(); ++j) {
+    // Only now are the intervals up to the next keyframe handed out
+    Sensor& s = *sensors_[j];
+    s.nextKeyframe = nextKeyframes[j];
+
+    // Drop the samples that end before the next interval, also when no
+    // interval was ready, so they do not pile up between keyframes
+    if (s.nextKeyframe >= keyframes_.size()) continue;
+    const double start = keyframes_[s.nextKeyframe];
+    size_t first = 0;
+    while (first + 1 < s.samples.size() && s.samples[first + 1].t <= start)
+      ++first;
+    s.samples.erase(s.samples.begin(), s.samples.begin() + first);
+  }
+  return drained || !jobs.empty();
+}
+
+/* ************************************************************************* */
+template <class PIM>
+void ImuPreintegrationPipeline<PIM>::integrate(const Job& job,
+                                               Interval& interval) {
+  const Sensor& s = *sensors_[job.sensor];
+  interval.sensor = job.sensor;
+  interval.keyframe = job.keyframe;
+  interval.start = job.start;
+  interval.end = job.end;
+  interval.pim = PIM(s.params, job.biasHat);
+
+  // Sample i holds from its time stamp until the next one, clip that span to
+  // the interval.  The last sample is at or after the end of the interval.
+  const std::vector<Sample>& samples = s.samples;
+  size_t first = 0;
+  while (first + 1 < samples.size() && samples[first + 1].t <= job.start)
+    ++first;
+  size_t last = first;
+  while (samples[last].t < job.end) ++last;
+
+  Eigen::Matrix3Xd accs(3, last - first), omegas(3, last - first);
+  Vector dts(last - first);
+  size_t n = 0;
+  for (size_t i = first; i < last; ++i) {
+    const double dt = std::min(samples[i + 1].t, job.end) -
+                      std::max(samples[i].t, job.start);
+    if (dt <= 0) continue;
+    accs.col(n) = samples[i].acc;
+    omegas.col(n) = samples[i].omega;
+    dts(n) = dt;
+    ++n;
+  }
+  if (n == 0) return;
+  accs.conservativeResize(3, n);
+  omegas.conservativeResize(3, n);
+  dts.conservativeResize(n);
+  interval.pim.integrateMeasurements(accs, omegas, dts);
+  numIntegrated_ += n;
+}
+
+/* ************************************************************************* */
+template class ImuPreintegrationPipeline<PreintegratedImuMeasurements>;
+template class ImuPreintegrationPipeline<PreintegratedCombinedMeasurements>;
+
+}  // namespace gtsam
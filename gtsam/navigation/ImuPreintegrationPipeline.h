@@ -0,0 +1,172 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ImuPreintegrationPipeline.h
+ * @brief   Streaming preintegration of several IMUs between keyframes, on a
+ * background thread and a thread pool
+ * @date    Oct 16, 2026
+ */
+
+#pragma once
+
+#include <gtsam/navigation/ImuFactor.h>
+#include <gtsam/navigation/CombinedImuFactor.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Preintegrates streams of IMU samples from several sensors between
+ * keyframes, off the threads that receive the samples.
+ *
+ * Samples are pushed into a lock-free ring buffer per sensor, which a
+ * background thread drains.  Keyframe times, added with addKeyframe(), cut
+ * every stream into intervals.  A sample holds from its time stamp until the
+ * next sample of the same sensor, and is integrated over the part of that
+ * span inside the interval, so samples need not line up with keyframes.  The
+ * interval of a sensor is ready once a sample at or after its end has been
+ * pushed.  Ready intervals of all sensors, and several intervals of a sensor,
+ * are preintegrated concurrently on a ThreadPool, and then handed out by
+ * tryPop(), in keyframe order for every sensor.
+ *
+ * Every sensor must be fed by a single thread, different sensors may be fed
+ * by different threads.  PIM is PreintegratedImuMeasurements or
+ * PreintegratedCombinedMeasurements.
+ */
+template <class PIM>
+class GTSAM_EXPORT ImuPreintegrationPipeline {
+public:
+  typedef typename PIM::Params Params;
+  typedef imuBias::ConstantBias Bias;
+
+  /// The preintegrated measurements of one sensor between two keyframes
+  struct Interval {
+    size_t sensor;    ///< Index of the sensor
+    size_t keyframe;  ///< Index of the keyframe at the start
+    double start;     ///< Time of the keyframe at the start
+    double end;       ///< Time of the next keyframe
+    PIM pim;          ///< Empty if the sensor has no samples in the interval
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+  /**
+   * Start the background thread.
+   * @param params Preintegration parameters, one per sensor
+   * @param numThreads Threads of the pool, 0 for the hardware concurrency
+   * @param capacity Samples per ring buffer, rounded up to a power of 2.
+   * push() waits while the ring buffer of its sensor is full.
+   */
+  explicit ImuPreintegrationPipeline(
+      const std::vector<boost::shared_ptr<Params> >& params,
+      size_t numThreads = 0, size_t capacity = 4096);
+
+  /// Stops the background thread, intervals that are not ready are dropped
+  ~ImuPreintegrationPipeline();
+
+  /// Number of sensors
+  size_t numSensors() const { return sensors_.size(); }
+
+  /**
+   * Add a sample of a sensor, with time stamps strictly increasing for every
+   * sensor.  Never blocks on the background thread, unless the ring buffer
+   * is full.  Only takes the lock, briefly, to wake the background thread
+   * when it had drained the ring buffer.
+   */
+  void push(size_t sensor, double t, const Vector3& measuredAcc,
+            const Vector3& measuredOmega);
+
+  /// Set the bias estimate of a sensor for intervals starting at keyframes
+  /// added from now on
+  void setBiasHat(size_t sensor, const Bias& biasHat);
+
+  /// Add the time of the next keyframe, keyframe times strictly increase
+  void addKeyframe(double t);
+
+  /// Take the next ready interval, returns false if there is none
+  bool tryPop(Interval& interval);
+
+  /**
+   * Wait until all intervals that are ready with the samples pushed so far
+   * can be taken with tryPop().  If preintegration failed on the background
+   * thread, its exception is rethrown here.
+   */
+  void flush();
+
+  /// Number of samples preintegrated so far, a sample that spans a keyframe
+  /// counts in both intervals
+  size_t numIntegrated() const { return numIntegrated_; }
+
+private:
+  ImuPreintegrationPipeline(const ImuPreintegrationPipeline&);            // not copyable
+  ImuPreintegrationPipeline& operator=(const ImuPreintegrationPipeline&); // not copyable
+
+  struct Sample {
+    double t;
+    Vector3 acc, omega;
+  };
+
+  struct Sensor {
+    boost::shared_ptr<Params> params;
+
+    // Ring buffer, head is only written by the background thread and tail
+    // only by the thread that feeds the sensor
+    std::vector<Sample> ring;
+    std::atomic<size_t> head, tail;
+    double lastPushed;  ///< Only used by the feeding thread
+
+    // Only used by the background thread
+    /// Drained samples from the start of the next interval on.  Before the
+    /// first keyframe is added, all of them are kept.
+    std::vector<Sample> samples;
+    size_t nextKeyframe;          ///< Start of the next interval to integrate
+  };
+
+  /// A ready interval, with what the pool needs to preintegrate it
+  struct Job {
+    size_t sensor, keyframe;
+    double start, end;
+    Bias biasHat;
+  };
+
+  void run();
+  bool step();
+  bool pending() const;  ///< Whether any ring buffer holds samples
+  void integrate(const Job& job, Interval& interval);
+
+  std::vector<std::unique_ptr<Sensor> > sensors_;
+  size_t mask_;  ///< Ring buffer capacity - 1
+  size_t numThreads_;
+  std::atomic<size_t> numIntegrated_;
+
+  mutable std::mutex mutex_;  ///< Protects the state below
+  std::condition_variable wakeUp_, flushed_;
+  std::vector<double> keyframes_;
+  std::vector<Bias> biasHats_;                ///< Current estimate per sensor
+  std::vector<std::vector<Bias> > keyframeBiasHats_;  ///< Per keyframe
+  size_t numKeyframesSeen_;  ///< Keyframes when the background thread woke up
+  std::deque<Interval, Eigen::aligned_allocator<Interval> > ready_;
+  size_t flushRequested_, flushServed_;
+  std::exception_ptr error_;
+  bool stop_;
+
+  std::thread worker_;
+};
+
+}  // namespace gtsam
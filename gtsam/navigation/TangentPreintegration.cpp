@@ -18,6 +18,7 @@
 #include "TangentPreintegration.h"
 #include <gtsam/base/numericalDerivative.h>
 #include <boost/make_shared.hpp>
+#include <stdexcept>
 
 using namespace std;
 
@@ -36,6 +37,7 @@ void TangentPreintegration::resetIntegration() {
   preintegrated_.setZero();
   preintegrated_H_biasAcc_.setZero();
   preintegrated_H_biasOmega_.setZero();
+  samples_.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -116,6 +118,12 @@ void TangentPreintegration::update(const Vector3& measuredAcc,
     boost::tie(acc, omega) = correctMeasurementsBySensorPose(acc, omega,
         D_correctedAcc_acc, D_correctedAcc_omega, D_correctedOmega_omega);
 
+  if (storeSamples_) {
+    samples_.insert(samples_.end(), measuredAcc.data(), measuredAcc.data() + 3);
+    samples_.insert(samples_.end(), measuredOmega.data(), measuredOmega.data() + 3);
+    samples_.push_back(dt);
+  }
+
   // Do update
   deltaTij_ += dt;
   preintegrated_ = UpdatePreintegrated(acc, omega, dt, preintegrated_, A, B, C);
@@ -131,12 +139,14 @@ void TangentPreintegration::update(const Vector3& measuredAcc,
   // new_H_biasAcc = new_H_old * old_H_biasAcc + new_H_acc * acc_H_biasAcc
   // where acc_H_biasAcc = -I_3x3, hence
   // new_H_biasAcc = new_H_old * old_H_biasAcc - new_H_acc
-  preintegrated_H_biasAcc_ = (*A) * preintegrated_H_biasAcc_ - (*B);
+  preintegrated_H_biasAcc_ =
+      UpdateJacobianTimes(*A, preintegrated_H_biasAcc_) - (*B);
 
   // new_H_biasOmega = new_H_old * old_H_biasOmega + new_H_omega * omega_H_biasOmega
   // where omega_H_biasOmega = -I_3x3, hence
   // new_H_biasOmega = new_H_old * old_H_biasOmega - new_H_omega
-  preintegrated_H_biasOmega_ = (*A) * preintegrated_H_biasOmega_ - (*C);
+  preintegrated_H_biasOmega_ =
+      UpdateJacobianTimes(*A, preintegrated_H_biasOmega_) - (*C);
 }
 
 //------------------------------------------------------------------------------
@@ -242,6 +252,53 @@ void TangentPreintegration::mergeWith(const TangentPreintegration& pim12,
 
   preintegrated_H_biasOmega_ = (*H1) * preintegrated_H_biasOmega_
       + (*H2) * pim12.preintegrated_H_biasOmega_;
+
+  // The samples of both follow each other, unless either did not keep them
+  if (storeSamples_ && pim12.storeSamples_) {
+    samples_.insert(samples_.end(), pim12.samples_.begin(), pim12.samples_.end());
+  } else {
+    storeSamples_ = false;
+    samples_.clear();
+  }
+}
+
+//------------------------------------------------------------------------------
+void TangentPreintegration::storeSamples(double biasThreshold) {
+  if (deltaTij_ != 0.0 && !storeSamples_) {
+    throw std::invalid_argument(
+        "TangentPreintegration::storeSamples: must be called before integrating");
+  }
+  storeSamples_ = true;
+  biasThreshold_ = biasThreshold;
+}
+
+//------------------------------------------------------------------------------
+void TangentPreintegration::repreintegrate(const imuBias::ConstantBias& biasHat) {
+  if (!storeSamples_) {
+    throw std::logic_error(
+        "TangentPreintegration::repreintegrate: no samples stored");
+  }
+
+  // Take the samples out, so that update() does not append them again
+  std::vector<double> samples;
+  samples.swap(samples_);
+  storeSamples_ = false;
+
+  biasHat_ = biasHat;
+  deltaTij_ = 0.0;
+  preintegrated_.setZero();
+  preintegrated_H_biasAcc_.setZero();
+  preintegrated_H_biasOmega_.setZero();
+  Matrix9 A;
+  Matrix93 B, C;
+  for (size_t i = 0; i < samples.size(); i += kSampleSize) {
+    const double* sample = &samples[i];
+    update(Vector3(sample[0], sample[1], sample[2]),
+           Vector3(sample[3], sample[4], sample[5]), sample[6], &A, &B, &C);
+  }
+
+  samples_.swap(samples);
+  storeSamples_ = true;
 }
 
 //------------------------------------------------------------------------------
@@ -19,6 +19,8 @@
 
 #include <gtsam/navigation/PreintegrationBase.h>
 
+#include <vector>
+
 namespace gtsam {
 
 /**
@@ -36,6 +38,11 @@ class GTSAM_EXPORT TangentPreintegration : public PreintegrationBase {
   Matrix93 preintegrated_H_biasAcc_;    ///< Jacobian of preintegrated_ w.r.t. acceleration bias
   Matrix93 preintegrated_H_biasOmega_;  ///< Jacobian of preintegrated_ w.r.t. angular rate bias
 
+  /// Raw samples, kSampleSize doubles each: acceleration, angular rate, dt
+  std::vector<double> samples_;
+  bool storeSamples_ = false;   ///< Whether update() appends to samples_
+  double biasThreshold_ = 0.0;  ///< See storeSamples()
+
   /// Default constructor for serialization
   TangentPreintegration() {
     resetIntegration();
@@ -119,6 +126,43 @@ public:
   void mergeWith(const TangentPreintegration& pim, Matrix9* H1, Matrix9* H2);
   /// @}
 
+  /// @name Re-preintegration
+  /// @{
+
+  /// Number of doubles per stored sample
+  static const size_t kSampleSize = 7;
+
+  /**
+   * Keep the raw samples integrated from now on in one contiguous array, so
+   * that they can be re-preintegrated with a new bias estimate once it moves
+   * further than biasThreshold from biasHat, the norm of the 6D difference.
+   * Beyond that the first-order correction in biasCorrectedDelta loses
+   * accuracy.  Must be called before integrating.  The samples are not
+   * serialized and not compared by equals.
+   */
+  void storeSamples(double biasThreshold);
+
+  /// Whether raw samples are stored, see storeSamples()
+  bool storesSamples() const { return storeSamples_; }
+
+  /// Number of stored raw samples
+  size_t numStoredSamples() const { return samples_.size() / kSampleSize; }
+
+  /// Whether samples are stored and bias is further than the threshold from
+  /// biasHat
+  bool needsRepreintegration(const imuBias::ConstantBias& bias) const {
+    return storeSamples_ &&
+           (bias - biasHat_).vector().norm() > biasThreshold_;
+  }
+
+  /**
+   * Preintegrate the stored samples again, from scratch with biasHat.  Only
+   * the preintegrated vector and its bias Jacobians are recomputed: derived
+   * classes keep their covariance, which hardly depends on the bias.
+   */
+  void repreintegrate(const imuBias::ConstantBias& biasHat);
+  /// @}
+
   /** Dummy clone for MATLAB */
   virtual boost::shared_ptr<TangentPreintegration> clone() const {
     return boost::shared_ptr<TangentPreintegration>();
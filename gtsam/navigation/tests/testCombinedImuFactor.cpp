@@ -131,6 +131,45 @@ TEST( CombinedImuFactor, ErrorWithBiases ) {
   EXPECT(assert_equal(H5e, H5a.topRows(9)));
 }
 
+/* ************************************************************************* */
+TEST(CombinedImuFactor, linearize) {
+  const Bias biasHat(Vector3(0.2, 0, 0), Vector3(0, 0, 0.3));
+  auto p = testing::Params();
+  PreintegratedCombinedMeasurements pim(p, biasHat);
+  for (size_t k = 0; k < 10; k++)
+    pim.integrateMeasurement(Vector3(0.1 * k, 0, -kGravity),
+                             Vector3(0, 0.1, M_PI / 10.0), 0.01);
+  CombinedImuFactor factor(X(1), V(1), X(2), V(2), B(1), B(2), pim);
+
+  Values values;
+  values.insert(X(1), Pose3(Rot3::Expmap(Vector3(0, 0, M_PI / 4.0)),
+                            Point3(5.0, 1.0, -50.0)));
+  values.insert(V(1), Vector3(0.5, 0.0, 0.0));
+  values.insert(X(2), Pose3(Rot3::Expmap(Vector3(0, 0.01, M_PI / 4.0)),
+                            Point3(5.1, 1.0, -50.0)));
+  values.insert(V(2), Vector3(0.6, 0.1, 0.0));
+  values.insert(B(1), biasHat);
+  values.insert(B(2), Bias(Vector3(0.2, 0.2, 0), Vector3(1, 0, 0.3)));
+
+  // Same as whitening the dynamic Jacobians of evaluateError
+  const JacobianFactor::shared_ptr expected =
+      boost::dynamic_pointer_cast<JacobianFactor>(
+          factor.NoiseModelFactor::linearize(values));
+  GaussianFactor::shared_ptr actual = factor.linearize(values);
+  EXPECT(assert_equal(*expected,
+                      *boost::dynamic_pointer_cast<JacobianFactor>(actual)));
+
+  // Linearizing again writes into the same factor
+  const GaussianFactor* previous = actual.get();
+  values.update(B(2), biasHat);
+  factor.linearizeInto(values, actual);
+  EXPECT(actual.get() == previous);
+  EXPECT(assert_equal(
+      *boost::dynamic_pointer_cast<JacobianFactor>(
+          factor.NoiseModelFactor::linearize(values)),
+      *boost::dynamic_pointer_cast<JacobianFactor>(actual)));
+}
+
 /* ************************************************************************* */
 #ifdef GTSAM_TANGENT_PREINTEGRATION
 TEST(CombinedImuFactor, FirstOrderPreIntegratedMeasurements) {
@@ -204,6 +243,41 @@ TEST(CombinedImuFactor, PredictRotation) {
   EXPECT(assert_equal(expectedPose, actual.pose(), tol));
 }
 
+/* ************************************************************************* */
+TEST(CombinedImuFactor, IntegrateMeasurementsBatch) {
+  const Bias biasHat(Vector3(0.1, -0.2, 0.05), Vector3(0.01, 0.02, -0.03));
+  auto p = testing::Params();
+  p->biasAccOmegaInt = 0.01 * I_6x6;
+  p->biasAccOmegaInt.block<3, 3>(3, 0) = 0.001 * I_3x3;
+  p->biasAccOmegaInt.block<3, 3>(0, 3) = 0.001 * I_3x3;
+  const size_t n = 100;
+  Eigen::Matrix3Xd accs(3, n), omegas(3, n);
+  Vector dts(n);
+  for (size_t k = 0; k < n; k++) {
+    accs.col(k) << sin(0.1 * k), cos(0.2 * k), -kGravity + 0.1 * k;
+    omegas.col(k) << 0.3 * cos(0.1 * k), 0.2, -0.5 * sin(0.3 * k);
+    dts(k) = 0.001 * (1 + k % 3);
+  }
+
+  PreintegratedCombinedMeasurements expected(p, biasHat);
+  for (size_t k = 0; k < n; k++)
+    expected.integrateMeasurement(accs.col(k), omegas.col(k), dts(k));
+
+  PreintegratedCombinedMeasurements actual(p, biasHat);
+  actual.integrateMeasurements(accs, omegas, dts);
+  EXPECT(actual.equals(expected));
+  EXPECT(assert_equal(expected.preintMeasCov(), actual.preintMeasCov()));
+
+  // The covariance stays symmetric
+  EXPECT(assert_equal(actual.preintMeasCov(),
+                      Matrix(actual.preintMeasCov().transpose()), 1e-12));
+
+  // Mismatched sizes
+  CHECK_EXCEPTION(
+      actual.integrateMeasurements(accs, omegas.leftCols(n - 1), dts),
+      std::invalid_argument);
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
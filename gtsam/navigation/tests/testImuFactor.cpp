@@ -237,6 +237,32 @@ TEST(ImuFactor, MultipleMeasurements) {
   EXPECT(assert_equal(expected,actual));
 }
 
+/* ************************************************************************* */
+TEST(ImuFactor, IntegrateMeasurementsBatch) {
+  const Bias biasHat(Vector3(0.1, -0.2, 0.05), Vector3(0.01, 0.02, -0.03));
+  const size_t n = 100;
+  Eigen::Matrix3Xd accs(3, n), omegas(3, n);
+  Vector dts(n);
+  for (size_t k = 0; k < n; k++) {
+    accs.col(k) << sin(0.1 * k), cos(0.2 * k), -kGravity + 0.1 * k;
+    omegas.col(k) << 0.3 * cos(0.1 * k), 0.2, -0.5 * sin(0.3 * k);
+    dts(k) = 0.001 * (1 + k % 3);
+  }
+
+  PreintegratedImuMeasurements expected(testing::Params(), biasHat);
+  for (size_t k = 0; k < n; k++)
+    expected.integrateMeasurement(accs.col(k), omegas.col(k), dts(k));
+
+  PreintegratedImuMeasurements actual(testing::Params(), biasHat);
+  actual.integrateMeasurements(accs, omegas, dts);
+  EXPECT(assert_equal(expected, actual));
+
+  // Mismatched sizes
+  CHECK_EXCEPTION(
+      actual.integrateMeasurements(accs, omegas, Vector(dts.head(n - 1))),
+      std::invalid_argument);
+}
+
 /* ************************************************************************* */
 TEST(ImuFactor, ErrorAndJacobians) {
   using namespace common;
@@ -303,6 +329,90 @@ TEST(ImuFactor, ErrorAndJacobians) {
   EXPECT_CORRECT_FACTOR_JACOBIANS(factor, values, diffDelta, 1e-3);
 }
 
+/* ************************************************************************* */
+TEST(ImuFactor, linearize) {
+  using namespace common;
+  const Bias biasHat(Vector3(0.1, -0.2, 0.05), Vector3(0.01, 0.02, -0.03));
+  PreintegratedImuMeasurements pim(testing::Params(), biasHat);
+  for (size_t k = 0; k < 10; k++)
+    pim.integrateMeasurement(measuredAcc + Vector3(0, 0.1 * k, 0),
+                             measuredOmega, deltaT);
+  ImuFactor factor(X(1), V(1), X(2), V(2), B(1), pim);
+
+  Values values;
+  values.insert(X(1), x1);
+  values.insert(V(1), v1);
+  values.insert(X(2), x2);
+  values.insert(V(2), Vector3(v2 + Vector3(0.1, -0.1, 0.2)));
+  values.insert(B(1), Bias(Vector3(0.2, 0, 0), Vector3(0, 0.01, 0)));
+
+  // Same as whitening the dynamic Jacobians of evaluateError
+  const JacobianFactor::shared_ptr expected =
+      boost::dynamic_pointer_cast<JacobianFactor>(
+          factor.NoiseModelFactor::linearize(values));
+  GaussianFactor::shared_ptr actual = factor.linearize(values);
+  EXPECT(assert_equal(*expected,
+                      *boost::dynamic_pointer_cast<JacobianFactor>(actual)));
+
+  // Linearizing again writes into the same factor
+  const GaussianFactor* previous = actual.get();
+  values.update(V(1), Vector3(v1 + Vector3(0.3, 0, 0)));
+  factor.linearizeInto(values, actual);
+  EXPECT(actual.get() == previous);
+  EXPECT(assert_equal(
+      *boost::dynamic_pointer_cast<JacobianFactor>(
+          factor.NoiseModelFactor::linearize(values)),
+      *boost::dynamic_pointer_cast<JacobianFactor>(actual)));
+}
+
+/* ************************************************************************* */
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+TEST(ImuFactor, Repreintegrate) {
+  using namespace common;
+  PreintegratedImuMeasurements pim(testing::Params());
+  pim.storeSamples(0.05);
+  for (size_t k = 0; k < 10; k++)
+    pim.integrateMeasurement(measuredAcc + Vector3(0, 0.1 * k, 0),
+                             measuredOmega, deltaT);
+  ImuFactor factor(X(1), V(1), X(2), V(2), B(1), pim);
+
+  Values values;
+  values.insert(X(1), x1);
+  values.insert(V(1), v1);
+  values.insert(X(2), x2);
+  values.insert(V(2), v2);
+
+  // Close to biasHat, the first-order bias correction is used
+  values.insert(B(1), Bias(Vector3(0.01, 0, 0), Vector3(0, 0.01, 0)));
+  EXPECT(!factor.needsRefresh(values));
+  EXPECT(!factor.refresh(values));
+  EXPECT(assert_equal(Bias(), factor.preintegratedMeasurements().biasHat()));
+
+  // Further away, linearize still does not change the factor
+  const Bias bias(Vector3(0.2, -0.1, 0), Vector3(0, 0.05, -0.02));
+  values.update(B(1), bias);
+  factor.linearize(values);
+  EXPECT(assert_equal(Bias(), factor.preintegratedMeasurements().biasHat()));
+
+  // but refresh preintegrates the samples again with the estimate
+  EXPECT(factor.needsRefresh(values));
+  EXPECT(factor.refresh(values));
+  EXPECT(!factor.needsRefresh(values));
+  EXPECT(assert_equal(bias, factor.preintegratedMeasurements().biasHat()));
+  GaussianFactor::shared_ptr actual = factor.linearize(values);
+
+  PreintegratedImuMeasurements expectedPim(testing::Params(), bias);
+  for (size_t k = 0; k < 10; k++)
+    expectedPim.integrateMeasurement(measuredAcc + Vector3(0, 0.1 * k, 0),
+                                     measuredOmega, deltaT);
+  // The covariance is not recomputed, so use the noise model of the factor
+  const ImuFactor expected(X(1), V(1), X(2), V(2), B(1), expectedPim);
+  EXPECT(assert_equal(expected.evaluateError(x1, v1, x2, v2, bias),
+                      factor.evaluateError(x1, v1, x2, v2, bias)));
+  EXPECT(assert_equal(*factor.NoiseModelFactor::linearize(values), *actual));
+}
+#endif
+
 /* ************************************************************************* */
 TEST(ImuFactor, ErrorAndJacobianWithBiases) {
   using common::x1;
@@ -798,6 +908,111 @@ TEST(ImuFactor, bodyPSensorWithBias) {
   EXPECT(assert_equal(biasExpected, biasActual, 1e-3));
 }
 
+/* ************************************************************************* */
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+#include <gtsam/nonlinear/ISAM2.h>
+
+namespace repreintegration {
+// A stationary IMU with a large bias, preintegrated with a zero biasHat
+static const size_t kNumFactors = 5;
+static const Bias kBias(Vector3(0.2, -0.1, 0), Vector3(0, 0.05, -0.02));
+
+static NonlinearFactorGraph Graph() {
+  NonlinearFactorGraph graph;
+  graph.emplace_shared<PriorFactor<Pose3> >(X(0), Pose3(),
+                                            noiseModel::Isotropic::Sigma(6, 1e-3));
+  graph.emplace_shared<PriorFactor<Vector3> >(V(0), Vector3::Zero(),
+                                              noiseModel::Isotropic::Sigma(3, 1e-3));
+  graph.emplace_shared<PriorFactor<Bias> >(B(0), kBias,
+                                           noiseModel::Isotropic::Sigma(6, 1e-3));
+  for (size_t i = 0; i < kNumFactors; i++) {
+    PreintegratedImuMeasurements pim(testing::Params());
+    pim.storeSamples(0.05);
+    for (size_t j = 0; j < 10; j++)
+      pim.integrateMeasurement(Vector3(0, 0, -kGravity) + kBias.accelerometer(),
+                               kBias.gyroscope(), 0.1);
+    graph.emplace_shared<ImuFactor>(X(i), V(i), X(i + 1), V(i + 1), B(0), pim);
+  }
+  return graph;
+}
+
+static Values Initial() {
+  Values values;
+  for (size_t i = 0; i <= kNumFactors; i++) {
+    values.insert(X(i), Pose3(Rot3::Rz(0.05), Point3(0.1 * i, 0.05, 0)));
+    values.insert(V(i), Vector3(0.1, 0, 0));
+  }
+  values.insert(B(0), kBias);
+  return values;
+}
+}  // namespace repreintegration
+
+/* ************************************************************************* */
+TEST(ImuFactor, RepreintegrateLevenbergMarquardt) {
+  using namespace repreintegration;
+  const NonlinearFactorGraph graph = Graph();
+  LevenbergMarquardtOptimizer optimizer(graph, Initial());
+
+  // The bias estimate is far from biasHat, so the factors change once, but
+  // only in the graph of the optimizer: the factors of the caller stay as
+  // they are
+  const double initialError = graph.error(Initial());
+  EXPECT(optimizer.refreshFactors());
+  EXPECT(!optimizer.refreshFactors());
+  EXPECT(optimizer.error() != initialError);
+  EXPECT_DOUBLES_EQUAL(initialError, graph.error(Initial()), 0.0);
+  for (size_t i = 3; i < graph.size(); i++) {
+    auto factor = boost::static_pointer_cast<ImuFactor>(graph.at(i));
+    EXPECT(assert_equal(Bias(), factor->preintegratedMeasurements().biasHat()));
+  }
+
+  // The error decreases monotonically
+  for (size_t k = 0; k < 10; k++) {
+    optimizer.refreshFactors();
+    const double before = optimizer.error();
+    optimizer.iterate();
+    EXPECT(optimizer.error() <= before);
+  }
+
+  // optimize() refreshes the factors itself
+  const Values result = LevenbergMarquardtOptimizer(Graph(), Initial()).optimize();
+  EXPECT(assert_equal(kBias, result.at<Bias>(B(0)), 1e-4));
+  EXPECT(assert_equal(Pose3(), result.at<Pose3>(X(kNumFactors)), 1e-4));
+}
+
+/* ************************************************************************* */
+TEST(ImuFactor, RepreintegrateISAM2) {
+  using namespace repreintegration;
+  const NonlinearFactorGraph graph = Graph();
+  ISAM2Params params;
+  params.relinearizeThreshold = 0.0;
+  params.relinearizeSkip = 1;
+  ISAM2 isam(params);
+  isam.update(graph, Initial());
+
+  // New factors are refreshed before they are linearized, in the graph of
+  // ISAM2 only
+  const NonlinearFactorGraph& factors = isam.getFactorsUnsafe();
+  for (size_t i = 3; i < graph.size(); i++) {
+    auto factor = boost::static_pointer_cast<ImuFactor>(factors.at(i));
+    EXPECT(assert_equal(kBias, factor->preintegratedMeasurements().biasHat()));
+    factor = boost::static_pointer_cast<ImuFactor>(graph.at(i));
+    EXPECT(assert_equal(Bias(), factor->preintegratedMeasurements().biasHat()));
+  }
+
+  // and the error decreases monotonically
+  double before = factors.error(isam.calculateEstimate());
+  for (size_t k = 0; k < 5; k++) {
+    isam.update();
+    const double after = factors.error(isam.calculateEstimate());
+    EXPECT(after <= before + 1e-9);
+    before = after;
+  }
+  EXPECT(assert_equal(Pose3(), isam.calculateEstimate<Pose3>(X(kNumFactors)),
+                      1e-4));
+}
+#endif
+
 /* ************************************************************************* */
 #ifdef GTSAM_TANGENT_PREINTEGRATION
 static const double kVelocity = 2.0, kAngularVelocity = M_PI / 6;
@@ -0,0 +1,205 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testImuPreintegrationPipeline.cpp
+ * @brief   Unit test for streaming preintegration of several IMUs
+ * @date    Oct 16, 2026
+ */
+
+#include <gtsam/navigation/ImuPreintegrationPipeline.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include "imuFactorTesting.h"
+
+namespace testing {
+// Create default parameters with Z-down and above noise parameters
+static boost::shared_ptr<PreintegrationParams> Params() {
+  auto p = PreintegrationParams::MakeSharedD(kGravity);
+  p->gyroscopeCovariance = kGyroSigma * kGyroSigma * I_3x3;
+  p->accelerometerCovariance = kAccelSigma * kAccelSigma * I_3x3;
+  p->integrationCovariance = 0.0001 * I_3x3;
+  return p;
+}
+
+// Time between samples and keyframes, powers of 2 so that times are exact
+static const double kSampleDt = 1.0 / 1024;
+static const double kKeyframeDt = 0.125;
+static const size_t kNumKeyframes = 9;
+
+// Sensor 1 samples halfway between the samples of sensor 0
+static double sampleTime(size_t sensor, size_t i) {
+  return (i + 0.5 * sensor) * kSampleDt;
+}
+static Vector3 acc(size_t sensor, double t) {
+  return Vector3(sin(t + sensor), cos(2 * t), kGravity + 0.1 * sin(5 * t));
+}
+static Vector3 omega(size_t sensor, double t) {
+  return Vector3(0.3 * cos(t), 0.2 * sin(3 * t + sensor), 0.5);
+}
+
+static const imuBias::ConstantBias kBias(Vector3(0.1, -0.1, 0.05),
+                                         Vector3(0.01, 0.02, -0.01));
+
+template <class PIM>
+static void feed(ImuPreintegrationPipeline<PIM>* pipeline, size_t sensor,
+                 size_t numSamples) {
+  for (size_t i = 0; i < numSamples; i++) {
+    const double t = sampleTime(sensor, i);
+    pipeline->push(sensor, t, acc(sensor, t), omega(sensor, t));
+  }
+}
+
+// Serial preintegration of an interval, every sample holds until the next
+template <class PIM>
+static PIM integrate(const boost::shared_ptr<typename PIM::Params>& p,
+                     const imuBias::ConstantBias& biasHat, size_t sensor,
+                     double start, double end) {
+  PIM pim(p, biasHat);
+  for (size_t i = 0; sampleTime(sensor, i) < end; i++) {
+    const double t = sampleTime(sensor, i);
+    const double dt = std::min(sampleTime(sensor, i + 1), end) -
+                      std::max(t, start);
+    if (dt > 0) pim.integrateMeasurement(acc(sensor, t), omega(sensor, t), dt);
+  }
+  return pim;
+}
+}  // namespace testing
+
+/* ************************************************************************* */
+TEST(ImuPreintegrationPipeline, TwoSensors) {
+  typedef ImuPreintegrationPipeline<PreintegratedImuMeasurements> Pipeline;
+  std::vector<boost::shared_ptr<PreintegrationParams> > params;
+  params.push_back(testing::Params());
+  params.push_back(testing::Params());
+  params[1]->accelerometerCovariance = 1e-3 * I_3x3;
+
+  // A small ring buffer, so that pushing has to wait for the background thread
+  Pipeline pipeline(params, 2, 64);
+  EXPECT_LONGS_EQUAL(2, pipeline.numSensors());
+
+  // The bias estimate of sensor 1 changes at keyframe 4
+  for (size_t k = 0; k < testing::kNumKeyframes; k++) {
+    if (k == 4) pipeline.setBiasHat(1, testing::kBias);
+    pipeline.addKeyframe(k * testing::kKeyframeDt);
+  }
+  CHECK_EXCEPTION(pipeline.addKeyframe(0.5), std::invalid_argument);
+
+  // Feed every sensor from its own thread, up to just past the last keyframe
+  const size_t numSamples =
+      (testing::kNumKeyframes - 1) * testing::kKeyframeDt / testing::kSampleDt + 1;
+  std::thread feeder0(testing::feed<PreintegratedImuMeasurements>, &pipeline,
+                      0, numSamples);
+  std::thread feeder1(testing::feed<PreintegratedImuMeasurements>, &pipeline,
+                      1, numSamples);
+  feeder0.join();
+  feeder1.join();
+  CHECK_EXCEPTION(pipeline.push(0, 0.5, Z_3x1, Z_3x1), std::invalid_argument);
+  pipeline.flush();
+
+  // Intervals come out in keyframe order for every sensor
+  size_t next[2] = {0, 0};
+  Pipeline::Interval interval;
+  while (pipeline.tryPop(interval)) {
+    const size_t j = interval.sensor, k = interval.keyframe;
+    EXPECT_LONGS_EQUAL(next[j], k);
+    next[j] = k + 1;
+    EXPECT_DOUBLES_EQUAL(k * testing::kKeyframeDt, interval.start, 0);
+    EXPECT_DOUBLES_EQUAL((k + 1) * testing::kKeyframeDt, interval.end, 0);
+
+    const imuBias::ConstantBias biasHat =
+        (j == 1 && k >= 4) ? testing::kBias : imuBias::ConstantBias();
+    const PreintegratedImuMeasurements expected =
+        testing::integrate<PreintegratedImuMeasurements>(
+            params[j], biasHat, j, interval.start, interval.end);
+    EXPECT(assert_equal(expected, interval.pim, 1e-9));
+
+    // Except for the first sample of sensor 1, samples cover every interval
+    const double gap = (j == 1 && k == 0) ? 0.5 * testing::kSampleDt : 0;
+    EXPECT_DOUBLES_EQUAL(testing::kKeyframeDt - gap, interval.pim.deltaTij(),
+                         1e-12);
+  }
+  EXPECT_LONGS_EQUAL(testing::kNumKeyframes - 1, next[0]);
+  EXPECT_LONGS_EQUAL(testing::kNumKeyframes - 1, next[1]);
+}
+
+/* ************************************************************************* */
+TEST(ImuPreintegrationPipeline, Combined) {
+  typedef ImuPreintegrationPipeline<PreintegratedCombinedMeasurements> Pipeline;
+  auto p = PreintegratedCombinedMeasurements::Params::MakeSharedD(kGravity);
+  p->gyroscopeCovariance = kGyroSigma * kGyroSigma * I_3x3;
+  p->accelerometerCovariance = kAccelSigma * kAccelSigma * I_3x3;
+  p->integrationCovariance = 0.0001 * I_3x3;
+  Pipeline pipeline(std::vector<boost::shared_ptr<Pipeline::Params> >(1, p));
+
+  // The last interval has no sample after its end, and is not ready
+  pipeline.addKeyframe(0);
+  pipeline.addKeyframe(testing::kKeyframeDt);
+  pipeline.addKeyframe(1);
+  testing::feed(&pipeline, 0, testing::kKeyframeDt / testing::kSampleDt + 1);
+  pipeline.flush();
+
+  Pipeline::Interval interval;
+  CHECK(pipeline.tryPop(interval));
+  const PreintegratedCombinedMeasurements expected =
+      testing::integrate<PreintegratedCombinedMeasurements>(
+          p, imuBias::ConstantBias(), 0, 0, testing::kKeyframeDt);
+  EXPECT(expected.equals(interval.pim, 1e-9));
+  EXPECT(!pipeline.tryPop(interval));
+  EXPECT_LONGS_EQUAL(testing::kKeyframeDt / testing::kSampleDt,
+                     pipeline.numIntegrated());
+}
+
+/* ************************************************************************* */
+// Intervals become ready without flush(), whether the keyframe or the sample
+// that completes them comes last
+TEST(ImuPreintegrationPipeline, NoFlush) {
+  typedef ImuPreintegrationPipeline<PreintegratedImuMeasurements> Pipeline;
+  Pipeline pipeline(std::vector<boost::shared_ptr<PreintegrationParams> >(
+      1, testing::Params()));
+  Pipeline::Interval interval;
+  auto waitForInterval = [&] {
+    for (size_t i = 0; i < 10000; i++) {
+      if (pipeline.tryPop(interval)) return true;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+  };
+
+  const size_t perKeyframe = testing::kKeyframeDt / testing::kSampleDt;
+  pipeline.addKeyframe(0);
+  testing::feed(&pipeline, 0, perKeyframe + 1);
+  pipeline.addKeyframe(testing::kKeyframeDt);
+  CHECK(waitForInterval());
+  EXPECT_LONGS_EQUAL(0, interval.keyframe);
+
+  pipeline.addKeyframe(2 * testing::kKeyframeDt);
+  for (size_t i = perKeyframe + 1; i <= 2 * perKeyframe; i++) {
+    const double t = testing::sampleTime(0, i);
+    pipeline.push(0, t, testing::acc(0, t), testing::omega(0, t));
+  }
+  CHECK(waitForInterval());
+  EXPECT_LONGS_EQUAL(1, interval.keyframe);
+  EXPECT_LONGS_EQUAL(2 * perKeyframe, pipeline.numIntegrated());
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
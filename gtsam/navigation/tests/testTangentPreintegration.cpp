@@ -164,6 +164,33 @@ TEST(TangentPreintegration, MergedBiasDerivatives) {
                       expected_pim02.preintegrated_H_biasOmega(), 1e-7));
 }
 
+/* ************************************************************************* */
+TEST(TangentPreintegration, Repreintegrate) {
+  testing::SomeMeasurements measurements;
+  const Bias bias(Vector3(0.2, -0.1, 0.3), Vector3(0.02, 0.01, -0.03));
+
+  TangentPreintegration pim(testing::Params());
+  pim.storeSamples(0.1);
+  testing::integrateMeasurements(measurements, &pim);
+  EXPECT_LONGS_EQUAL(measurements.size(), pim.numStoredSamples());
+  EXPECT(!pim.needsRepreintegration(Bias(Vector3(0.05, 0, 0), Z_3x1)));
+  EXPECT(pim.needsRepreintegration(bias));
+
+  // Same as integrating with the new bias estimate from the start
+  pim.repreintegrate(bias);
+  TangentPreintegration expected(testing::Params(), bias);
+  testing::integrateMeasurements(measurements, &expected);
+  EXPECT(expected.equals(pim, 1e-9));
+  EXPECT_LONGS_EQUAL(measurements.size(), pim.numStoredSamples());
+  EXPECT(!pim.needsRepreintegration(bias));
+
+  // Samples have to be stored from the start
+  TangentPreintegration late(testing::Params());
+  testing::integrateMeasurements(measurements, &late);
+  CHECK_EXCEPTION(late.storeSamples(0.1), std::invalid_argument);
+  CHECK_EXCEPTION(late.repreintegrate(bias), std::logic_error);
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
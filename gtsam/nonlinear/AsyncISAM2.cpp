@@ -0,0 +1,152 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    AsyncISAM2.cpp
+ * @brief   ISAM2 running on a background thread, with an always-readable
+ * estimate
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam/nonlinear/AsyncISAM2.h>
+#include <gtsam/base/timing.h>
+
+#include <boost/make_shared.hpp>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+AsyncISAM2::AsyncISAM2(const ISAM2Params& params)
+    : isam_(params),
+      estimate_(boost::make_shared<const Values>()),
+      numUpdates_(0),
+      added_(0),
+      processed_(0),
+      stop_(false) {
+  worker_ = std::thread(&AsyncISAM2::run, this);
+}
+
+/* ************************************************************************* */
+AsyncISAM2::~AsyncISAM2() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wakeUp_.notify_one();
+  worker_.join();
+}
+
+/* ************************************************************************* */
+void AsyncISAM2::add(const NonlinearFactorGraph& newFactors,
+                     const Values& newTheta) {
+  // Copy outside of the lock, so the worker is only held up by the append
+  Pending pending{newFactors, newTheta};
+  std::lock_guard<std::mutex> lock(mutex_);
+  queue_.push_back(std::move(pending));
+  ++added_;
+  wakeUp_.notify_one();
+}
+
+/* ************************************************************************* */
+void AsyncISAM2::flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this] { return processed_ == added_; });
+  if (error_) {
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+/* ************************************************************************* */
+AsyncISAM2::ValuesSnapshot AsyncISAM2::estimate() const {
+  return boost::atomic_load(&estimate_);
+}
+
+/* ************************************************************************* */
+ISAM2Result AsyncISAM2::lastResult() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return lastResult_;
+}
+
+/* ************************************************************************* */
+void AsyncISAM2::check(const Pending& pending, const Values& merged) const {
+  for (const auto& key_value : pending.newTheta)
+    if (isam_.valueExists(key_value.key) || merged.exists(key_value.key))
+      throw ValuesKeyAlreadyExists(key_value.key);
+  for (const auto& factor : pending.newFactors) {
+    if (!factor) continue;
+    for (Key key : factor->keys())
+      if (!isam_.valueExists(key) && !merged.exists(key) &&
+          !pending.newTheta.exists(key))
+        throw ValuesKeyDoesNotExist("AsyncISAM2::add", key);
+  }
+}
+
+/* ************************************************************************* */
+void AsyncISAM2::run() {
+  // The timing tree is not thread-safe, see ThreadPool
+  internal::setTimingEnabledInThread(false);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    wakeUp_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+    if (queue_.empty()) break;  // stopped, and nothing left to do
+    std::vector<Pending> batch;
+    batch.swap(queue_);
+
+    // Update without holding the lock, so add() and flush() do not wait
+    lock.unlock();
+    std::exception_ptr error;
+    ISAM2Result result;
+    bool updated = false;
+
+    // Merge oldest first.  An entry that would make ISAM2 throw halfway
+    // through its update is rejected on its own, before anything is merged.
+    NonlinearFactorGraph newFactors;
+    Values newTheta;
+    size_t accepted = 0;
+    for (const Pending& pending : batch) {
+      try {
+        check(pending, newTheta);
+      } catch (...) {
+        if (!error) error = std::current_exception();
+        continue;
+      }
+      newFactors.push_back(pending.newFactors);
+      newTheta.insert(pending.newTheta);
+      ++accepted;
+    }
+
+    if (accepted > 0) {
+      try {
+        result = isam_.update(newFactors, newTheta);
+
+        // Compute the new estimate off to the side, then swap it in
+        ValuesSnapshot estimate =
+            boost::make_shared<const Values>(isam_.calculateEstimate());
+        boost::atomic_store(&estimate_, estimate);
+        ++numUpdates_;
+        updated = true;
+      } catch (...) {
+        if (!error) error = std::current_exception();
+      }
+    }
+    lock.lock();
+
+    processed_ += batch.size();
+    if (error && !error_) error_ = error;
+    if (updated) lastResult_ = result;
+    idle_.notify_all();
+  }
+}
+
+}  // namespace gtsam
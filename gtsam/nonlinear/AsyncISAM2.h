@@ -0,0 +1,126 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    AsyncISAM2.h
+ * @brief   ISAM2 running on a background thread, with an always-readable
+ * estimate
+ * @date    Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/ISAM2.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * @addtogroup ISAM2
+ * Runs ISAM2 updates on a background thread.
+ *
+ * New factors and variables are handed over with add(), which never waits for
+ * an update to finish: it only holds a mutex to append them to a queue.  The
+ * background thread merges everything queued since its last update into a
+ * single ISAM2::update call.  Each queued entry is checked on its own before
+ * it is merged, and an entry that inserts an existing variable, or has a
+ * factor on an unknown variable, is rejected without affecting the others.
+ * After every update the new estimate is computed on the background thread
+ * and then published by swapping a single pointer, so estimate() always
+ * returns a complete, consistent snapshot without waiting for a
+ * relinearization in progress.  gttic/gttoc inside ISAM2 are not recorded on
+ * the background thread.
+ *
+ * Because queued measurements are batched, the sequence of ISAM2 updates (and
+ * hence relinearization decisions) depends on timing.  Call flush() to wait
+ * until everything added so far has been incorporated.
+ */
+class GTSAM_EXPORT AsyncISAM2 {
+public:
+  typedef boost::shared_ptr<const Values> ValuesSnapshot;
+
+  /// Create an empty ISAM2 with the given parameters, and start the
+  /// background thread
+  explicit AsyncISAM2(const ISAM2Params& params = ISAM2Params());
+
+  /// Incorporates all queued measurements, then stops the background thread
+  ~AsyncISAM2();
+
+  /**
+   * Queue new factors and new variables for the next update, and return
+   * immediately.  Arguments are the same as for the first two arguments of
+   * ISAM2::update, and are copied.
+   */
+  void add(const NonlinearFactorGraph& newFactors = NonlinearFactorGraph(),
+           const Values& newTheta = Values());
+
+  /**
+   * Wait until all measurements added so far are incorporated in the
+   * estimate.  If an entry was rejected or an update failed on the background
+   * thread, the first such exception is rethrown here.
+   */
+  void flush();
+
+  /// The estimate after the most recent update, never blocks for long
+  ValuesSnapshot estimate() const;
+
+  /// Estimate of a single variable, from the most recent snapshot
+  template <class VALUE>
+  VALUE calculateEstimate(Key key) const {
+    return estimate()->at<VALUE>(key);
+  }
+
+  /// Number of ISAM2 updates done on the background thread so far
+  size_t numUpdates() const { return numUpdates_; }
+
+  /// The result of the most recent update
+  ISAM2Result lastResult() const;
+
+private:
+  AsyncISAM2(const AsyncISAM2&);            // not copyable
+  AsyncISAM2& operator=(const AsyncISAM2&); // not copyable
+
+  /// A queued measurement
+  struct Pending {
+    NonlinearFactorGraph newFactors;
+    Values newTheta;
+  };
+
+  void run();
+
+  /// Throw if \c pending can not be added to isam_ together with the
+  /// variables \c merged from the entries before it
+  void check(const Pending& pending, const Values& merged) const;
+
+  ISAM2 isam_;                          ///< Only used by the background thread
+  ValuesSnapshot estimate_;             ///< Accessed with atomic load/store
+  std::atomic<size_t> numUpdates_;
+
+  mutable std::mutex mutex_;            ///< Protects the state below
+  std::vector<Pending> queue_;          ///< Added measurements, oldest first
+  std::condition_variable wakeUp_, idle_;
+  size_t added_, processed_;            ///< Number of add() calls
+  ISAM2Result lastResult_;
+  std::exception_ptr error_;
+  bool stop_;
+
+  std::thread worker_;
+};
+
+}  // namespace gtsam
@@ -0,0 +1,134 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    CachedErrorEvaluator.cpp
+ * @brief   Evaluates the error of a factor graph at trial steps, re-using the
+ * errors of factors whose variables did not change
+ * @date    Oct 15, 2026
+ */
+
+#include <gtsam/nonlinear/CachedErrorEvaluator.h>
+#include <gtsam/base/ThreadPool.h>
+#include <gtsam/base/timing.h>
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+CachedErrorEvaluator::CachedErrorEvaluator(const NonlinearFactorGraph& graph,
+                                           size_t numThreads,
+                                           bool storeWhitenedErrors)
+    : graph_(graph),
+      variableIndex_(graph),
+      numThreads_(numThreads),
+      storeWhitenedErrors_(storeWhitenedErrors),
+      initialized_(false),
+      error_(0.0),
+      trialError_(0.0) {}
+
+/* ************************************************************************* */
+void CachedErrorEvaluator::evaluate(size_t i, const Values& values,
+                                    double* error, Vector* whitened) const {
+  const NonlinearFactorGraph::sharedFactor& factor = graph_[i];
+  if (!factor) {
+    *error = 0.0;
+    return;
+  }
+  *error = factor->error(values);
+  if (storeWhitenedErrors_) {
+    const NoiseModelFactor* noiseModelFactor =
+        dynamic_cast<const NoiseModelFactor*>(factor.get());
+    if (noiseModelFactor && noiseModelFactor->active(values))
+      *whitened = noiseModelFactor->whitenedError(values);
+    else
+      whitened->resize(0);
+  }
+}
+
+/* ************************************************************************* */
+double CachedErrorEvaluator::reset(const Values& values) {
+  gttic(CachedErrorEvaluator_reset);
+  const size_t n = graph_.size();
+  if (variableIndex_.nFactors() != n)
+    throw invalid_argument(
+        "CachedErrorEvaluator: the factor graph changed after construction");
+  errors_.assign(n, 0.0);
+  whitened_.assign(storeWhitenedErrors_ ? n : 0, Vector());
+  ThreadPool::Shared(numThreads_).parallelFor(n, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      evaluate(i, values, &errors_[i],
+               storeWhitenedErrors_ ? &whitened_[i] : nullptr);
+  });
+
+  error_ = 0.0;
+  for (double e : errors_) error_ += e;
+  initialized_ = true;
+  trialFactors_.clear();
+  return error_;
+}
+
+/* ************************************************************************* */
+double CachedErrorEvaluator::error(const Values& values,
+                                   const VectorValues& delta) const {
+  gttic(CachedErrorEvaluator_error);
+  if (!initialized_)
+    throw logic_error("CachedErrorEvaluator: reset() was not called");
+
+  // Collect the factors involving a variable that moved
+  vector<bool> affected(errors_.size(), false);
+  for (const VectorValues::KeyValuePair& key_delta : delta) {
+    if ((key_delta.second.array() == 0.0).all()) continue;
+    VariableIndex::const_iterator factors = variableIndex_.find(key_delta.first);
+    if (factors == variableIndex_.end()) continue;
+    for (FactorIndex i : factors->second) affected[i] = true;
+  }
+  trialFactors_.clear();
+  for (size_t i = 0; i < affected.size(); ++i)
+    if (affected[i]) trialFactors_.push_back(i);
+
+  // Re-evaluate only those
+  const size_t m = trialFactors_.size();
+  trialErrors_.resize(m);
+  trialWhitened_.resize(storeWhitenedErrors_ ? m : 0);
+  ThreadPool::Shared(numThreads_).parallelFor(m, [&](size_t begin, size_t end) {
+    for (size_t k = begin; k < end; ++k)
+      evaluate(trialFactors_[k], values, &trialErrors_[k],
+               storeWhitenedErrors_ ? &trialWhitened_[k] : nullptr);
+  });
+
+  // Sum over all factors in order, as NonlinearFactorGraph::error does
+  trialError_ = 0.0;
+  size_t next = 0;
+  for (size_t i = 0; i < errors_.size(); ++i) {
+    if (next < m && trialFactors_[next] == i)
+      trialError_ += trialErrors_[next++];
+    else
+      trialError_ += errors_[i];
+  }
+  return trialError_;
+}
+
+/* ************************************************************************* */
+void CachedErrorEvaluator::accept() {
+  for (size_t k = 0; k < trialFactors_.size(); ++k) {
+    errors_[trialFactors_[k]] = trialErrors_[k];
+    if (storeWhitenedErrors_)
+      whitened_[trialFactors_[k]].swap(trialWhitened_[k]);
+  }
+  if (!trialFactors_.empty()) error_ = trialError_;
+  trialFactors_.clear();
+}
+
+}  // namespace gtsam
@@ -0,0 +1,113 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    CachedErrorEvaluator.h
+ * @brief   Evaluates the error of a factor graph at trial steps, re-using the
+ * errors of factors whose variables did not change
+ * @date    Oct 15, 2026
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/inference/VariableIndex.h>
+#include <gtsam/linear/VectorValues.h>
+
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Caches the error of every factor of a NonlinearFactorGraph at a reference
+ * point, so the error at a trial point \f$ x_0 \oplus \delta \f$ only has to
+ * re-evaluate the factors that involve a variable with a non-zero delta.
+ *
+ * This is meant for the trial steps of the trust-region optimizers: error()
+ * evaluates a trial step without changing the reference point, and accept()
+ * makes the last trial step the new reference point when the optimizer takes
+ * the step.  Totals are summed over all factors in order, so they are equal to
+ * NonlinearFactorGraph::error on the same point.
+ *
+ * Optionally the whitened residual of every NoiseModelFactor is kept as well.
+ * This needs a second evaluation of each recomputed factor, so it is off by
+ * default.
+ */
+class GTSAM_EXPORT CachedErrorEvaluator {
+public:
+  /**
+   * Create an evaluator for \c graph, which is not copied and has to outlive
+   * the evaluator.  Call reset() before evaluating trial steps.
+   * @param numThreads re-evaluate factors on this many threads (0 for all
+   * cores), as in NonlinearFactorGraph::error
+   * @param storeWhitenedErrors also keep the whitened residual of every
+   * NoiseModelFactor, see whitenedError()
+   */
+  explicit CachedErrorEvaluator(const NonlinearFactorGraph& graph,
+                                size_t numThreads = 1,
+                                bool storeWhitenedErrors = false);
+
+  /// Evaluate all factors at \c values and make it the reference point,
+  /// returns the total error
+  double reset(const Values& values);
+
+  /// Whether reset() was called
+  bool initialized() const { return initialized_; }
+
+  /// Total error at the reference point
+  double error() const { return error_; }
+
+  /**
+   * Error at the trial point \c values, which must be equal to
+   * <tt>reference.retract(delta)</tt>.  Only factors involving a variable
+   * whose delta is non-zero are evaluated.  The result is kept until the next
+   * call, so that accept() can make it the reference point.
+   */
+  double error(const Values& values, const VectorValues& delta) const;
+
+  /// Make the point of the last call to error(values, delta) the reference
+  /// point
+  void accept();
+
+  /// Number of factors evaluated by the last call to error(values, delta)
+  size_t lastNumEvaluated() const { return trialFactors_.size(); }
+
+  /// Error of factor \c i at the reference point (0 for null factors)
+  double factorError(size_t i) const { return errors_[i]; }
+
+  /// Whitened residual of factor \c i at the reference point, empty unless
+  /// created with \c storeWhitenedErrors, or if the factor is not an active
+  /// NoiseModelFactor
+  const Vector& whitenedError(size_t i) const { return whitened_[i]; }
+
+private:
+  /// Evaluate factor i at values into the given slots
+  void evaluate(size_t i, const Values& values, double* error,
+                Vector* whitened) const;
+
+  const NonlinearFactorGraph& graph_;
+  const VariableIndex variableIndex_;
+  const size_t numThreads_;
+  const bool storeWhitenedErrors_;
+
+  bool initialized_;
+  double error_;                ///< Total error at the reference point
+  std::vector<double> errors_;  ///< Per-factor errors at the reference point
+  std::vector<Vector> whitened_;
+
+  // The last trial point, only the factors in trialFactors_ were re-evaluated
+  mutable FactorIndices trialFactors_;
+  mutable std::vector<double> trialErrors_;
+  mutable std::vector<Vector> trialWhitened_;
+  mutable double trialError_;
+};
+
+}  // namespace gtsam
@@ -66,16 +66,25 @@ DoglegOptimizer::DoglegOptimizer(const NonlinearFactorGraph& graph, const Values
                                  const DoglegParams& params)
     : NonlinearOptimizer(
           graph, std::unique_ptr<State>(
-                     new State(initialValues, graph.error(initialValues), params.deltaInitial))),
-      params_(ensureHasOrdering(params, graph)) {}
+                     new State(initialValues, graph.error(initialValues, params.numThreads),
+                               params.deltaInitial))),
+      params_(ensureHasOrdering(params, graph)),
+      errorEvaluator_(graph_, params_.numThreads) {}
 
 DoglegOptimizer::DoglegOptimizer(const NonlinearFactorGraph& graph, const Values& initialValues,
                                  const Ordering& ordering)
     : NonlinearOptimizer(graph, std::unique_ptr<State>(
-                                    new State(initialValues, graph.error(initialValues), 1.0))) {
+                                    new State(initialValues, graph.error(initialValues), 1.0))),
+      errorEvaluator_(graph_, params_.numThreads) {
   params_.ordering = ordering;
 }
 
+/* ************************************************************************* */
+double DoglegOptimizer::recomputeError() {
+  return errorEvaluator_.reset(state_->values);
+}
+
+/* ************************************************************************* */
 double DoglegOptimizer::getDelta() const {
   return static_cast<const State*>(state_.get())->delta;
 }
@@ -84,7 +93,7 @@ double DoglegOptimizer::getDelta() const {
 GaussianFactorGraph::shared_ptr DoglegOptimizer::iterate(void) {
 
   // Linearize graph
-  GaussianFactorGraph::shared_ptr linear = graph_.linearize(state_->values);
+  GaussianFactorGraph::shared_ptr linear = graph_.linearize(state_->values, params_.numThreads);
 
   // Pull out parameters we'll use
   const bool dlVerbose = (params_.verbosityDL > DoglegParams::SILENT);
@@ -92,19 +101,23 @@ GaussianFactorGraph::shared_ptr DoglegOptimizer::iterate(void) {
   // Do Dogleg iteration with either Multifrontal or Sequential elimination
   DoglegOptimizerImpl::IterationResult result;
 
+  // Trial steps only re-evaluate the factors on variables that moved
+  if (!errorEvaluator_.initialized())
+    errorEvaluator_.reset(state_->values);
+
   if ( params_.isMultifrontal() ) {
-    GaussianBayesTree bt = *linear->eliminateMultifrontal(*params_.ordering, params_.getEliminationFunction());
+    GaussianBayesTree bt = *junctionTree_.eliminate(*linear, params_.getEliminationFunction(), *params_.ordering);
     VectorValues dx_u = bt.optimizeGradientSearch();
     VectorValues dx_n = bt.optimize();
     result = DoglegOptimizerImpl::Iterate(getDelta(), DoglegOptimizerImpl::ONE_STEP_PER_ITERATION,
-      dx_u, dx_n, bt, graph_, state_->values, state_->error, dlVerbose);
+      dx_u, dx_n, bt, errorEvaluator_, state_->values, state_->error, dlVerbose);
   }
   else if ( params_.isSequential() ) {
     GaussianBayesNet bn = *linear->eliminateSequential(*params_.ordering, params_.getEliminationFunction());
     VectorValues dx_u = bn.optimizeGradientSearch();
     VectorValues dx_n = bn.optimize();
     result = DoglegOptimizerImpl::Iterate(getDelta(), DoglegOptimizerImpl::ONE_STEP_PER_ITERATION,
-      dx_u, dx_n, bn, graph_, state_->values, state_->error, dlVerbose);
+      dx_u, dx_n, bn, errorEvaluator_, state_->values, state_->error, dlVerbose);
   }
   else if ( params_.isIterative() ) {
     throw std::runtime_error("Dogleg is not currently compatible with the linear conjugate gradient solver");
@@ -116,6 +129,10 @@ GaussianFactorGraph::shared_ptr DoglegOptimizer::iterate(void) {
   // Maybe show output
   if(params_.verbosity >= NonlinearOptimizerParams::DELTA) result.dx_d.print("delta");
 
+  // The last trial step is the one taken, unless Dogleg gave up and zeroed it
+  if (result.dx_d.norm() > 0.0)
+    errorEvaluator_.accept();
+
   // Create new state with new values and new error
   state_.reset(new State(state_->values.retract(result.dx_d), result.f_error, result.delta,
                          state_->iterations + 1));
@@ -125,7 +142,7 @@ GaussianFactorGraph::shared_ptr DoglegOptimizer::iterate(void) {
 /* ************************************************************************* */
 DoglegParams DoglegOptimizer::ensureHasOrdering(DoglegParams params, const NonlinearFactorGraph& graph) const {
   if (!params.ordering)
-    params.ordering = Ordering::Create(params.orderingType, graph);
+    params.ordering = Ordering::Create(params.orderingType, graph, params.numThreads);
   return params;
 }
 
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <gtsam/nonlinear/NonlinearOptimizer.h>
+#include <gtsam/nonlinear/CachedErrorEvaluator.h>
 
 namespace gtsam {
 
@@ -70,6 +71,10 @@ class GTSAM_EXPORT DoglegOptimizer : public NonlinearOptimizer {
 protected:
   DoglegParams params_;
 
+  /// Per-factor errors at the current values, so trial steps only
+  /// re-evaluate the factors on variables that moved
+  CachedErrorEvaluator errorEvaluator_;
+
 public:
   typedef boost::shared_ptr<DoglegOptimizer> shared_ptr;
 
@@ -123,6 +128,9 @@ protected:
   /** Access the parameters (base class version) */
   virtual const NonlinearOptimizerParams& _params() const override { return params_; }
 
+  /// Re-evaluate all factors into errorEvaluator_ after refreshFactors()
+  double recomputeError() override;
+
   /** Internal function for computing a COLAMD ordering if no ordering is specified */
   DoglegParams ensureHasOrdering(DoglegParams params, const NonlinearFactorGraph& graph) const;
 };
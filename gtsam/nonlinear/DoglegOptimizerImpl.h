@@ -19,6 +19,7 @@
 #include <iomanip>
 
 #include <gtsam/linear/VectorValues.h>
+#include <gtsam/nonlinear/CachedErrorEvaluator.h>
 #include <gtsam/inference/Ordering.h>
 
 namespace gtsam {
@@ -130,6 +131,19 @@ struct GTSAM_EXPORT DoglegOptimizerImpl {
    * @param x_n Newton's method minimizer
    */
   static VectorValues ComputeBlend(double delta, const VectorValues& x_u, const VectorValues& x_n, const bool verbose=false);
+
+  /** Evaluate \c f at the trial point \c x_d, which is \c x0 retracted by
+   * \c dx_d.  The overload for CachedErrorEvaluator uses \c dx_d to only
+   * re-evaluate the factors on variables that moved.
+   */
+  template<class F, class VALUES>
+  static double TrialError(const F& f, const VALUES& x_d, const VectorValues& /*dx_d*/) {
+    return f.error(x_d);
+  }
+
+  static double TrialError(const CachedErrorEvaluator& f, const Values& x_d, const VectorValues& dx_d) {
+    return f.error(x_d, dx_d);
+  }
 };
 
 
@@ -163,7 +177,7 @@ typename DoglegOptimizerImpl::IterationResult DoglegOptimizerImpl::Iterate(
 
     gttic(decrease_in_f);
     // Compute decrease in f
-    result.f_error = f.error(x_d);
+    result.f_error = TrialError(f, x_d, result.dx_d);
     gttoc(decrease_in_f);
 
     gttic(new_M_error);
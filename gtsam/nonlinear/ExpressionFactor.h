@@ -111,29 +111,16 @@ protected:
           noiseModel_)->unit();
     }
 
-    // Create a writeable JacobianFactor in advance
-    boost::shared_ptr<JacobianFactor> factor(
-        new JacobianFactor(keys_, dims_, Dim, noiseModel));
-
-    // Wrap keys and VerticalBlockMatrix into structure passed to expression_
-    VerticalBlockMatrix& Ab = factor->matrixObject();
-    internal::JacobianMap jacobianMap(keys_, Ab);
-
-    // Zero out Jacobian so we can simply add to it
-    Ab.matrix().setZero();
-
-    // Get value and Jacobians, writing directly into JacobianFactor
-    T value = expression_.valueAndJacobianMap(x, jacobianMap); // <<< Reverse AD happens here !
-
-    // Evaluate error and set RHS vector b
-    Ab(size()).col(0) = traits<T>::Local(value, measured_);
-
-    // Whiten the corresponding system, Ab already contains RHS
-    if (noiseModel_) {
-      Vector b = Ab(size()).col(0);  // need b to be valid for Robust noise models
-      noiseModel_->WhitenSystem(Ab.matrix(), b);
+    // Create a writeable JacobianFactor in advance, or re-use the previous one
+    // that linearizeInto offered if it has the right structure
+    if (noiseModel) {
+      boost::shared_ptr<JacobianFactor> factor(
+          new JacobianFactor(keys_, dims_, Dim, noiseModel));
+      fillJacobian(x, factor->matrixObject());
+      return factor;
     }
-
+    boost::shared_ptr<GaussianFactor> factor = recycledLinearization();
+    fillJacobian(x, writableJacobian(factor, dims_.data(), Dim).matrixObject());
     return factor;
   }
 
@@ -147,6 +134,27 @@ protected:
  ExpressionFactor() {}
  /// Default constructor, for serialization
 
+ /// Write the whitened Jacobians and RHS of the linearization at x into Ab
+ void fillJacobian(const Values& x, VerticalBlockMatrix& Ab) const {
+   // Wrap keys and VerticalBlockMatrix into structure passed to expression_
+   internal::JacobianMap jacobianMap(keys_, Ab);
+
+   // Zero out Jacobian so we can simply add to it
+   Ab.matrix().setZero();
+
+   // Get value and Jacobians, writing directly into JacobianFactor
+   T value = expression_.valueAndJacobianMap(x, jacobianMap); // <<< Reverse AD happens here !
+
+   // Evaluate error and set RHS vector b
+   Ab(size()).col(0) = traits<T>::Local(value, measured_);
+
+   // Whiten the corresponding system, Ab already contains RHS
+   if (noiseModel_) {
+     Vector b = Ab(size()).col(0);  // need b to be valid for Robust noise models
+     noiseModel_->WhitenSystem(Ab.matrix(), b);
+   }
+ }
+
  /// Constructor for serializable derived classes
  ExpressionFactor(const SharedNoiseModel& noiseModel, const T& measurement)
      : NoiseModelFactor(noiseModel), measured_(measurement) {
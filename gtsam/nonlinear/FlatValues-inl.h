@@ -0,0 +1,183 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file FlatValues-inl.h
+ * @brief Template implementation of FlatValues and its typed storage
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/FlatValues.h> // Only so Eclipse finds class definition
+#include <gtsam/linear/VectorValues.h>
+
+namespace gtsam {
+
+  namespace internal {
+
+  /**
+   * Contiguous storage for all values of type T.  Elements are kept as
+   * GenericValue<T> so they can still be handed out as a Value reference,
+   * but all bulk operations below call the traits of T directly.
+   */
+  template<class T>
+  class TypedFlatValuesStorage : public FlatValuesStorage {
+  public:
+    typedef GenericValue<T> Element;
+    typedef std::vector<Element, Eigen::aligned_allocator<Element> > Elements;
+
+    Elements elements; ///< The values, in the same order as keys
+
+    TypedFlatValuesStorage() : FlatValuesStorage(true) {}
+
+    virtual const std::type_info& type() const { return typeid(Element); }
+
+    virtual shared_ptr clone() const {
+      return boost::make_shared<TypedFlatValuesStorage>(*this);
+    }
+
+    virtual const Value& value(size_t i) const { return elements[i]; }
+
+    virtual Value& value(size_t i) { return elements[i]; }
+
+    virtual void push_back(Key j, const Value& val) {
+      elements.push_back(static_cast<const Element&>(val));
+      keys.push_back(j);
+    }
+
+    virtual void assign(size_t i, const Value& val) {
+      // Value::operator= is the only public assignment of GenericValue
+      static_cast<Value&>(elements[i]) = val;
+    }
+
+    virtual void eraseSwap(size_t i) {
+      if (i + 1 != elements.size()) {
+        static_cast<Value&>(elements[i]) = elements.back();
+        keys[i] = keys.back();
+      }
+      elements.pop_back();
+      keys.pop_back();
+    }
+
+    virtual void reserve(size_t n) {
+      elements.reserve(n);
+      keys.reserve(n);
+    }
+
+    virtual size_t dim() const {
+      size_t result = 0;
+      for (const Element& element : elements)
+        result += traits<T>::GetDimension(element.value());
+      return result;
+    }
+
+    virtual void retractInPlace(const Updates& updates) {
+      for (const std::pair<size_t, const Vector*>& update : updates) {
+        T& value = elements[update.first].value();
+        value = traits<T>::Retract(value, *update.second);
+      }
+    }
+
+    virtual void localCoordinates(const FlatValuesStorage& other,
+        const std::vector<size_t>& indices, VectorValues& result) const {
+      // The other storage may hold the same type boxed, so go through its
+      // Value interface unless it is contiguous too
+      if (other.contiguous()) {
+        const TypedFlatValuesStorage& typedOther =
+            static_cast<const TypedFlatValuesStorage&>(other);
+        for (size_t i = 0; i < elements.size(); ++i)
+          result.insert(keys[i], traits<T>::Local(elements[i].value(),
+              typedOther.elements[indices[i]].value()));
+      } else {
+        for (size_t i = 0; i < elements.size(); ++i)
+          result.insert(keys[i], traits<T>::Local(elements[i].value(),
+              static_cast<const Element&>(other.value(indices[i])).value()));
+      }
+    }
+  };
+
+  } // namespace internal
+
+  /* ************************************************************************* */
+  template<typename ValueType>
+  ValueType FlatValues::at(Key j) const {
+    const Slot* slot = findSlot(j);
+    if (!slot)
+      throw ValuesKeyDoesNotExist("at", j);
+
+    // Fast path: exact type match, no dynamic_cast needed
+    const internal::FlatValuesStorage& storage = *storages_[slot->storage];
+    if (storage.contiguous() && storage.type() == typeid(GenericValue<ValueType>))
+      return static_cast<const internal::TypedFlatValuesStorage<ValueType>&>(
+          storage).elements[slot->index].value();
+
+    // Otherwise use the same conversion rules as Values
+    return internal::handle<ValueType>()(j, &storage.value(slot->index));
+  }
+
+  /* ************************************************************************* */
+  template<typename ValueType>
+  boost::optional<const ValueType&> FlatValues::exists(Key j) const {
+    const Slot* slot = findSlot(j);
+    if (!slot)
+      return boost::none;
+    const Value& value = slotValue(*slot);
+    try {
+      return dynamic_cast<const GenericValue<ValueType>&>(value).value();
+    } catch (std::bad_cast &) {
+      throw ValuesIncorrectType(j, typeid(value), typeid(ValueType));
+    }
+  }
+
+  /* ************************************************************************* */
+  template<typename ValueType>
+  void FlatValues::insert(Key j, const ValueType& val) {
+    // Check first, so a duplicate key does not leave a storage behind
+    if (exists(j))
+      throw ValuesKeyAlreadyExists(j);
+    reserve<ValueType>(0);
+    insertInto(findStorage(typeid(GenericValue<ValueType>)), j,
+        GenericValue<ValueType>(val));
+  }
+
+  /* ************************************************************************* */
+  template <typename ValueType>
+  void FlatValues::update(Key j, const ValueType& val) {
+    update(j, static_cast<const Value&>(GenericValue<ValueType>(val)));
+  }
+
+  /* ************************************************************************* */
+  template<class ValueType>
+  void FlatValues::reserve(size_t n) {
+    typedef internal::TypedFlatValuesStorage<ValueType> Storage;
+    const size_t s = findStorage(typeid(GenericValue<ValueType>));
+    if (s == storages_.size()) {
+      storages_.push_back(boost::make_shared<Storage>());
+    } else if (!storages_[s]->contiguous()) {
+      // Values of this type were inserted boxed before: move them into a
+      // contiguous storage, keeping the element order so slots stay valid.
+      boost::shared_ptr<Storage> typed = boost::make_shared<Storage>();
+      typed->reserve(storages_[s]->size() + n);
+      for (size_t i = 0; i < storages_[s]->size(); ++i)
+        typed->push_back(storages_[s]->keys[i], storages_[s]->value(i));
+      storages_[s] = typed;
+    }
+    storages_[s]->reserve(storages_[s]->size() + n);
+  }
+
+  /* ************************************************************************* */
+  template<class ValueType>
+  size_t FlatValues::count() const {
+    const size_t s = findStorage(typeid(GenericValue<ValueType>));
+    return s == storages_.size() ? 0 : storages_[s]->size();
+  }
+
+}
@@ -0,0 +1,430 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file FlatValues.cpp
+ * @brief A Values container with sorted keys and per-type contiguous storage
+ */
+
+#include <gtsam/nonlinear/FlatValues.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/config.h>  // for GTSAM_USE_TBB
+
+#include <iostream>
+
+using namespace std;
+
+namespace gtsam {
+
+  namespace internal {
+
+  /* ************************************************************************* */
+  // Storage for values of a type that was never announced with insert<T> or
+  // reserve<T>, and is not one of the common types below: we only know it as
+  // a Value, so we have to keep clones.
+  class BoxedFlatValuesStorage : public FlatValuesStorage {
+  private:
+    const std::type_info& type_;
+    std::vector<Value*> values_;
+
+  public:
+    explicit BoxedFlatValuesStorage(const std::type_info& type) :
+        FlatValuesStorage(false), type_(type) {
+    }
+
+    BoxedFlatValuesStorage(const BoxedFlatValuesStorage& other) :
+        FlatValuesStorage(other), type_(other.type_) {
+      values_.reserve(other.values_.size());
+      for (const Value* value : other.values_)
+        values_.push_back(value->clone_());
+    }
+
+    virtual ~BoxedFlatValuesStorage() {
+      for (const Value* value : values_)
+        value->deallocate_();
+    }
+
+    virtual const std::type_info& type() const { return type_; }
+
+    virtual shared_ptr clone() const {
+      return boost::make_shared<BoxedFlatValuesStorage>(*this);
+    }
+
+    virtual const Value& value(size_t i) const { return *values_[i]; }
+
+    virtual Value& value(size_t i) { return *values_[i]; }
+
+    virtual void push_back(Key j, const Value& val) {
+      values_.push_back(val.clone_());
+      keys.push_back(j);
+    }
+
+    virtual void assign(size_t i, const Value& val) {
+      *values_[i] = val;
+    }
+
+    virtual void eraseSwap(size_t i) {
+      values_[i]->deallocate_();
+      values_[i] = values_.back();
+      keys[i] = keys.back();
+      values_.pop_back();
+      keys.pop_back();
+    }
+
+    virtual void reserve(size_t n) {
+      values_.reserve(n);
+      keys.reserve(n);
+    }
+
+    virtual size_t dim() const {
+      size_t result = 0;
+      for (const Value* value : values_)
+        result += value->dim();
+      return result;
+    }
+
+    virtual void retractInPlace(const Updates& updates) {
+      // Assign in place, so that references to the values stay valid
+      for (const std::pair<size_t, const Vector*>& update : updates) {
+        Value* retracted = values_[update.first]->retract_(*update.second);
+        *values_[update.first] = *retracted;
+        retracted->deallocate_();
+      }
+    }
+
+    virtual void localCoordinates(const FlatValuesStorage& other,
+        const std::vector<size_t>& indices, VectorValues& result) const {
+      for (size_t i = 0; i < values_.size(); ++i)
+        result.insert(keys[i],
+            values_[i]->localCoordinates_(other.value(indices[i])));
+    }
+  };
+
+  /* ************************************************************************* */
+  // Storage for values of dynamic type \c type.  The value types most graphs
+  // use get a contiguous storage even when only known as a Value, e.g., when
+  // converting from a Values; any other type is boxed.
+  static FlatValuesStorage::shared_ptr makeStorage(const std::type_info& type) {
+    if (type == typeid(GenericValue<Pose3>))
+      return boost::make_shared<TypedFlatValuesStorage<Pose3> >();
+    if (type == typeid(GenericValue<Point3>))
+      return boost::make_shared<TypedFlatValuesStorage<Point3> >();
+    if (type == typeid(GenericValue<Rot3>))
+      return boost::make_shared<TypedFlatValuesStorage<Rot3> >();
+    if (type == typeid(GenericValue<Pose2>))
+      return boost::make_shared<TypedFlatValuesStorage<Pose2> >();
+    if (type == typeid(GenericValue<Point2>))
+      return boost::make_shared<TypedFlatValuesStorage<Point2> >();
+    if (type == typeid(GenericValue<Rot2>))
+      return boost::make_shared<TypedFlatValuesStorage<Rot2> >();
+    if (type == typeid(GenericValue<Vector>))
+      return boost::make_shared<TypedFlatValuesStorage<Vector> >();
+    if (type == typeid(GenericValue<double>))
+      return boost::make_shared<TypedFlatValuesStorage<double> >();
+    return boost::make_shared<BoxedFlatValuesStorage>(type);
+  }
+
+  } // namespace internal
+
+  /* ************************************************************************* */
+  FlatValues::FlatValues(const FlatValues& other) :
+      sorted_(other.sorted_), recent_(other.recent_) {
+    storages_.reserve(other.storages_.size());
+    for (const internal::FlatValuesStorage::shared_ptr& storage : other.storages_)
+      storages_.push_back(storage->clone());
+  }
+
+  /* ************************************************************************* */
+  FlatValues::FlatValues(FlatValues&& other) :
+      sorted_(std::move(other.sorted_)), recent_(std::move(other.recent_)),
+      storages_(std::move(other.storages_)) {
+  }
+
+  /* ************************************************************************* */
+  FlatValues::FlatValues(const Values& other) {
+    this->insert(other);
+  }
+
+  /* ************************************************************************* */
+  FlatValues::FlatValues(const FlatValues& other, const VectorValues& delta) :
+      FlatValues(other) {
+    retractInPlace(delta);
+  }
+
+  /* ************************************************************************* */
+  Values FlatValues::toValues() const {
+    Values result;
+    for (const ConstKeyValuePair& key_value : *this)
+      result.insert(key_value.key, key_value.value);
+    return result;
+  }
+
+  /* ************************************************************************* */
+  void FlatValues::print(const string& str, const KeyFormatter& keyFormatter) const {
+    cout << str << "FlatValues with " << size() << " values:" << endl;
+    for (const ConstKeyValuePair& key_value : *this) {
+      cout << "Value " << keyFormatter(key_value.key) << ": ";
+      key_value.value.print("");
+      cout << "\n";
+    }
+  }
+
+  /* ************************************************************************* */
+  bool FlatValues::equals(const FlatValues& other, double tol) const {
+    if (this->size() != other.size())
+      return false;
+    for (const_iterator it1 = begin(), it2 = other.begin(); it1 != end(); ++it1, ++it2) {
+      if (it1->key != it2->key)
+        return false;
+      const Value& value1 = it1->value;
+      const Value& value2 = it2->value;
+      if (typeid(value1) != typeid(value2) || !value1.equals_(value2, tol))
+        return false;
+    }
+    return true;
+  }
+
+  /* ************************************************************************* */
+  const Value& FlatValues::at(Key j) const {
+    const Slot* slot = findSlot(j);
+    if (!slot)
+      throw ValuesKeyDoesNotExist("retrieve", j);
+    return slotValue(*slot);
+  }
+
+  /* ************************************************************************* */
+  FlatValues FlatValues::retract(const VectorValues& delta) const {
+    return FlatValues(*this, delta);
+  }
+
+  /* ************************************************************************* */
+  void FlatValues::retractInPlace(const VectorValues& delta) {
+    // Collect the updates of each storage, so that each runs a single loop
+    vector<internal::FlatValuesStorage::Updates> updates(storages_.size());
+    for (const Index* index : {&sorted_, &recent_}) {
+#ifdef GTSAM_USE_TBB
+      // With TBB, VectorValues is a hash map, so look up every key
+      for (size_t i = 0; i < index->size(); ++i) {
+        VectorValues::const_iterator it = delta.find(index->keys[i]);
+        if (it != delta.end())
+          updates[index->slots[i].storage].push_back(
+              make_pair(index->slots[i].index, &it->second));
+      }
+#else
+      // Both the index and delta are sorted by key, so walk them together
+      size_t i = 0;
+      for (VectorValues::const_iterator it = delta.begin();
+          it != delta.end() && i < index->size(); ++it) {
+        while (i < index->size() && index->keys[i] < it->first)
+          ++i;
+        if (i < index->size() && index->keys[i] == it->first) {
+          updates[index->slots[i].storage].push_back(
+              make_pair(index->slots[i].index, &it->second));
+          ++i;
+        }
+      }
+#endif
+    }
+    for (size_t s = 0; s < storages_.size(); ++s)
+      if (!updates[s].empty())
+        storages_[s]->retractInPlace(updates[s]);
+  }
+
+  /* ************************************************************************* */
+  VectorValues FlatValues::localCoordinates(const FlatValues& cp) const {
+    if (this->size() != cp.size())
+      throw DynamicValuesMismatched();
+    VectorValues result;
+    vector<size_t> indices;
+    for (const internal::FlatValuesStorage::shared_ptr& storage : storages_) {
+      // Find, for every element of this storage, where it lives in cp
+      size_t otherStorage = cp.storages_.size();
+      indices.resize(storage->size());
+      for (size_t k = 0; k < storage->size(); ++k) {
+        const Slot* slot = cp.findSlot(storage->keys[k]);
+        if (!slot)
+          throw DynamicValuesMismatched();
+        if (otherStorage == cp.storages_.size())
+          otherStorage = slot->storage;
+        if (slot->storage != otherStorage)
+          throw DynamicValuesMismatched();
+        indices[k] = slot->index;
+      }
+      if (storage->size() == 0)
+        continue;
+      if (cp.storages_[otherStorage]->type() != storage->type())
+        throw DynamicValuesMismatched();
+      storage->localCoordinates(*cp.storages_[otherStorage], indices, result);
+    }
+    return result;
+  }
+
+  /* ************************************************************************* */
+  size_t FlatValues::findStorage(const std::type_info& type) const {
+    for (size_t s = 0; s < storages_.size(); ++s)
+      if (storages_[s]->type() == type)
+        return s;
+    return storages_.size();
+  }
+
+  /* ************************************************************************* */
+  void FlatValues::insertInto(size_t s, Key j, const Value& val) {
+    internal::FlatValuesStorage& storage = *storages_[s];
+    const Slot slot(s, storage.size());
+    storage.push_back(j, val);
+
+    // Appending in key order is the common case.  Other keys go into the
+    // small recent_ index, merged into sorted_ once it grows beyond
+    // sqrt(size()), so that each insertion only moves O(sqrt(n)) keys.
+    if (sorted_.size() == 0 || sorted_.keys.back() < j) {
+      sorted_.keys.push_back(j);
+      sorted_.slots.push_back(slot);
+    } else {
+      recent_.insert(recent_.lowerBound(j), j, slot);
+      if (recent_.size() * recent_.size() > sorted_.size())
+        mergeRecent();
+    }
+  }
+
+  /* ************************************************************************* */
+  void FlatValues::mergeRecent() {
+    // Merge from the back, so that every key is moved once
+    size_t i = sorted_.size(), k = recent_.size(), out = i + k;
+    sorted_.keys.resize(out);
+    sorted_.slots.resize(out, Slot(0, 0));
+    while (k > 0) {
+      --out;
+      if (i > 0 && sorted_.keys[i - 1] > recent_.keys[k - 1]) {
+        --i;
+        sorted_.keys[out] = sorted_.keys[i];
+        sorted_.slots[out] = sorted_.slots[i];
+      } else {
+        --k;
+        sorted_.keys[out] = recent_.keys[k];
+        sorted_.slots[out] = recent_.slots[k];
+      }
+    }
+    recent_.clear();
+  }
+
+  /* ************************************************************************* */
+  void FlatValues::insert(Key j, const Value& val) {
+    // Check first, so a duplicate key does not leave a storage behind
+    if (exists(j))
+      throw ValuesKeyAlreadyExists(j);
+    size_t s = findStorage(typeid(val));
+    if (s == storages_.size())
+      storages_.push_back(internal::makeStorage(typeid(val)));
+    insertInto(s, j, val);
+  }
+
+  /* ************************************************************************* */
+  void FlatValues::insert(const FlatValues& values) {
+    for (const ConstKeyValuePair& key_value : values)
+      insert(key_value.key, key_value.value);
+  }
+
+  /* ************************************************************************* */
+  void FlatValues::insert(const Values& values) {
+    sorted_.keys.reserve(sorted_.size() + values.size());
+    sorted_.slots.reserve(sorted_.size() + values.size());
+    for (Values::const_iterator key_value = values.begin(); key_value != values.end(); ++key_value)
+      insert(key_value->key, key_value->value);
+  }
+
+  /* ************************************************************************* */
+  void FlatValues::update(Key j, const Value& val) {
+    const Slot* slot = findSlot(j);
+    if (!slot)
+      throw ValuesKeyDoesNotExist("update", j);
+
+    const Value& old_value = slotValue(*slot);
+    if (typeid(old_value) != typeid(val))
+      throw ValuesIncorrectType(j, typeid(old_value), typeid(val));
+
+    storages_[slot->storage]->assign(slot->index, val);
+  }
+
+  /* ************************************************************************* */
+  void FlatValues::update(const FlatValues& values) {
+    for (const ConstKeyValuePair& key_value : values)
+      update(key_value.key, key_value.value);
+  }
+
+  /* ************************************************************************* */
+  void FlatValues::erase(Key j) {
+    Index* index = &sorted_;
+    size_t i = sorted_.find(j);
+    if (i == sorted_.size()) {
+      index = &recent_;
+      i = recent_.find(j);
+      if (i == recent_.size())
+        throw ValuesKeyDoesNotExist("erase", j);
+    }
+    const Slot slot = index->slots[i];
+    index->erase(i);
+
+    // Move the last element of the storage into the hole, and fix its slot
+    internal::FlatValuesStorage& storage = *storages_[slot.storage];
+    storage.eraseSwap(slot.index);
+    if (slot.index < storage.size())
+      findSlot(storage.keys[slot.index])->index = slot.index;
+  }
+
+  /* ************************************************************************* */
+  KeyVector FlatValues::keys() const {
+    KeyVector result;
+    result.reserve(size());
+    for (const ConstKeyValuePair& key_value : *this)
+      result.push_back(key_value.key);
+    return result;
+  }
+
+  /* ************************************************************************* */
+  FlatValues& FlatValues::operator=(const FlatValues& rhs) {
+    FlatValues copy(rhs);
+    this->swap(copy);
+    return *this;
+  }
+
+  /* ************************************************************************* */
+  void FlatValues::swap(FlatValues& other) {
+    sorted_.swap(other.sorted_);
+    recent_.swap(other.recent_);
+    storages_.swap(other.storages_);
+  }
+
+  /* ************************************************************************* */
+  void FlatValues::clear() {
+    sorted_.clear();
+    recent_.clear();
+    storages_.clear();
+  }
+
+  /* ************************************************************************* */
+  size_t FlatValues::dim() const {
+    size_t result = 0;
+    for (const internal::FlatValuesStorage::shared_ptr& storage : storages_)
+      result += storage->dim();
+    return result;
+  }
+
+  /* ************************************************************************* */
+  VectorValues FlatValues::zeroVectors() const {
+    VectorValues result;
+    for (const ConstKeyValuePair& key_value : *this)
+      result.insert(key_value.key, Vector::Zero(key_value.value.dim()));
+    return result;
+  }
+
+}
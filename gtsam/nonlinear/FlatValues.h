@@ -0,0 +1,462 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file FlatValues.h
+ * @brief A Values container with sorted keys and per-type contiguous storage
+ *
+ *  Detailed story:
+ *  Values stores every variable as a separately allocated Value in a tree,
+ *  so every lookup is a tree search and every retract is a virtual call plus
+ *  an allocation per key.  FlatValues stores a sorted array of keys, and all
+ *  values of the same type packed together in one contiguous array.  Lookups
+ *  are binary searches in the key array, and retract/localCoordinates run
+ *  one tight, non-virtual loop per type.  Factors, graphs and optimizers
+ *  still take a Values: FlatValues is for code that keeps a large set of
+ *  values of its own.
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/Values.h>
+
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace gtsam {
+
+  namespace internal {
+
+  /**
+   * Type-erased interface to one contiguous array of values in a FlatValues.
+   * Each storage also keeps the key of each element, so that bulk operations
+   * can run over the array without going back to the FlatValues key index.
+   */
+  class GTSAM_EXPORT FlatValuesStorage {
+  public:
+    typedef boost::shared_ptr<FlatValuesStorage> shared_ptr;
+
+    KeyVector keys; ///< The key of each element, in storage order
+
+    /// @param contiguous whether this is a TypedFlatValuesStorage
+    explicit FlatValuesStorage(bool contiguous) : contiguous_(contiguous) {}
+
+    virtual ~FlatValuesStorage() {}
+
+    /// True if the elements are stored in a TypedFlatValuesStorage
+    bool contiguous() const { return contiguous_; }
+
+    /// The dynamic type of the Value objects held in this storage
+    virtual const std::type_info& type() const = 0;
+
+    /// Deep copy
+    virtual shared_ptr clone() const = 0;
+
+    /// Access element \c i as a Value
+    virtual const Value& value(size_t i) const = 0;
+
+    /// Access element \c i as a Value
+    virtual Value& value(size_t i) = 0;
+
+    /// Append a value with key \c j, \c val must have dynamic type type()
+    virtual void push_back(Key j, const Value& val) = 0;
+
+    /// Overwrite element \c i, \c val must have dynamic type type()
+    virtual void assign(size_t i, const Value& val) = 0;
+
+    /// Remove element \c i by moving the last element into its place
+    virtual void eraseSwap(size_t i) = 0;
+
+    /// Reserve space for \c n elements
+    virtual void reserve(size_t n) = 0;
+
+    /// Total dimension of all elements
+    virtual size_t dim() const = 0;
+
+    /// Elements to retract, each with its update
+    typedef std::vector<std::pair<size_t, const Vector*> > Updates;
+
+    /// Retract each element \c updates[k].first by \c *updates[k].second, in place
+    virtual void retractInPlace(const Updates& updates) = 0;
+
+    /// Insert local coordinates from element i to other.value(indices[i]) into \c result
+    virtual void localCoordinates(const FlatValuesStorage& other,
+        const std::vector<size_t>& indices, VectorValues& result) const = 0;
+
+    /// Number of elements
+    size_t size() const { return keys.size(); }
+
+  private:
+    bool contiguous_;
+  };
+
+  template<class T> class TypedFlatValuesStorage;
+
+  } // namespace internal
+
+  /**
+   * A container of values with flat storage:  a sorted array of keys, and one
+   * contiguous array per value type (e.g., all Pose3 packed together).  Its
+   * interface follows the one of Values, and it converts to and from it, but
+   * it is not a Values: factors, graphs and optimizers read from a Values
+   * during linearize and retract.  Use it for code that stores, looks up and
+   * retracts many values itself, and convert at the boundary with toValues()
+   * and FlatValues(const Values&).
+   *
+   * Values inserted with the templated insert<T>, or whose type was announced
+   * with reserve<T>, go into a contiguous array of GenericValue<T>.  So do
+   * values of the common types Pose3, Point3, Rot3, Pose2, Point2, Rot2,
+   * Vector and double, however they are inserted, including when converting
+   * from a Values.  Values of any other type inserted through the type-erased
+   * insert(Key, const Value&) are stored boxed, one allocation each, exactly
+   * like in Values, until announced with reserve<T>.
+   *
+   * Keys inserted in increasing order (as when copying from a Values) are
+   * appended to the sorted key array.  Other keys, e.g. interleaved x and l
+   * Symbols, go into a second sorted array that is merged into the first
+   * once it holds more than about sqrt(n) keys, so n insertions in any order
+   * cost O(n sqrt(n)).  Erasing a key costs O(n).
+   *
+   * Unlike with Values, references returned by at(Key) and by iterators point
+   * into these arrays, so they are invalidated by insert, erase and reserve.
+   * Update and retractInPlace change values where they are, and keep them
+   * valid.
+   */
+  class GTSAM_EXPORT FlatValues {
+
+  private:
+
+    /// Location of a value: which storage, and which element within it
+    struct Slot {
+      size_t storage;
+      size_t index;
+      Slot(size_t _storage, size_t _index) : storage(_storage), index(_index) {}
+    };
+
+    /// Sorted keys, and the location of the value of each key
+    struct Index {
+      KeyVector keys;
+      std::vector<Slot> slots;
+
+      size_t size() const { return keys.size(); }
+
+      size_t lowerBound(Key j) const {
+        return std::lower_bound(keys.begin(), keys.end(), j) - keys.begin();
+      }
+
+      /// Position of j, or size() if it does not exist
+      size_t find(Key j) const {
+        const size_t i = lowerBound(j);
+        return (i != size() && keys[i] == j) ? i : size();
+      }
+
+      void insert(size_t i, Key j, const Slot& slot) {
+        keys.insert(keys.begin() + i, j);
+        slots.insert(slots.begin() + i, slot);
+      }
+
+      void erase(size_t i) {
+        keys.erase(keys.begin() + i);
+        slots.erase(slots.begin() + i);
+      }
+
+      void clear() {
+        keys.clear();
+        slots.clear();
+      }
+
+      void swap(Index& other) {
+        keys.swap(other.keys);
+        slots.swap(other.slots);
+      }
+    };
+
+    Index sorted_;  ///< Keys inserted in increasing order, and merged recent_
+    Index recent_;  ///< Keys inserted out of order since the last merge
+    std::vector<internal::FlatValuesStorage::shared_ptr> storages_; ///< One per type
+
+    /**
+     * Forward iterator over all keys in increasing order, merging sorted_ and
+     * recent_: it is at element i of sorted_ and element k of recent_, and
+     * points to the one with the smaller key.
+     */
+    template<class FLAT_VALUES, class KEY_VALUE_PAIR>
+    class MergingIterator : public boost::iterator_facade<
+        MergingIterator<FLAT_VALUES, KEY_VALUE_PAIR>, KEY_VALUE_PAIR,
+        boost::forward_traversal_tag, KEY_VALUE_PAIR> {
+    public:
+      MergingIterator() : values_(0), i_(0), k_(0) {}
+      MergingIterator(FLAT_VALUES* values, size_t i, size_t k) :
+          values_(values), i_(i), k_(k) {}
+
+    private:
+      friend class boost::iterator_core_access;
+
+      KEY_VALUE_PAIR dereference() const {
+        if (values_->inRecent(i_, k_))
+          return KEY_VALUE_PAIR(values_->recent_.keys[k_],
+              values_->slotValue(values_->recent_.slots[k_]));
+        return KEY_VALUE_PAIR(values_->sorted_.keys[i_],
+            values_->slotValue(values_->sorted_.slots[i_]));
+      }
+
+      void increment() {
+        if (values_->inRecent(i_, k_))
+          ++k_;
+        else
+          ++i_;
+      }
+
+      bool equal(const MergingIterator& other) const {
+        return i_ == other.i_ && k_ == other.k_;
+      }
+
+      FLAT_VALUES* values_;
+      size_t i_, k_;
+    };
+
+  public:
+
+    /// A shared_ptr to this class
+    typedef boost::shared_ptr<FlatValues> shared_ptr;
+
+    /// A const shared_ptr to this class
+    typedef boost::shared_ptr<const FlatValues> const_shared_ptr;
+
+    /// Key-value pairs are the same as the ones of Values
+    typedef Values::KeyValuePair KeyValuePair;
+    typedef Values::ConstKeyValuePair ConstKeyValuePair;
+
+    /// Mutable forward iterator, with value type KeyValuePair
+    typedef MergingIterator<FlatValues, KeyValuePair> iterator;
+
+    /// Const forward iterator, with value type ConstKeyValuePair
+    typedef MergingIterator<const FlatValues, ConstKeyValuePair> const_iterator;
+
+    typedef KeyValuePair value_type;
+
+    /** Default constructor creates an empty FlatValues class */
+    FlatValues() {}
+
+    /** Copy constructor duplicates all keys and values */
+    FlatValues(const FlatValues& other);
+
+    /** Move constructor */
+    FlatValues(FlatValues&& other);
+
+    /** Construct from a Values, copying all keys and values */
+    explicit FlatValues(const Values& other);
+
+    /** Construct from a FlatValues and an update vector: identical to other.retract(delta) */
+    FlatValues(const FlatValues& other, const VectorValues& delta);
+
+    /** Copy all keys and values into a Values */
+    Values toValues() const;
+
+    /// @name Testable
+    /// @{
+
+    /** print method for testing and debugging */
+    void print(const std::string& str = "", const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
+
+    /** Test whether the sets of keys and values are identical */
+    bool equals(const FlatValues& other, double tol=1e-9) const;
+
+    /// @}
+
+    /** Retrieve a variable by key \c j, see Values::at<ValueType> */
+    template<typename ValueType>
+    ValueType at(Key j) const;
+
+    /** Retrieve a variable by key \c j as a reference to the base Value
+     * class.  The reference is invalidated by the next insert, erase or
+     * reserve. */
+    const Value& at(Key j) const;
+
+    /** Check if a value exists with key \c j */
+    bool exists(Key j) const { return findSlot(j) != 0; }
+
+    /** Check if a value with key \c j exists, returns the value with type
+     * \c Value if the key does exist, or boost::none if it does not exist.
+     * Throws ValuesIncorrectType if the value type associated with the
+     * requested key does not match the stored value type. */
+    template<typename ValueType>
+    boost::optional<const ValueType&> exists(Key j) const;
+
+    /** Find an element by key, returning an iterator, or end() if the key was
+     * not found. */
+    iterator find(Key j) { return exists(j) ? lower_bound(j) : end(); }
+
+    /** Find an element by key, returning an iterator, or end() if the key was
+     * not found. */
+    const_iterator find(Key j) const { return exists(j) ? lower_bound(j) : end(); }
+
+    /** Find the element greater than or equal to the specified key. */
+    iterator lower_bound(Key j) {
+      return iterator(this, sorted_.lowerBound(j), recent_.lowerBound(j));
+    }
+
+    /** Find the element greater than or equal to the specified key. */
+    const_iterator lower_bound(Key j) const {
+      return const_iterator(this, sorted_.lowerBound(j), recent_.lowerBound(j));
+    }
+
+    /** Find the lowest-ordered element greater than the specified key. */
+    iterator upper_bound(Key j) {
+      return j == std::numeric_limits<Key>::max() ? end() : lower_bound(j + 1);
+    }
+
+    /** Find the lowest-ordered element greater than the specified key. */
+    const_iterator upper_bound(Key j) const {
+      return j == std::numeric_limits<Key>::max() ? end() : lower_bound(j + 1);
+    }
+
+    /** The number of variables in this config */
+    size_t size() const { return sorted_.size() + recent_.size(); }
+
+    /** whether the config is empty */
+    bool empty() const { return size() == 0; }
+
+    const_iterator begin() const { return const_iterator(this, 0, 0); }
+    const_iterator end() const {
+      return const_iterator(this, sorted_.size(), recent_.size());
+    }
+    iterator begin() { return iterator(this, 0, 0); }
+    iterator end() { return iterator(this, sorted_.size(), recent_.size()); }
+
+    /// @name Manifold Operations
+    /// @{
+
+    /** Add a delta config to current config and returns a new config */
+    FlatValues retract(const VectorValues& delta) const;
+
+    /** Add a delta config to current config in place, equivalent to
+     *  *this = retract(delta), but values without a delta are not copied.
+     *  As in retract, keys in \c delta that are not in this config are ignored. */
+    void retractInPlace(const VectorValues& delta);
+
+    /** Get a delta config about a linearization point c0 (*this) */
+    VectorValues localCoordinates(const FlatValues& cp) const;
+
+    ///@}
+
+    /** Add a variable with the given j, throws ValuesKeyAlreadyExists if j is already present */
+    void insert(Key j, const Value& val);
+
+    /** Add a set of variables, throws ValuesKeyAlreadyExists if a key is already present */
+    void insert(const FlatValues& values);
+
+    /** Add a set of variables, throws ValuesKeyAlreadyExists if a key is already present */
+    void insert(const Values& values);
+
+    /** Templated version to add a variable with the given j, stored contiguously
+     * with all other values of type \c ValueType.
+     * Throws ValuesKeyAlreadyExists if j is already present.
+     */
+    template <typename ValueType>
+    void insert(Key j, const ValueType& val);
+
+    /** single element change of existing element */
+    void update(Key j, const Value& val);
+
+    /** Templated version to update a variable with the given j */
+    template <typename T>
+    void update(Key j, const T& val);
+
+    /** update the current available values without adding new ones */
+    void update(const FlatValues& values);
+
+    /** Remove a variable from the config, throws ValuesKeyDoesNotExist if j is not present */
+    void erase(Key j);
+
+    /** Returns the (ordered) set of keys in the config */
+    KeyVector keys() const;
+
+    /** Replace all keys and variables */
+    FlatValues& operator=(const FlatValues& rhs);
+
+    /** Swap the contents of two FlatValues without copying data */
+    void swap(FlatValues& other);
+
+    /** Remove all variables from the config */
+    void clear();
+
+    /** Compute the total dimensionality of all values */
+    size_t dim() const;
+
+    /** Return a VectorValues of zero vectors for each variable in this FlatValues */
+    VectorValues zeroVectors() const;
+
+    /** Create the contiguous storage for \c ValueType, if needed, and reserve
+     * room for \c n values of that type.  Values of type \c ValueType inserted
+     * later through insert(Key, const Value&) then also go into that storage. */
+    template<class ValueType>
+    void reserve(size_t n);
+
+    /** Count values of given type \c ValueType */
+    template<class ValueType>
+    size_t count() const;
+
+  private:
+
+    /// Whether the element after element i of sorted_ and element k of
+    /// recent_, in key order, is the one in recent_
+    bool inRecent(size_t i, size_t k) const {
+      return k < recent_.size() &&
+          (i == sorted_.size() || recent_.keys[k] < sorted_.keys[i]);
+    }
+
+    /// Location of the value with key j, or null if it does not exist
+    const Slot* findSlot(Key j) const {
+      size_t i = sorted_.find(j);
+      if (i != sorted_.size())
+        return &sorted_.slots[i];
+      i = recent_.find(j);
+      return i != recent_.size() ? &recent_.slots[i] : 0;
+    }
+
+    Slot* findSlot(Key j) {
+      return const_cast<Slot*>(static_cast<const FlatValues*>(this)->findSlot(j));
+    }
+
+    /// Index into storages_ of the storage holding \c type, or storages_.size()
+    size_t findStorage(const std::type_info& type) const;
+
+    /// Value at a slot
+    const Value& slotValue(const Slot& slot) const {
+      return storages_[slot.storage]->value(slot.index);
+    }
+
+    Value& slotValue(const Slot& slot) {
+      return storages_[slot.storage]->value(slot.index);
+    }
+
+    /// Append val to storage s and index it under j, which must not exist
+    void insertInto(size_t s, Key j, const Value& val);
+
+    /// Merge recent_ into sorted_
+    void mergeRecent();
+  };
+
+  /// traits
+  template<>
+  struct traits<FlatValues> : public Testable<FlatValues> {
+  };
+
+} //\ namespace gtsam
+
+#include <gtsam/nonlinear/FlatValues-inl.h>
@@ -30,7 +30,8 @@ GaussNewtonOptimizer::GaussNewtonOptimizer(const NonlinearFactorGraph& graph,
                                            const Values& initialValues,
                                            const GaussNewtonParams& params)
     : NonlinearOptimizer(
-          graph, std::unique_ptr<State>(new State(initialValues, graph.error(initialValues)))),
+          graph, std::unique_ptr<State>(new State(
+                     initialValues, graph.error(initialValues, params.numThreads)))),
       params_(ensureHasOrdering(params, graph)) {}
 
 GaussNewtonOptimizer::GaussNewtonOptimizer(const NonlinearFactorGraph& graph,
@@ -46,7 +47,7 @@ GaussianFactorGraph::shared_ptr GaussNewtonOptimizer::iterate() {
 
   // Linearize graph
   gttic(GaussNewtonOptimizer_Linearize);
-  GaussianFactorGraph::shared_ptr linear = graph_.linearize(state_->values);
+  GaussianFactorGraph::shared_ptr linear = linearizeInPlace();
   gttoc(GaussNewtonOptimizer_Linearize);
 
   // Solve Factor Graph
@@ -60,7 +61,8 @@ GaussianFactorGraph::shared_ptr GaussNewtonOptimizer::iterate() {
 
   // Create new state with new values and new error
   Values newValues = state_->values.retract(delta);
-  state_.reset(new State(std::move(newValues), graph_.error(newValues), state_->iterations + 1));
+  state_.reset(new State(std::move(newValues), graph_.error(newValues, params_.numThreads),
+                         state_->iterations + 1));
 
   return linear;
 }
@@ -69,7 +71,7 @@ GaussianFactorGraph::shared_ptr GaussNewtonOptimizer::iterate() {
 GaussNewtonParams GaussNewtonOptimizer::ensureHasOrdering(
     GaussNewtonParams params, const NonlinearFactorGraph& graph) const {
   if (!params.ordering)
-    params.ordering = Ordering::Create(params.orderingType, graph);
+    params.ordering = Ordering::Create(params.orderingType, graph, params.numThreads);
   return params;
 }
 
@@ -17,15 +17,20 @@
  * @author  Richard Roberts
  */
 
+#include <gtsam/base/ThreadPool.h>
 #include <gtsam/base/debug.h>
 #include <gtsam/config.h>            // for GTSAM_USE_TBB
 #include <gtsam/inference/Symbol.h>  // for selective linearization thresholds
 #include <gtsam/nonlinear/ISAM2-impl.h>
 
 #include <boost/range/adaptors.hpp>
+#include <deque>
 #include <functional>
 #include <limits>
+#include <mutex>
+#include <numeric>
 #include <string>
+#include <vector>
 
 using namespace std;
 
@@ -177,36 +182,130 @@ KeySet ISAM2::Impl::CheckRelinearizationPartial(
 
 /* ************************************************************************* */
 namespace internal {
+/// Problems with fewer variables are always back-substituted serially
+static const size_t kMinParallelBackSubstitution = 1000;
+
+inline static void backSubstitute(const ISAM2::sharedClique& clique,
+                                  VectorValues* result) {
+  // parents are assumed to already be solved and available in result, assign
+  // through at() so that different subtrees can be solved concurrently
+  const VectorValues solution = clique->conditional()->solve(*result);
+  for (const auto& key_value : solution)
+    result->at(key_value.first) = key_value.second;
+}
+
 inline static void optimizeInPlace(const ISAM2::sharedClique& clique,
                                    VectorValues* result) {
-  // parents are assumed to already be solved and available in result
-  result->update(clique->conditional()->solve(*result));
+  backSubstitute(clique, result);
 
   // starting from the root, call optimize on each conditional
   for (const ISAM2::sharedClique& child : clique->children)
     optimizeInPlace(child, result);
 }
+
+/**
+ * Back-substitute in parallel: cliques are visited breadth-first in the
+ * calling thread with \c visitTop, which returns whether to continue with the
+ * children, until there are enough subtrees left to keep all threads busy.
+ * These are then processed in parallel with \c visitSubtree, which returns a
+ * count.  Returns the sum of these counts.
+ */
+template <class ROOTS, class VISIT_TOP, class VISIT_SUBTREE>
+size_t parallelBackSubstitute(const ROOTS& roots, ThreadPool& pool,
+                              VISIT_TOP visitTop, VISIT_SUBTREE visitSubtree) {
+  std::deque<ISAM2::sharedClique> frontier(roots.begin(), roots.end());
+  const size_t enough = 4 * pool.numThreads();
+  while (!frontier.empty() && frontier.size() < enough) {
+    const ISAM2::sharedClique clique = frontier.front();
+    frontier.pop_front();
+    if (visitTop(clique))
+      frontier.insert(frontier.end(), clique->children.begin(),
+                      clique->children.end());
+  }
+
+  const std::vector<ISAM2::sharedClique> subtrees(frontier.begin(),
+                                                  frontier.end());
+  std::vector<size_t> counts(subtrees.size(), 0);
+  pool.parallelFor(subtrees.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) counts[i] = visitSubtree(subtrees[i]);
+  });
+  return std::accumulate(counts.begin(), counts.end(), size_t(0));
+}
 }  // namespace internal
 
 /* ************************************************************************* */
 size_t ISAM2::Impl::UpdateGaussNewtonDelta(const ISAM2::Roots& roots,
                                            const KeySet& replacedKeys,
                                            double wildfireThreshold,
-                                           VectorValues* delta) {
+                                           VectorValues* delta,
+                                           size_t numThreads,
+                                           KeySet* changedKeys) {
   size_t lastBacksubVariableCount;
+  ThreadPool& pool = ThreadPool::Shared(numThreads);
+  const bool parallel = pool.numThreads() > 1 &&
+                        delta->size() >= internal::kMinParallelBackSubstitution;
 
   if (wildfireThreshold <= 0.0) {
     // Threshold is zero or less, so do a full recalculation
-    for (const ISAM2::sharedClique& root : roots)
-      internal::optimizeInPlace(root, delta);
+    if (parallel) {
+      internal::parallelBackSubstitute(
+          roots, pool,
+          [delta](const ISAM2::sharedClique& clique) {
+            internal::backSubstitute(clique, delta);
+            return true;
+          },
+          [delta](const ISAM2::sharedClique& clique) {
+            internal::optimizeInPlace(clique, delta);
+            return size_t(0);
+          });
+    } else {
+      for (const ISAM2::sharedClique& root : roots)
+        internal::optimizeInPlace(root, delta);
+    }
     lastBacksubVariableCount = delta->size();
+    if (changedKeys)
+      for (const VectorValues::KeyValuePair& key_delta : *delta)
+        changedKeys->insert(key_delta.first);
 
   } else {
     // Optimize with wildfire
     lastBacksubVariableCount = 0;
-    for (const ISAM2::sharedClique& root : roots)
-      lastBacksubVariableCount += optimizeWildfireNonRecursive(
-          root, wildfireThreshold, replacedKeys, delta);  // modifies delta
+    if (parallel) {
+      // Variables in the top of the tree that changed significantly
+      KeySet changed;
+      size_t topCount = 0;
+      std::mutex changedMutex;  // Protects changedKeys
+      const size_t subtreeCount = internal::parallelBackSubstitute(
+          roots, pool,
+          [&](const ISAM2::sharedClique& clique) {
+            return clique->optimizeWildfireNode(replacedKeys, wildfireThreshold,
+                                                &changed, delta, &topCount);
+          },
+          [&](const ISAM2::sharedClique& clique) {
+            // By the running intersection property, the only variables from
+            // the top a subtree depends on are in the separator of its root
+            KeySet changedAbove;
+            for (Key parent : clique->conditional()->parents())
+              if (changed.exists(parent)) changedAbove.insert(parent);
+            const size_t count = optimizeWildfireNonRecursive(
+                clique, wildfireThreshold, replacedKeys, &changedAbove, delta);
+            if (changedKeys) {
+              std::lock_guard<std::mutex> lock(changedMutex);
+              changedKeys->insert(changedAbove.begin(), changedAbove.end());
+            }
+            return count;
+          });
+      lastBacksubVariableCount = topCount + subtreeCount;
+      if (changedKeys) changedKeys->insert(changed.begin(), changed.end());
+    } else {
+      // Deltas are only modified in cliques marked as changed
+      KeySet changed;
+      for (const ISAM2::sharedClique& root : roots)
+        lastBacksubVariableCount += optimizeWildfireNonRecursive(
+            root, wildfireThreshold, replacedKeys, &changed,
+            delta);  // modifies delta
+      if (changedKeys) changedKeys->insert(changed.begin(), changed.end());
+    }
 
 #if !defined(NDEBUG) && defined(GTSAM_EXTRA_CONSISTENCY_CHECKS)
     for (VectorValues::const_iterator key_delta = delta->begin();
@@ -67,10 +67,14 @@ struct GTSAM_EXPORT ISAM2::Impl {
     const VectorValues& delta, const ISAM2Params::RelinearizationThreshold& relinearizeThreshold);
 
   /**
-   * Update the Newton's method step point, using wildfire
+   * Update the Newton's method step point, using wildfire.  For large
+   * problems and \c numThreads other than 1, independent subtrees are
+   * back-substituted in parallel with the built-in ThreadPool.  If given,
+   * the keys whose delta may have changed are added to \c changedKeys.
    */
   static size_t UpdateGaussNewtonDelta(const ISAM2::Roots& roots,
-      const KeySet& replacedKeys, double wildfireThreshold, VectorValues* delta);
+      const KeySet& replacedKeys, double wildfireThreshold, VectorValues* delta,
+      size_t numThreads = 1, KeySet* changedKeys = nullptr);
 
   /**
    * Update the RgProd (R*g) incrementally taking into account which variables
@@ -18,13 +18,19 @@
 
 #include <gtsam/nonlinear/ISAM2.h>
 
+#include <gtsam/base/ThreadPool.h>
 #include <gtsam/base/debug.h>
 #include <gtsam/base/timing.h>
+#include <gtsam/config.h>  // for GTSAM_USE_TBB
 #include <gtsam/inference/BayesTree-inst.h>
 #include <gtsam/inference/JunctionTree-inst.h>  // We need the inst file because we'll make a special JT templated on ISAM2
 #include <gtsam/linear/GaussianEliminationTree.h>
 #include <gtsam/nonlinear/LinearContainerFactor.h>
 
+#ifdef GTSAM_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 #include <boost/range/adaptors.hpp>
 #include <boost/range/algorithm/copy.hpp>
 namespace br {
@@ -33,9 +39,12 @@ using namespace boost::adaptors;
 }  // namespace br
 
 #include <algorithm>
+#include <chrono>
 #include <limits>
 #include <map>
+#include <set>
 #include <utility>
+#include <vector>
 
 using namespace std;
 
@@ -74,14 +83,21 @@ class ISAM2JunctionTree
 };
 
 /* ************************************************************************* */
-ISAM2::ISAM2(const ISAM2Params& params) : params_(params), update_count_(0) {
+ISAM2::ISAM2(const ISAM2Params& params)
+    : params_(params),
+      update_count_(0),
+      relinearizationDeferred_(false),
+      secondsPerVariable_(0.0) {
   if (params_.optimizationParams.type() == typeid(ISAM2DoglegParams))
     doglegDelta_ =
         boost::get<ISAM2DoglegParams>(params_.optimizationParams).initialDelta;
 }
 
 /* ************************************************************************* */
-ISAM2::ISAM2() : update_count_(0) {
+ISAM2::ISAM2()
+    : update_count_(0),
+      relinearizationDeferred_(false),
+      secondsPerVariable_(0.0) {
   if (params_.optimizationParams.type() == typeid(ISAM2DoglegParams))
     doglegDelta_ =
         boost::get<ISAM2DoglegParams>(params_.optimizationParams).initialDelta;
@@ -126,7 +142,7 @@ FactorIndexSet ISAM2::getAffectedFactors(const KeyList& keys) const {
 // (note that the remaining stuff is summarized in the cached factors)
 
 GaussianFactorGraph::shared_ptr ISAM2::relinearizeAffectedFactors(
-    const FastList<Key>& affectedKeys, const KeySet& relinKeys) const {
+    const FastList<Key>& affectedKeys, const KeySet& relinKeys) {
   gttic(getAffectedFactors);
   KeySet candidates = getAffectedFactors(affectedKeys);
   gttoc(getAffectedFactors);
@@ -138,34 +154,65 @@ GaussianFactorGraph::shared_ptr ISAM2::relinearizeAffectedFactors(
   gttoc(affectedKeysSet);
 
   gttic(check_candidates_and_linearize);
-  auto linearized = boost::make_shared<GaussianFactorGraph>();
-  for (Key idx : candidates) {
-    bool inside = true;
-    bool useCachedLinear = params_.cacheLinearizedFactors;
-    for (Key key : nonlinearFactors_[idx]->keys()) {
-      if (affectedKeysSet.find(key) == affectedKeysSet.end()) {
-        inside = false;
-        break;
+  // Check and linearize all candidates in parallel, each into its own slot
+  enum Status { OUTSIDE, CACHED, RELINEARIZED };
+  const KeyVector candidateVector(candidates.begin(), candidates.end());
+  const size_t n = candidateVector.size();
+  std::vector<Status> status(n, OUTSIDE);
+  std::vector<GaussianFactor::shared_ptr> linearFactors(n);
+  auto checkAndLinearize = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      const NonlinearFactor& factor = *nonlinearFactors_[candidateVector[i]];
+      bool inside = true;
+      bool useCachedLinear = params_.cacheLinearizedFactors;
+      for (Key key : factor.keys()) {
+        if (affectedKeysSet.find(key) == affectedKeysSet.end()) {
+          inside = false;
+          break;
+        }
+        if (useCachedLinear && relinKeys.find(key) != relinKeys.end())
+          useCachedLinear = false;
       }
-      if (useCachedLinear && relinKeys.find(key) != relinKeys.end())
-        useCachedLinear = false;
-    }
-    if (inside) {
+      if (!inside) continue;
       if (useCachedLinear) {
+        status[i] = CACHED;
+      } else {
+        status[i] = RELINEARIZED;
+        // The linear factor is recomputed, so the factor may first update
+        // data derived from the estimate, which replaces it by a clone if
+        // the caller shares it, see NonlinearFactorGraph::refresh
+        nonlinearFactors_.refreshFactor(candidateVector[i], theta_);
+        linearFactors[i] = nonlinearFactors_[candidateVector[i]]->linearize(theta_);
+      }
+    }
+  };
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+                    [&](const tbb::blocked_range<size_t>& range) {
+                      checkAndLinearize(range.begin(), range.end());
+                    });
+#else
+  ThreadPool::Shared(params_.numThreads).parallelFor(n, checkAndLinearize);
+#endif
+
+  // Collect in candidate order, so the result does not depend on threading
+  auto linearized = boost::make_shared<GaussianFactorGraph>();
+  linearized->reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    const Key idx = candidateVector[i];
+    if (status[i] == CACHED) {
 #ifdef GTSAM_EXTRA_CONSISTENCY_CHECKS
-        assert(linearFactors_[idx]);
-        assert(linearFactors_[idx]->keys() == nonlinearFactors_[idx]->keys());
+      assert(linearFactors_[idx]);
+      assert(linearFactors_[idx]->keys() == nonlinearFactors_[idx]->keys());
 #endif
-        linearized->push_back(linearFactors_[idx]);
-      } else {
-        auto linearFactor = nonlinearFactors_[idx]->linearize(theta_);
-        linearized->push_back(linearFactor);
-        if (params_.cacheLinearizedFactors) {
+      linearized->push_back(linearFactors_[idx]);
+    } else if (status[i] == RELINEARIZED) {
+      linearized->push_back(linearFactors[i]);
+      if (params_.cacheLinearizedFactors) {
 #ifdef GTSAM_EXTRA_CONSISTENCY_CHECKS
-          assert(linearFactors_[idx]->keys() == linearFactor->keys());
+        assert(linearFactors_[idx]->keys() == linearFactors[i]->keys());
 #endif
-          linearFactors_[idx] = linearFactor;
-        }
+        linearFactors_[idx] = linearFactors[i];
       }
     }
   }
@@ -292,7 +339,16 @@ boost::shared_ptr<KeySet> ISAM2::recalculate(
 
     gttic(ordering);
     Ordering order;
-    if (constrainKeys) {
+    if (params_.orderingType == Ordering::METIS) {
+      // Nested dissection on the whole graph, with the same constraints
+      FastMap<Key, int> constraintGroups;
+      if (constrainKeys) {
+        constraintGroups = *constrainKeys;
+      } else if (theta_.size() > observedKeys.size()) {
+        for (Key var : observedKeys) constraintGroups[var] = 1;
+      }
+      order = Ordering::MetisConstrained(nonlinearFactors_, constraintGroups);
+    } else if (constrainKeys) {
       order =
           Ordering::ColamdConstrained(affectedFactorsVarIndex, *constrainKeys);
     } else {
@@ -309,7 +365,9 @@ boost::shared_ptr<KeySet> ISAM2::recalculate(
     gttoc(ordering);
 
     gttic(linearize);
-    GaussianFactorGraph linearized = *nonlinearFactors_.linearize(theta_);
+    nonlinearFactors_.refresh(theta_, params_.numThreads);
+    GaussianFactorGraph linearized =
+        *nonlinearFactors_.linearize(theta_, params_.numThreads);
     if (params_.cacheLinearizedFactors) linearFactors_ = linearized;
     gttoc(linearize);
 
@@ -448,7 +506,10 @@ boost::shared_ptr<KeySet> ISAM2::recalculate(
     // Generate ordering
     gttic(Ordering);
     Ordering ordering =
-        Ordering::ColamdConstrained(affectedFactorsVarIndex, constraintGroups);
+        params_.orderingType == Ordering::METIS
+            ? Ordering::MetisConstrained(factors, constraintGroups)
+            : Ordering::ColamdConstrained(affectedFactorsVarIndex,
+                                          constraintGroups);
     gttoc(Ordering);
 
     ISAM2BayesTree::shared_ptr bayesTree =
@@ -488,6 +549,7 @@ void ISAM2::addVariables(const Values& newTheta) {
   if (debug) newTheta.print("The new variables are: ");
   // Add zeros into the VectorValues
   delta_.insert(newTheta.zeroVectors());
+  for (const auto& key_value : newTheta) estimateDirty_.insert(key_value.key);
   deltaNewton_.insert(newTheta.zeroVectors());
   RgProd_.insert(newTheta.zeroVectors());
 }
@@ -502,6 +564,8 @@ void ISAM2::removeVariables(const KeySet& unusedKeys) {
     deltaReplacedMask_.erase(key);
     Base::nodes_.unsafe_erase(key);
     theta_.erase(key);
+    if (estimate_.exists(key)) estimate_.erase(key);
+    estimateDirty_.erase(key);
     fixedVariables_.erase(key);
   }
 }
@@ -509,30 +573,16 @@ void ISAM2::removeVariables(const KeySet& unusedKeys) {
 /* ************************************************************************* */
 void ISAM2::expmapMasked(const KeySet& mask) {
   assert(theta_.size() == delta_.size());
-  Values::iterator key_value;
-  VectorValues::const_iterator key_delta;
-#ifdef GTSAM_USE_TBB
-  for (key_value = theta_.begin(); key_value != theta_.end(); ++key_value) {
-    key_delta = delta_.find(key_value->key);
-#else
-  for (key_value = theta_.begin(), key_delta = delta_.begin();
-       key_value != theta_.end(); ++key_value, ++key_delta) {
-    assert(key_value->key == key_delta->first);
-#endif
-    Key var = key_value->key;
-    assert(static_cast<size_t>(delta_[var].size()) == key_value->value.dim());
-    assert(delta_[var].allFinite());
-    if (mask.exists(var)) {
-      Value* retracted = key_value->value.retract_(delta_[var]);
-      key_value->value = *retracted;
-      retracted->deallocate_();
+  theta_.retractMasked(delta_, mask);
+  for (Key var : mask) {
+    // The cached estimate has to be recomputed from the new linearization point
+    estimateDirty_.insert(var);
 #ifndef NDEBUG
-      // If debugging, invalidate delta_ entries to Inf, to trigger assertions
-      // if we try to re-use them.
-      delta_[var] = Vector::Constant(delta_[var].rows(),
-                                     numeric_limits<double>::infinity());
+    // If debugging, invalidate delta_ entries to Inf, to trigger assertions
+    // if we try to re-use them.
+    delta_[var] = Vector::Constant(delta_[var].rows(),
+                                   numeric_limits<double>::infinity());
 #endif
-    }
   }
 }
 
@@ -548,6 +598,8 @@ ISAM2Result ISAM2::update(
   const bool verbose = ISDEBUG("ISAM2 update verbose");
 
   gttic(ISAM2_update);
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
 
   this->update_count_++;
 
@@ -560,9 +612,12 @@ ISAM2Result ISAM2::update(
   ISAM2Result result;
   if (params_.enableDetailedResults)
     result.detail = ISAM2Result::DetailedResults();
+  result.variablesReeliminated = 0;
+  result.variablesDeferred = 0;
   const bool relinearizeThisStep =
       force_relinearize || (params_.enableRelinearization &&
-                            update_count_ % params_.relinearizeSkip == 0);
+                            (update_count_ % params_.relinearizeSkip == 0 ||
+                             relinearizationDeferred_));
 
   if (verbose) {
     cout << "ISAM2::update\n";
@@ -634,7 +689,8 @@ ISAM2Result ISAM2::update(
 
   gttic(evaluate_error_before);
   if (params_.evaluateNonlinearError)
-    result.errorBefore.reset(nonlinearFactors_.error(calculateEstimate()));
+    result.errorBefore.reset(
+        nonlinearFactors_.error(getEstimate(), params_.numThreads));
   gttoc(evaluate_error_before);
 
   gttic(gather_involved_keys);
@@ -701,6 +757,15 @@ ISAM2Result ISAM2::update(
       }
     }
 
+    // Defer the smallest deltas if over budget
+    const KeySet deferredKeys = deferRelinearization(markedKeys, &relinKeys);
+    relinearizationDeferred_ = !deferredKeys.empty();
+    result.variablesDeferred = deferredKeys.size();
+    if (params_.enableDetailedResults) {
+      for (Key key : deferredKeys)
+        result.detail->variableStatus[key].isDeferred = true;
+    }
+
     // Above relin threshold keys for detailed results
     if (params_.enableDetailedResults) {
       for (Key key : relinKeys) {
@@ -753,7 +818,17 @@ ISAM2Result ISAM2::update(
   // 7. Linearize new factors
   if (params_.cacheLinearizedFactors) {
     gttic(linearize);
-    auto linearFactors = newFactors.linearize(theta_);
+    // Refresh the new factors where they are stored in nonlinearFactors_, so
+    // the ones the caller passed in stay as they are
+    NonlinearFactorGraph addedFactors;
+    addedFactors.reserve(newFactors.size());
+    for (FactorIndex index : result.newFactorsIndices)
+      addedFactors.push_back(nonlinearFactors_[index]);
+    addedFactors.refresh(theta_, params_.numThreads);
+    for (size_t newFactorI = 0; newFactorI < addedFactors.size(); ++newFactorI)
+      nonlinearFactors_.replace(result.newFactorsIndices[newFactorI],
+                                addedFactors[newFactorI]);
+    auto linearFactors = addedFactors.linearize(theta_, params_.numThreads);
     if (params_.findUnusedFactorSlots) {
       linearFactors_.resize(nonlinearFactors_.size());
       for (size_t newFactorI = 0; newFactorI < newFactors.size(); ++newFactorI)
@@ -797,12 +872,111 @@ ISAM2Result ISAM2::update(
 
   gttic(evaluate_error_after);
   if (params_.evaluateNonlinearError)
-    result.errorAfter.reset(nonlinearFactors_.error(calculateEstimate()));
+    result.errorAfter.reset(
+        nonlinearFactors_.error(getEstimate(), params_.numThreads));
   gttoc(evaluate_error_after);
 
+  // Update the running estimate of the cost per reeliminated variable
+  if (params_.updateTimeBudget > 0 && result.variablesReeliminated > 0) {
+    const double seconds = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+    const double perVariable = seconds / result.variablesReeliminated;
+    secondsPerVariable_ = secondsPerVariable_ == 0.0
+                              ? perVariable
+                              : 0.8 * secondsPerVariable_ + 0.2 * perVariable;
+  }
+
   return result;
 }
 
+/* ************************************************************************* */
+KeySet ISAM2::deferRelinearization(const KeySet& markedKeys,
+                                   KeySet* relinKeys) const {
+  const bool limitCount = params_.maxRelinearizedVariables > 0 &&
+                          relinKeys->size() > params_.maxRelinearizedVariables;
+  const bool limitTime =
+      params_.updateTimeBudget > 0 && secondsPerVariable_ > 0;
+  KeySet deferred;
+  if (!limitCount && !limitTime) return deferred;
+
+  // Consider the largest deltas first, ties broken by key so the choice is
+  // deterministic
+  std::vector<std::pair<double, Key> > byDelta;
+  byDelta.reserve(relinKeys->size());
+  for (Key key : *relinKeys)
+    byDelta.push_back(
+        std::make_pair(delta_[key].lpNorm<Eigen::Infinity>(), key));
+  std::sort(byDelta.begin(), byDelta.end(),
+            [](const std::pair<double, Key>& a,
+               const std::pair<double, Key>& b) {
+              return a.first > b.first ||
+                     (a.first == b.first && a.second < b.second);
+            });
+
+  // The cost of a variable is the number of variables in the cliques it
+  // adds to the top of the Bayes tree: its own clique and all ancestors,
+  // plus the descendants with the variable in their separator (see
+  // findAll).  Cliques already re-eliminated for an earlier variable are free.
+  std::set<const Clique*> affected;
+  std::vector<const Clique*> added;
+  auto cost = [&](Key key, bool relinearized) -> size_t {
+    added.clear();
+    const Nodes::const_iterator node = nodes_.find(key);
+    if (node == nodes_.end()) return 1;  // new variable
+    for (sharedClique clique = node->second;
+         clique && !affected.count(clique.get()); clique = clique->parent())
+      added.push_back(clique.get());
+    if (relinearized) {
+      std::vector<const Clique*> stack(1, node->second.get());
+      while (!stack.empty()) {
+        const Clique* clique = stack.back();
+        stack.pop_back();
+        for (const sharedClique& child : clique->children) {
+          const GaussianConditional& conditional = *child->conditional();
+          if (std::find(conditional.beginParents(), conditional.endParents(),
+                        key) == conditional.endParents())
+            continue;
+          if (!affected.count(child.get())) added.push_back(child.get());
+          stack.push_back(child.get());
+        }
+      }
+    }
+    size_t variables = 0;
+    for (const Clique* clique : added)
+      variables += clique->conditional()->nrFrontals();
+    return variables;
+  };
+
+  // Variables already marked by new factors use up part of the budget
+  const double budget =
+      limitTime ? params_.updateTimeBudget / secondsPerVariable_ : 0.0;
+  double used = 0.0;
+  for (Key key : markedKeys) {
+    used += cost(key, false);
+    affected.insert(added.begin(), added.end());
+  }
+
+  size_t kept = 0;
+  for (const std::pair<double, Key>& entry : byDelta) {
+    const double variables = static_cast<double>(cost(entry.second, true));
+    // At least one variable is kept, so deferred work always drains
+    const bool keep =
+        kept == 0 ||
+        ((!limitCount || kept < params_.maxRelinearizedVariables) &&
+         (!limitTime || used + variables <= budget));
+    if (keep) {
+      ++kept;
+      used += variables;
+      affected.insert(added.begin(), added.end());
+    } else {
+      relinKeys->erase(entry.second);
+      deferred.insert(entry.second);
+    }
+  }
+  return deferred;
+}
+
 /* ************************************************************************* */
 void ISAM2::marginalizeLeaves(
     const FastList<Key>& leafKeysList,
@@ -1035,7 +1209,8 @@ void ISAM2::updateDelta(bool forceFullSolve) const {
         forceFullSolve ? 0.0 : gaussNewtonParams.wildfireThreshold;
     gttic(Wildfire_update);
     lastBacksubVariableCount = Impl::UpdateGaussNewtonDelta(
-        roots_, deltaReplacedMask_, effectiveWildfireThreshold, &delta_);
+        roots_, deltaReplacedMask_, effectiveWildfireThreshold, &delta_,
+        params_.numThreads, &estimateDirty_);
     deltaReplacedMask_.clear();
     gttoc(Wildfire_update);
 
@@ -1052,7 +1227,8 @@ void ISAM2::updateDelta(bool forceFullSolve) const {
     // Compute Newton's method step
     gttic(Wildfire_update);
     lastBacksubVariableCount = Impl::UpdateGaussNewtonDelta(
-        roots_, deltaReplacedMask_, effectiveWildfireThreshold, &deltaNewton_);
+        roots_, deltaReplacedMask_, effectiveWildfireThreshold, &deltaNewton_,
+        params_.numThreads);
     gttoc(Wildfire_update);
 
     // Compute steepest descent step
@@ -1080,17 +1256,29 @@ void ISAM2::updateDelta(bool forceFullSolve) const {
     delta_ =
         doglegResult
             .dx_d;  // Copy the VectorValues containing with the linear solution
+    for (const VectorValues::KeyValuePair& key_delta : delta_)
+      estimateDirty_.insert(key_delta.first);
     gttoc(Copy_dx_d);
   }
 }
 
 /* ************************************************************************* */
-Values ISAM2::calculateEstimate() const {
+const Values& ISAM2::getEstimate() const {
   gttic(ISAM2_calculateEstimate);
   const VectorValues& delta(getDelta());
   gttic(Expmap);
-  return theta_.retract(delta);
+  // Only retract the variables whose delta changed since the last call, or
+  // that were relinearized or added since then
+  for (Key key : estimateDirty_) {
+    if (estimate_.exists(key))
+      estimate_.update(key, theta_.at(key));
+    else
+      estimate_.insert(key, theta_.at(key));
+  }
+  estimate_.retractMasked(delta, estimateDirty_);
+  estimateDirty_.clear();
   gttoc(Expmap);
+  return estimate_;
 }
 
 /* ************************************************************************* */
@@ -75,6 +75,13 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   mutable KeySet
       deltaReplacedMask_;  // TODO(dellaert): Make sure accessed in the right way
 
+  /** The estimate computed by the last call to getEstimate(), and the
+   * variables whose delta or linearization point changed since then, which
+   * are the only ones the next call has to retract.
+   */
+  mutable Values estimate_;
+  mutable KeySet estimateDirty_;
+
   /** All original nonlinear factors are stored here to use during
    * relinearization */
   NonlinearFactorGraph nonlinearFactors_;
@@ -95,6 +102,14 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   int update_count_;  ///< Counter incremented every update(), used to determine
                       ///< periodic relinearization
 
+  /** Whether relinearization was deferred in the last update, in which case
+   * the next update checks relinearization regardless of relinearizeSkip */
+  bool relinearizationDeferred_;
+
+  /** Running estimate of the update time per reeliminated variable, in
+   * seconds, used with ISAM2Params::updateTimeBudget (0 until measured) */
+  double secondsPerVariable_;
+
  public:
   typedef ISAM2 This;                       ///< This class
   typedef BayesTree<ISAM2Clique> Base;      ///< The BayesTree base class
@@ -187,9 +202,21 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   /** Compute an estimate from the incomplete linear delta computed during the
    * last update. This delta is incomplete because it was not updated below
    * wildfire_threshold.  If only a single variable is needed, it is faster to
-   * call calculateEstimate(const KEY&).
+   * call calculateEstimate(const KEY&).  This returns a copy of
+   * getEstimate().
+   */
+  Values calculateEstimate() const { return getEstimate(); }
+
+  /** The same estimate as calculateEstimate(), without copying it.  Only the
+   * variables whose delta or linearization point changed since the last call
+   * are retracted.  The reference stays valid until the next call to
+   * update(), or to any other method that changes the estimate.
+   *
+   * Like getDelta(), this updates cached, \c mutable members, so it is not
+   * safe to call concurrently with any other method, including other const
+   * methods.
    */
-  Values calculateEstimate() const;
+  const Values& getEstimate() const;
 
   /** Compute an estimate for a single variable using its incomplete linear
    * delta computed during the last update.  This is faster than calling the
@@ -292,9 +319,19 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
    */
   void expmapMasked(const KeySet& mask);
 
+  /**
+   * Remove variables from \c relinKeys when ISAM2Params::updateTimeBudget or
+   * ISAM2Params::maxRelinearizedVariables allow fewer, keeping the largest
+   * deltas.  The time budget is compared against the variables in the
+   * cliques affected by \c markedKeys and the kept variables.  Returns the
+   * removed, i.e. deferred, variables.
+   */
+  KeySet deferRelinearization(const KeySet& markedKeys,
+                              KeySet* relinKeys) const;
+
   FactorIndexSet getAffectedFactors(const FastList<Key>& keys) const;
   GaussianFactorGraph::shared_ptr relinearizeAffectedFactors(
-      const FastList<Key>& affectedKeys, const KeySet& relinKeys) const;
+      const FastList<Key>& affectedKeys, const KeySet& relinKeys);
   GaussianFactorGraph getCachedBoundaryFactors(const Cliques& orphans);
 
   virtual boost::shared_ptr<KeySet> recalculate(
@@ -161,7 +161,11 @@ void ISAM2Clique::fastBackSubstitute(VectorValues* delta) const {
     delta->update(conditional_->solve(*delta));
   }
 #else
-  delta->update(conditional_->solve(*delta));
+  // Assign through at(), which does not modify the map itself, so that
+  // cliques in different subtrees can be back-substituted concurrently
+  const VectorValues solution = conditional_->solve(*delta);
+  for (const auto& key_value : solution)
+    delta->at(key_value.first) = key_value.second;
 #endif
 }
 
@@ -189,7 +193,7 @@ void ISAM2Clique::restoreFromOriginals(const Vector& originalValues,
                                        VectorValues* delta) const {
   size_t pos = 0;
   for (Key frontal : conditional_->frontals()) {
-    auto v = delta->at(frontal);
+    Vector& v = delta->at(frontal);
     v = originalValues.segment(pos, v.size());
     pos += v.size();
   }
@@ -206,7 +210,7 @@ void ISAM2Clique::optimizeWildfire(const KeySet& replaced, double threshold,
 
     // Back-substitute
     fastBackSubstitute(delta);
-    count += conditional_->nrFrontals();
+    *count += conditional_->nrFrontals();
 
     if (valuesChanged(replaced, originalValues, *delta, threshold)) {
       markFrontalsAsChanged(changed);
@@ -243,7 +247,7 @@ bool ISAM2Clique::optimizeWildfireNode(const KeySet& replaced, double threshold,
 
     // Back-substitute
     fastBackSubstitute(delta);
-    count += conditional_->nrFrontals();
+    *count += conditional_->nrFrontals();
 
     if (valuesChanged(replaced, originalValues, *delta, threshold)) {
       markFrontalsAsChanged(changed);
@@ -259,6 +263,13 @@ size_t optimizeWildfireNonRecursive(const ISAM2Clique::shared_ptr& root,
                                     double threshold, const KeySet& keys,
                                     VectorValues* delta) {
   KeySet changed;
+  return optimizeWildfireNonRecursive(root, threshold, keys, &changed, delta);
+}
+
+/* ************************************************************************* */
+size_t optimizeWildfireNonRecursive(const ISAM2Clique::shared_ptr& root,
+                                    double threshold, const KeySet& keys,
+                                    KeySet* changed, VectorValues* delta) {
   size_t count = 0;
 
   if (root) {
@@ -268,7 +279,7 @@ size_t optimizeWildfireNonRecursive(const ISAM2Clique::shared_ptr& root,
     while (!travStack.empty()) {
       currentNode = travStack.top();
       travStack.pop();
-      bool dirty = currentNode->optimizeWildfireNode(keys, threshold, &changed,
+      bool dirty = currentNode->optimizeWildfireNode(keys, threshold, changed,
                                                      delta, &count);
       if (dirty) {
         for (const auto& child : currentNode->children) {
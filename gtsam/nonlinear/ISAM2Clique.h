@@ -171,4 +171,13 @@ size_t optimizeWildfireNonRecursive(const ISAM2Clique::shared_ptr& root,
                                     double threshold, const KeySet& replaced,
                                     VectorValues* delta);
 
+/**
+ * Same as above, for a subtree: \c changed holds the variables above \c root
+ * that changed significantly, and is updated with the variables changed in
+ * this subtree.
+ */
+size_t optimizeWildfireNonRecursive(const ISAM2Clique::shared_ptr& root,
+                                    double threshold, const KeySet& replaced,
+                                    KeySet* changed, VectorValues* delta);
+
 }  // namespace gtsam
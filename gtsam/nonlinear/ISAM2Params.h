@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <gtsam/inference/Ordering.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/nonlinear/DoglegOptimizerImpl.h>
 #include <boost/variant.hpp>
@@ -223,6 +224,43 @@ struct GTSAM_EXPORT ISAM2Params {
   /// cost of having to search for slots every time a factor is added.
   bool findUnusedFactorSlots;
 
+  /// Number of threads used to linearize factors and evaluate the nonlinear
+  /// error (default: 1, 0 means one per hardware thread). Results do not
+  /// depend on the number of threads.
+  size_t numThreads;
+
+  /** Wall-clock time budget for a single call to update(), in seconds
+   * (default: 0, no budget).  When positive, update() relinearizes at most as
+   * many variables as the budget allows, starting with the largest deltas.
+   * The cost of relinearizing a variable is estimated by the number of
+   * variables in the cliques it would re-eliminate, i.e. its clique up to the
+   * root, times the measured time per re-eliminated variable of earlier
+   * updates.  The cliques of variables marked by new factors are counted
+   * first, and a clique is only counted once.  The remaining variables above
+   * the threshold are deferred, and relinearization is checked again on the
+   * next call regardless of relinearizeSkip, so deferred work is spread over
+   * subsequent updates.  At least one variable is relinearized on every check,
+   * so deferred work always drains.  Work caused by new factors themselves,
+   * e.g. a loop closure that reaches the root, cannot be deferred.
+   */
+  double updateTimeBudget;
+
+  /** Maximum number of variables above the relinearization threshold that are
+   * relinearized in a single update (default: 0, unlimited).  Like
+   * updateTimeBudget, the largest deltas go first and the rest is deferred.
+   */
+  size_t maxRelinearizedVariables;
+
+  /** Fill-reducing ordering used when variables are re-eliminated, both in
+   * batch steps and in incremental updates (default: COLAMD).  METIS selects
+   * nested dissection, which gives more balanced Bayes trees on large batch
+   * re-eliminations, at a higher cost for computing the ordering.  In both
+   * cases the keys constrained to the end of the ordering, i.e. the observed
+   * keys or those given in constrainedKeys, are kept last.  Only COLAMD and
+   * METIS are supported.
+   */
+  Ordering::OrderingType orderingType;
+
   /**
    * Specify parameters as constructor arguments
    * See the documentation of member variables above.
@@ -246,7 +284,11 @@ struct GTSAM_EXPORT ISAM2Params {
         keyFormatter(_keyFormatter),
         enableDetailedResults(false),
         enablePartialRelinearizationCheck(false),
-        findUnusedFactorSlots(false) {}
+        findUnusedFactorSlots(false),
+        numThreads(1),
+        updateTimeBudget(0.0),
+        maxRelinearizedVariables(0),
+        orderingType(Ordering::COLAMD) {}
 
   /// print iSAM2 parameters
   void print(const std::string& str = "") const {
@@ -288,6 +330,12 @@ struct GTSAM_EXPORT ISAM2Params {
          << enablePartialRelinearizationCheck << "\n";
     cout << "findUnusedFactorSlots:             " << findUnusedFactorSlots
          << "\n";
+    cout << "numThreads:                        " << numThreads << "\n";
+    cout << "updateTimeBudget:                  " << updateTimeBudget << "\n";
+    cout << "maxRelinearizedVariables:          " << maxRelinearizedVariables
+         << "\n";
+    cout << "orderingType:                      "
+         << (orderingType == Ordering::METIS ? "METIS" : "COLAMD") << "\n";
     cout.flush();
   }
 
@@ -312,6 +360,12 @@ struct GTSAM_EXPORT ISAM2Params {
   bool isEnablePartialRelinearizationCheck() const {
     return enablePartialRelinearizationCheck;
   }
+  size_t getNumThreads() const { return numThreads; }
+  double getUpdateTimeBudget() const { return updateTimeBudget; }
+  size_t getMaxRelinearizedVariables() const {
+    return maxRelinearizedVariables;
+  }
+  Ordering::OrderingType getOrderingType() const { return orderingType; }
 
   void setOptimizationParams(OptimizationParams optimizationParams) {
     this->optimizationParams = optimizationParams;
@@ -344,6 +398,16 @@ struct GTSAM_EXPORT ISAM2Params {
       bool enablePartialRelinearizationCheck) {
     this->enablePartialRelinearizationCheck = enablePartialRelinearizationCheck;
   }
+  void setNumThreads(size_t numThreads) { this->numThreads = numThreads; }
+  void setUpdateTimeBudget(double updateTimeBudget) {
+    this->updateTimeBudget = updateTimeBudget;
+  }
+  void setMaxRelinearizedVariables(size_t maxRelinearizedVariables) {
+    this->maxRelinearizedVariables = maxRelinearizedVariables;
+  }
+  void setOrderingType(Ordering::OrderingType orderingType) {
+    this->orderingType = orderingType;
+  }
 
   GaussianFactorGraph::Eliminate getEliminationFunction() const {
     return factorization == CHOLESKY
@@ -75,6 +75,13 @@ struct GTSAM_EXPORT ISAM2Result {
    */
   size_t variablesRelinearized;
 
+  /** The number of variables above the relinearization threshold whose
+   * relinearization was deferred to a later update, because of
+   * ISAM2Params::updateTimeBudget or ISAM2Params::maxRelinearizedVariables.
+   * Zero when neither is set.
+   */
+  size_t variablesDeferred;
+
   /** The number of variables that were reeliminated as parts of the Bayes'
    * Tree were recalculated, due to new factors.  When loop closures occur,
    * this count will be large as the new loop-closing factors will tend to
@@ -118,6 +125,9 @@ struct GTSAM_EXPORT ISAM2Result {
       bool isRelinearized;  /// Whether the variable was relinearized, either by
                             /// being above the relinearization threshold or by
                             /// involvement.
+      bool isDeferred;      ///< Whether the variable was above the
+                            ///< relinearization threshold, but deferred to a
+                            ///< later update
       bool isObserved;      ///< Whether the variable was just involved in new
                             ///< factors
       bool isNew;           ///< Whether the variable itself was just added
@@ -127,6 +137,7 @@ struct GTSAM_EXPORT ISAM2Result {
             isAboveRelinThreshold(false),
             isRelinearizeInvolved(false),
             isRelinearized(false),
+            isDeferred(false),
             isObserved(false),
             isNew(false),
             inRootClique(false) {}
@@ -145,12 +156,14 @@ struct GTSAM_EXPORT ISAM2Result {
     using std::cout;
     cout << str << "  Reelimintated: " << variablesReeliminated
          << "  Relinearized: " << variablesRelinearized
+         << "  Deferred: " << variablesDeferred
          << "  Cliques: " << cliques << std::endl;
   }
 
   /** Getters and Setters */
   size_t getVariablesRelinearized() const { return variablesRelinearized; }
   size_t getVariablesReeliminated() const { return variablesReeliminated; }
+  size_t getVariablesDeferred() const { return variablesDeferred; }
   size_t getCliques() const { return cliques; }
 };
 
@@ -50,18 +50,20 @@ LevenbergMarquardtOptimizer::LevenbergMarquardtOptimizer(const NonlinearFactorGr
                                                          const Values& initialValues,
                                                          const LevenbergMarquardtParams& params)
     : NonlinearOptimizer(
-          graph, std::unique_ptr<State>(new State(initialValues, graph.error(initialValues),
+          graph, std::unique_ptr<State>(new State(initialValues, graph.error(initialValues, params.numThreads),
                                                   params.lambdaInitial, params.lambdaFactor))),
-      params_(LevenbergMarquardtParams::EnsureHasOrdering(params, graph)) {}
+      params_(LevenbergMarquardtParams::EnsureHasOrdering(params, graph)),
+      errorEvaluator_(graph_, params_.numThreads) {}
 
 LevenbergMarquardtOptimizer::LevenbergMarquardtOptimizer(const NonlinearFactorGraph& graph,
                                                          const Values& initialValues,
                                                          const Ordering& ordering,
                                                          const LevenbergMarquardtParams& params)
     : NonlinearOptimizer(
-          graph, std::unique_ptr<State>(new State(initialValues, graph.error(initialValues),
+          graph, std::unique_ptr<State>(new State(initialValues, graph.error(initialValues, params.numThreads),
                                                   params.lambdaInitial, params.lambdaFactor))),
-      params_(LevenbergMarquardtParams::ReplaceOrdering(params, ordering)) {}
+      params_(LevenbergMarquardtParams::ReplaceOrdering(params, ordering)),
+      errorEvaluator_(graph_, params_.numThreads) {}
 
 /* ************************************************************************* */
 void LevenbergMarquardtOptimizer::initTime() {
@@ -80,9 +82,14 @@ int LevenbergMarquardtOptimizer::getInnerIterations() const {
   return currentState->totalNumberInnerIterations;
 }
 
+/* ************************************************************************* */
+double LevenbergMarquardtOptimizer::recomputeError() {
+  return errorEvaluator_.reset(state_->values);
+}
+
 /* ************************************************************************* */
 GaussianFactorGraph::shared_ptr LevenbergMarquardtOptimizer::linearize() const {
-  return graph_.linearize(state_->values);
+  return linearizeInPlace();
 }
 
 /* ************************************************************************* */
@@ -178,7 +185,10 @@ bool LevenbergMarquardtOptimizer::tryLambda(const GaussianFactorGraph& linear,
       gttic(compute_error);
       if (verbose)
         cout << "calculating error:" << endl;
-      newError = graph_.error(newValues);
+      // only factors on variables that moved are re-evaluated
+      if (!errorEvaluator_.initialized())
+        errorEvaluator_.reset(currentState->values);
+      newError = errorEvaluator_.error(newValues, delta);
       gttoc(compute_error);
 
       if (verbose)
@@ -230,6 +240,7 @@ bool LevenbergMarquardtOptimizer::tryLambda(const GaussianFactorGraph& linear,
     // we have successfully decreased the cost and we have good modelFidelity
     // NOTE(frank): As we return immediately after this, we move the newValues
     // TODO(frank): make Values actually support move. Does not seem to happen now.
+    errorEvaluator_.accept();
     state_ = currentState->decreaseLambda(params_, modelFidelity, std::move(newValues), newError);
     return true;
   } else if (!stopSearchingLambda) {  // we failed to solved the system or had no decrease in cost
@@ -22,6 +22,7 @@
 
 #include <gtsam/nonlinear/NonlinearOptimizer.h>
 #include <gtsam/nonlinear/LevenbergMarquardtParams.h>
+#include <gtsam/nonlinear/CachedErrorEvaluator.h>
 #include <gtsam/linear/VectorValues.h>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
@@ -38,6 +39,10 @@ protected:
   const LevenbergMarquardtParams params_; ///< LM parameters
   boost::posix_time::ptime startTime_;
 
+  /// Per-factor errors at the current values, so trial steps only
+  /// re-evaluate the factors on variables that moved
+  CachedErrorEvaluator errorEvaluator_;
+
   void initTime();
 
 public:
@@ -125,6 +130,9 @@ protected:
   const NonlinearOptimizerParams& _params() const override {
     return params_;
   }
+
+  /// Re-evaluate all factors into errorEvaluator_ after refreshFactors()
+  double recomputeError() override;
 };
 
 }
@@ -109,7 +109,7 @@ public:
   static LevenbergMarquardtParams EnsureHasOrdering(LevenbergMarquardtParams params,
                                                     const NonlinearFactorGraph& graph) {
     if (!params.ordering)
-      params.ordering = Ordering::Create(params.orderingType, graph);
+      params.ordering = Ordering::Create(params.orderingType, graph, params.numThreads);
     return params;
   }
 
@@ -20,6 +20,9 @@
 #include <boost/make_shared.hpp>
 #include <boost/format.hpp>
 
+#include <typeinfo>
+#include <utility>
+
 namespace gtsam {
 
 /* ************************************************************************* */
@@ -93,6 +96,21 @@ Vector NoiseModelFactor::whitenedError(const Values& c) const {
   return noiseModel_ ? noiseModel_->whiten(b) : b;
 }
 
+/* ************************************************************************* */
+void NoiseModelFactor::whitenedErrors(FactorIterator first, FactorIterator last,
+                                      const Values& x, Vector& out,
+                                      size_t offset) const {
+  for (FactorIterator it = first; it != last; ++it) {
+    const NoiseModelFactor& factor = static_cast<const NoiseModelFactor&>(**it);
+    const size_t d = factor.dim();
+    if (factor.active(x))
+      out.segment(offset, d) = factor.whitenedError(x);
+    else
+      out.segment(offset, d).setZero();
+    offset += d;
+  }
+}
+
 /* ************************************************************************* */
 double NoiseModelFactor::error(const Values& c) const {
   if (active(c)) {
@@ -107,38 +125,151 @@ double NoiseModelFactor::error(const Values& c) const {
   }
 }
 
+/* ************************************************************************* */
+namespace {
+// Jacobians evaluated by NoiseModelFactor::linearize, kept per thread so their
+// storage is re-used from factor to factor
+struct LinearizeScratch {
+  std::vector<Matrix> A;
+  std::vector<DenseIndex> dims;
+};
+thread_local LinearizeScratch tl_linearizeScratch;
+
+// The previous linearization that NoiseModelFactor::linearizeInto offers to
+// the linearize() of the same factor, on this thread
+struct Recycled {
+  const NoiseModelFactor* owner;
+  boost::shared_ptr<GaussianFactor>* factor;
+};
+thread_local Recycled tl_recycled = {0, 0};
+}
+
 /* ************************************************************************* */
 boost::shared_ptr<GaussianFactor> NoiseModelFactor::linearize(
     const Values& x) const {
 
+  // The previous linearization, if linearizeInto offered it
+  boost::shared_ptr<GaussianFactor> factor = recycledLinearization();
+
   // Only linearize if the factor is active
   if (!active(x))
     return boost::shared_ptr<JacobianFactor>();
 
-  // Call evaluate error to get Jacobians and RHS vector b
-  std::vector<Matrix> A(size());
-  Vector b = -unwhitenedError(x, A);
-  check(noiseModel_, b.size());
+  // TODO pass unwhitened + noise model to Gaussian factor
+  using noiseModel::Constrained;
+  if (noiseModel_ && noiseModel_->isConstrained()) {
+    // Call evaluate error to get Jacobians and RHS vector b
+    std::vector<Matrix> A(size());
+    Vector b = -unwhitenedError(x, A);
+    check(noiseModel_, b.size());
 
-  // Whiten the corresponding system now
-  if (noiseModel_)
+    // Whiten the corresponding system now
     noiseModel_->WhitenSystem(A, b);
 
-  // Fill in terms, needed to create JacobianFactor below
-  std::vector<std::pair<Key, Matrix> > terms(size());
-  for (size_t j = 0; j < size(); ++j) {
-    terms[j].first = keys()[j];
-    terms[j].second.swap(A[j]);
-  }
-
-  // TODO pass unwhitened + noise model to Gaussian factor
-  using noiseModel::Constrained;
-  if (noiseModel_ && noiseModel_->isConstrained())
+    // Fill in terms, needed to create JacobianFactor below
+    std::vector<std::pair<Key, Matrix> > terms(size());
+    for (size_t j = 0; j < size(); ++j) {
+      terms[j].first = keys()[j];
+      terms[j].second.swap(A[j]);
+    }
     return GaussianFactor::shared_ptr(
         new JacobianFactor(terms, b,
             boost::static_pointer_cast<Constrained>(noiseModel_)->unit()));
-  else
-    return GaussianFactor::shared_ptr(new JacobianFactor(terms, b));
+  }
+
+  // Take the scratch Jacobians, so a nested call would get its own
+  LinearizeScratch scratch = std::move(tl_linearizeScratch);
+  std::vector<Matrix>& A = scratch.A;
+  A.resize(size());
+
+  // Call evaluate error to get Jacobians and the negated RHS vector b
+  Vector e = unwhitenedError(x, A);
+  check(noiseModel_, e.size());
+
+  // Whiten the corresponding system now
+  if (noiseModel_)
+    noiseModel_->WhitenSystem(A, e);
+
+  // Copy into factor, which is only re-allocated if its structure changed
+  scratch.dims.resize(size());
+  for (size_t j = 0; j < size(); ++j)
+    scratch.dims[j] = A[j].cols();
+  VerticalBlockMatrix& Ab =
+      writableJacobian(factor, scratch.dims.data(), e.size()).matrixObject();
+  for (size_t j = 0; j < size(); ++j)
+    Ab(j) = A[j];
+  Ab(size()).col(0) = -e;
+
+  tl_linearizeScratch = std::move(scratch);
+  return factor;
+}
+
+/* ************************************************************************* */
+void NoiseModelFactor::linearizeInto(const Values& x,
+    boost::shared_ptr<GaussianFactor>& factor) const {
+  // Offer factor to linearize() for re-use, restoring any outer offer after
+  const Recycled outer = tl_recycled;
+  tl_recycled.owner = this;
+  tl_recycled.factor = &factor;
+  boost::shared_ptr<GaussianFactor> result;
+  try {
+    result = linearize(x);
+  } catch (...) {
+    tl_recycled = outer;
+    throw;
+  }
+  tl_recycled = outer;
+  factor = result;
+}
+
+/* ************************************************************************* */
+boost::shared_ptr<GaussianFactor>
+NoiseModelFactor::recycledLinearization() const {
+  boost::shared_ptr<GaussianFactor> factor;
+  if (tl_recycled.owner == this) {
+    factor.swap(*tl_recycled.factor);
+    tl_recycled.owner = 0;
+  }
+  return factor;
+}
+
+/* ************************************************************************* */
+namespace {
+// Whether factor is an unshared JacobianFactor without noise model, with the
+// given keys, block dimensions and number of rows
+template <typename DIM>
+bool IsWritable(const boost::shared_ptr<GaussianFactor>& factor,
+    const KeyVector& keys, const DIM* dims, DenseIndex rows) {
+  GaussianFactor* existing = factor.unique() ? factor.get() : 0;
+  if (!existing || typeid(*existing) != typeid(JacobianFactor))
+    return false;
+  const JacobianFactor& jacobian = static_cast<const JacobianFactor&>(*existing);
+  bool sameStructure = !jacobian.get_model() && jacobian.keys() == keys
+      && jacobian.rows() == size_t(rows);
+  for (size_t j = 0; sameStructure && j < keys.size(); ++j)
+    sameStructure = jacobian.getDim(jacobian.begin() + j) == size_t(dims[j]);
+  return sameStructure;
+}
+}
+
+/* ************************************************************************* */
+JacobianFactor& NoiseModelFactor::writableJacobian(
+    boost::shared_ptr<GaussianFactor>& factor, const DenseIndex* dims,
+    DenseIndex rows) const {
+  if (!IsWritable(factor, keys(), dims, rows))
+    factor.reset(new JacobianFactor(keys(),
+        std::vector<DenseIndex>(dims, dims + size()), rows));
+  return static_cast<JacobianFactor&>(*factor);
+}
+
+/* ************************************************************************* */
+JacobianFactor& NoiseModelFactor::writableJacobian(
+    boost::shared_ptr<GaussianFactor>& factor, const int* dims,
+    DenseIndex rows) const {
+  if (!IsWritable(factor, keys(), dims, rows))
+    factor.reset(new JacobianFactor(keys(),
+        std::vector<DenseIndex>(dims, dims + size()), rows));
+  return static_cast<JacobianFactor&>(*factor);
 }
 
 /* ************************************************************************* */
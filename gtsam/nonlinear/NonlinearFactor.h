@@ -116,6 +116,34 @@ public:
   virtual boost::shared_ptr<GaussianFactor>
   linearize(const Values& c) const = 0;
 
+  /**
+   * Linearize into \c factor, which may hold the linearization of this factor
+   * from a previous call.  Derived classes may overwrite it in place when it
+   * is not shared and has the right structure, this default simply replaces
+   * it with the result of linearize().
+   */
+  virtual void linearizeInto(const Values& c,
+      boost::shared_ptr<GaussianFactor>& factor) const {
+    factor = linearize(c);
+  }
+
+  /**
+   * Update data the factor derives from the estimate \c c, e.g. IMU
+   * measurements preintegrated with a bias estimate, and return whether this
+   * changed error().  The default does nothing.  Optimizers call this between
+   * iterations, before they linearize and evaluate errors with the updated
+   * factor, never from within linearize() or error(), which stay free of side
+   * effects.  It may only change the factor if needsRefresh(c) is true, see
+   * NonlinearFactorGraph::refresh.
+   */
+  virtual bool refresh(const Values& /*c*/) { return false; }
+
+  /**
+   * Whether refresh(c) would change the factor.  Graphs check this to clone
+   * a factor they share with other graphs before refreshing it.
+   */
+  virtual bool needsRefresh(const Values& /*c*/) const { return false; }
+
   /**
    * Creates a shared_ptr clone of the factor - needs to be specialized to allow
    * for subclasses
@@ -226,6 +254,23 @@ public:
    */
   Vector whitenedError(const Values& c) const;
 
+  /// Iterator over the factors of a NonlinearFactorGraph
+  typedef FastVector<boost::shared_ptr<NonlinearFactor> >::const_iterator
+      FactorIterator;
+
+  /**
+   * Write the whitened errors of the factors in [first, last), which must all
+   * have the same dynamic type as this factor, one after the other into
+   * \c out, starting at row \c offset.  Inactive factors get zeros.
+   * This is the kernel called by NonlinearFactorGraph::whitenedErrors once per
+   * run of factors of the same type.  It calls whitenedError for every
+   * factor, derived classes can override it with a loop that does not make
+   * virtual calls or allocate.
+   */
+  virtual void whitenedErrors(FactorIterator first, FactorIterator last,
+                              const Values& x, Vector& out,
+                              size_t offset) const;
+
   /**
    * Calculate the error of the factor.
    * This is the log-likelihood, e.g. \f$ 0.5(h(x)-z)^2/\sigma^2 \f$ in case of Gaussian.
@@ -238,9 +283,24 @@ public:
    * Linearize a non-linearFactorN to get a GaussianFactor,
    * \f$ Ax-b \approx h(x+\delta x)-z = h(x) + A \delta x - z \f$
    * Hence \f$ b = z - h(x) = - \mathtt{error\_vector}(x) \f$
+   * When called from linearizeInto(), the previous linearization is
+   * overwritten in place if it is an unshared JacobianFactor with the same
+   * keys, block dimensions and number of rows, as is the case between
+   * optimizer iterations.  The Jacobians are evaluated into per-thread
+   * matrices that are re-used, so once the sizes settle nothing is allocated
+   * besides the error vector.
    */
   boost::shared_ptr<GaussianFactor> linearize(const Values& x) const;
 
+  /**
+   * Linearize into \c factor with linearize(), offering it the previous
+   * linearization in \c factor to overwrite in place, see
+   * recycledLinearization().  A derived class that overrides linearize() is
+   * linearized by its override, as with linearize().
+   */
+  virtual void linearizeInto(const Values& x,
+      boost::shared_ptr<GaussianFactor>& factor) const;
+
 #ifdef GTSAM_ALLOW_DEPRECATED_SINCE_V4
   /// @name Deprecated
   /// @{
@@ -248,6 +308,31 @@ public:
   /// @}
 #endif
 
+protected:
+
+  /**
+   * The previous linearization that linearizeInto() offers the linearize()
+   * of this factor to overwrite in place, or null.  Only the first call
+   * gets it.  For derived classes that override linearize() and write their
+   * Jacobians straight into a JacobianFactor, see writableJacobian().
+   */
+  boost::shared_ptr<GaussianFactor> recycledLinearization() const;
+
+  /**
+   * The JacobianFactor to write a linearization with block dimensions \c dims
+   * and \c rows rows into, without a noise model: \c factor itself if it is
+   * an unshared JacobianFactor with that structure, otherwise a new one that
+   * is assigned to \c factor.  The blocks are not initialized.  For derived
+   * classes that write fixed-size Jacobians straight into the factor.
+   */
+  JacobianFactor& writableJacobian(boost::shared_ptr<GaussianFactor>& factor,
+      const DenseIndex* dims, DenseIndex rows) const;
+
+  /// writableJacobian with the block dimensions as ints, as stored by
+  /// ExpressionFactor
+  JacobianFactor& writableJacobian(boost::shared_ptr<GaussianFactor>& factor,
+      const int* dims, DenseIndex rows) const;
+
 private:
 
   /** Serialization function */
@@ -27,14 +27,18 @@
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/inference/FactorGraph-inst.h>
+#include <gtsam/base/ThreadPool.h>
 #include <gtsam/config.h> // for GTSAM_USE_TBB
 
 #ifdef GTSAM_USE_TBB
 #  include <tbb/parallel_for.h>
 #endif
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <typeinfo>
+#include <vector>
 
 using namespace std;
 
@@ -243,17 +247,117 @@ void NonlinearFactorGraph::saveGraph(std::ostream &stm, const Values& values,
 }
 
 /* ************************************************************************* */
-double NonlinearFactorGraph::error(const Values& values) const {
+double NonlinearFactorGraph::error(const Values& values, size_t numThreads) const {
   gttic(NonlinearFactorGraph_error);
   double total_error = 0.;
-  // iterate over all the factors_ to accumulate the log probabilities
-  for(const sharedFactor& factor: factors_) {
-    if(factor)
-      total_error += factor->error(values);
+  if (numThreads == 1) {
+    // iterate over all the factors_ to accumulate the log probabilities
+    for(const sharedFactor& factor: factors_) {
+      if(factor)
+        total_error += factor->error(values);
+    }
+  } else {
+    // evaluate in parallel, but sum serially so the result does not depend
+    // on the number of threads
+    vector<double> errors(size(), 0.0);
+    ThreadPool::Shared(numThreads).parallelFor(size(), [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i)
+        if (factors_[i])
+          errors[i] = factors_[i]->error(values);
+    });
+    for (double e : errors)
+      total_error += e;
   }
   return total_error;
 }
 
+/* ************************************************************************* */
+bool NonlinearFactorGraph::refresh(const Values& values, size_t numThreads) {
+  gttic(NonlinearFactorGraph_refresh);
+  vector<char> changed(size(), 0);
+  auto refreshRange = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      changed[i] = refreshFactor(i, values);
+  };
+  if (numThreads == 1)
+    refreshRange(0, size());
+  else
+    ThreadPool::Shared(numThreads).parallelFor(size(), refreshRange);
+  return std::find(changed.begin(), changed.end(), 1) != changed.end();
+}
+
+/* ************************************************************************* */
+bool NonlinearFactorGraph::refreshFactor(size_t i, const Values& values) {
+  if (!factors_[i] || !factors_[i]->needsRefresh(values))
+    return false;
+  // Other graphs sharing the factor keep the original
+  if (!factors_[i].unique())
+    factors_[i] = factors_[i]->clone();
+  return factors_[i]->refresh(values);
+}
+
+/* ************************************************************************* */
+Vector WhitenedErrors::squaredNorms() const {
+  Vector result(size());
+  for (size_t i = 0; i < size(); ++i)
+    result(i) = (*this)[i].squaredNorm();
+  return result;
+}
+
+/* ************************************************************************* */
+WhitenedErrors NonlinearFactorGraph::whitenedErrors(const Values& values,
+                                                    size_t numThreads) const {
+  gttic(NonlinearFactorGraph_whitenedErrors);
+  // Long runs are split, so they can be shared between threads
+  static const size_t kMaxRunLength = 1024;
+  struct Run {
+    size_t begin, end;
+    const NoiseModelFactor* kernel;
+  };
+
+  // Split into runs of NoiseModelFactors of the same type, and compute offsets
+  const size_t n = size();
+  WhitenedErrors result;
+  result.offsets.resize(n + 1);
+  vector<Run> runs;
+  const std::type_info* runType = nullptr;
+  const NoiseModelFactor* kernel = nullptr;
+  size_t offset = 0;
+  for (size_t i = 0; i < n; ++i) {
+    result.offsets[i] = offset;
+    const sharedFactor& factor = factors_[i];
+    if (!factor) {
+      runType = nullptr;
+      continue;
+    }
+    const std::type_info& type = typeid(*factor);
+    if (!runType || type != *runType) {
+      runType = &type;
+      kernel = dynamic_cast<const NoiseModelFactor*>(factor.get());
+      if (kernel) runs.push_back(Run{i, i, kernel});
+    } else if (kernel && i - runs.back().begin == kMaxRunLength) {
+      runs.push_back(Run{i, i, kernel});
+    }
+    if (kernel) {
+      runs.back().end = i + 1;
+      offset += factor->dim();
+    }
+  }
+  result.offsets[n] = offset;
+
+  // Evaluate every run into its own rows
+  result.errors.resize(offset);
+  ThreadPool::Shared(numThreads).parallelFor(runs.size(), [&](size_t begin, size_t end) {
+    for (size_t r = begin; r < end; ++r) {
+      const Run& run = runs[r];
+      run.kernel->whitenedErrors(factors_.begin() + run.begin,
+                                 factors_.begin() + run.end, values,
+                                 result.errors, result.offsets[run.begin]);
+    }
+  });
+  return result;
+}
+
 /* ************************************************************************* */
 Ordering NonlinearFactorGraph::orderingCOLAMD() const
 {
@@ -301,7 +405,7 @@ public:
   void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
     for (size_t i = blocked_range.begin(); i != blocked_range.end(); ++i) {
       if (nonlinearGraph_[i])
-        result_[i] = nonlinearGraph_[i]->linearize(linearizationPoint_);
+        nonlinearGraph_[i]->linearizeInto(linearizationPoint_, result_[i]);
       else
         result_[i] = GaussianFactor::shared_ptr();
     }
@@ -312,35 +416,51 @@ public:
 }
 
 /* ************************************************************************* */
-GaussianFactorGraph::shared_ptr NonlinearFactorGraph::linearize(const Values& linearizationPoint) const
+GaussianFactorGraph::shared_ptr NonlinearFactorGraph::linearize(const Values& linearizationPoint,
+                                                                size_t numThreads) const
 {
   gttic(NonlinearFactorGraph_linearize);
 
-  // create an empty linear FG
+  // create an empty linear FG, and linearize all factors into it
   GaussianFactorGraph::shared_ptr linearFG = boost::make_shared<GaussianFactorGraph>();
+  linearizeInto(linearizationPoint, *linearFG, numThreads);
+
+  return linearFG;
+}
+
+/* ************************************************************************* */
+void NonlinearFactorGraph::linearizeInto(const Values& linearizationPoint,
+                                         GaussianFactorGraph& result,
+                                         size_t numThreads) const
+{
+  gttic(NonlinearFactorGraph_linearizeInto);
+
+  // factor i of this graph always linearizes into slot i of the result
+  result.resize(size());
 
 #ifdef GTSAM_USE_TBB
 
-  linearFG->resize(size());
   TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
   tbb::parallel_for(tbb::blocked_range<size_t>(0, size()),
-    _LinearizeOneFactor(*this, linearizationPoint, *linearFG));
+    _LinearizeOneFactor(*this, linearizationPoint, result));
 
 #else
 
-  linearFG->reserve(size());
-
-  // linearize all factors
-  for(const sharedFactor& factor: factors_) {
-    if(factor) {
-      (*linearFG) += factor->linearize(linearizationPoint);
-    } else
-    (*linearFG) += GaussianFactor::shared_ptr();
-  }
+  // linearize all factors, each into its own slot
+  auto linearizeRange = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      if (factors_[i])
+        factors_[i]->linearizeInto(linearizationPoint, result[i]);
+      else
+        result[i] = GaussianFactor::shared_ptr();
+    }
+  };
+  if (numThreads == 1)
+    linearizeRange(0, size());
+  else
+    ThreadPool::Shared(numThreads).parallelFor(size(), linearizeRange);
 
 #endif
-
-  return linearFG;
 }
 
 /* ************************************************************************* */
@@ -368,7 +488,8 @@ static Scatter scatterFromValues(const Values& values, boost::optional<Ordering&
 
 /* ************************************************************************* */
 HessianFactor::shared_ptr NonlinearFactorGraph::linearizeToHessianFactor(
-    const Values& values, boost::optional<Ordering&> ordering, const Dampen& dampen) const {
+    const Values& values, boost::optional<Ordering&> ordering, const Dampen& dampen,
+    size_t numThreads) const {
   gttic(NonlinearFactorGraph_linearizeToHessianFactor);
 
   Scatter scatter = scatterFromValues(values, ordering);
@@ -381,10 +502,31 @@ HessianFactor::shared_ptr NonlinearFactorGraph::linearizeToHessianFactor(
 
   // linearize all factors straight into the Hessian
   // TODO(frank): this saves on creating the graph, but still mallocs a gaussianFactor!
-  for (const sharedFactor& nonlinearFactor : factors_) {
-    if (nonlinearFactor) {
-      const auto& gaussianFactor = nonlinearFactor->linearize(values);
-      gaussianFactor->updateHessian(hessianFactor->keys_, &hessianFactor->info_);
+  if (numThreads == 1) {
+    for (const sharedFactor& nonlinearFactor : factors_) {
+      if (nonlinearFactor) {
+        const auto& gaussianFactor = nonlinearFactor->linearize(values);
+        gaussianFactor->updateHessian(hessianFactor->keys_, &hessianFactor->info_);
+      }
+    }
+  } else {
+    // Linearize batches in parallel, then do the updates serially, in factor
+    // order, so the result is identical to the serial version. Batching keeps
+    // at most a few thousand linearized factors alive at any time.
+    ThreadPool& pool = ThreadPool::Shared(numThreads);
+    const size_t batchSize = 1024 * pool.numThreads();
+    vector<GaussianFactor::shared_ptr> batch;
+    for (size_t first = 0; first < size(); first += batchSize) {
+      const size_t n = std::min(batchSize, size() - first);
+      batch.assign(n, GaussianFactor::shared_ptr());
+      pool.parallelFor(n, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+          if (factors_[first + i])
+            batch[i] = factors_[first + i]->linearize(values);
+      });
+      for (const GaussianFactor::shared_ptr& gaussianFactor : batch)
+        if (gaussianFactor)
+          gaussianFactor->updateHessian(hessianFactor->keys_, &hessianFactor->info_);
     }
   }
 
@@ -396,9 +538,10 @@ HessianFactor::shared_ptr NonlinearFactorGraph::linearizeToHessianFactor(
 /* ************************************************************************* */
 Values NonlinearFactorGraph::updateCholesky(const Values& values,
                                             boost::optional<Ordering&> ordering,
-                                            const Dampen& dampen) const {
+                                            const Dampen& dampen,
+                                            size_t numThreads) const {
   gttic(NonlinearFactorGraph_updateCholesky);
-  auto hessianFactor = linearizeToHessianFactor(values, ordering, dampen);
+  auto hessianFactor = linearizeToHessianFactor(values, ordering, dampen, numThreads);
   VectorValues delta = hessianFactor->solve();
   return values.retract(delta);
 }
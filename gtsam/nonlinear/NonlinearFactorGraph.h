@@ -65,6 +65,29 @@ namespace gtsam {
       connectKeysToFactor(true), binaryEdges(true) {}
   };
 
+  /**
+   * The whitened errors of all factors of a NonlinearFactorGraph, stacked in
+   * one contiguous vector, as returned by NonlinearFactorGraph::whitenedErrors.
+   * Factor i occupies rows [offsets[i], offsets[i+1]).  Null factors and
+   * factors that are not NoiseModelFactors have no rows.
+   */
+  struct GTSAM_EXPORT WhitenedErrors {
+    Vector errors;               ///< All whitened errors, one factor after the other
+    std::vector<size_t> offsets; ///< First row of each factor, plus the total size
+
+    /// Number of factors
+    size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    /// Whitened error of factor \c i
+    Eigen::VectorBlock<const Vector> operator[](size_t i) const {
+      return errors.segment(offsets[i], offsets[i + 1] - offsets[i]);
+    }
+
+    /// Squared norm of the whitened error of every factor, for Gaussian noise
+    /// models this is chi-square distributed with dim() degrees of freedom
+    Vector squaredNorms() const;
+  };
+
 
   /**
    * A non-linear factor graph is a graph of non-Gaussian, i.e. non-linear factors,
@@ -113,8 +136,36 @@ namespace gtsam {
       const GraphvizFormatting& graphvizFormatting = GraphvizFormatting(),
       const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
 
-    /** unnormalized error, \f$ 0.5 \sum_i (h_i(X_i)-z)^2/\sigma^2 \f$ in the most common case */
-    double error(const Values& values) const;
+    /**
+     * unnormalized error, \f$ 0.5 \sum_i (h_i(X_i)-z)^2/\sigma^2 \f$ in the most common case
+     * @param numThreads evaluate the factors on this many threads of the
+     * shared ThreadPool, 0 for all cores.  The sum is independent of it.
+     */
+    double error(const Values& values, size_t numThreads = 1) const;
+
+    /**
+     * Whitened errors of all NoiseModelFactors, in one contiguous vector.
+     * Runs of consecutive factors of the same type are handed to
+     * NoiseModelFactor::whitenedErrors of the first factor in the run, which
+     * for BetweenFactor and PriorFactor is a loop without virtual calls or
+     * allocations.  Inactive factors get zeros.
+     * @param numThreads as in error()
+     */
+    WhitenedErrors whitenedErrors(const Values& values,
+                                  size_t numThreads = 1) const;
+
+    /**
+     * Call NonlinearFactor::refresh on every factor, so that factors holding
+     * data derived from the estimate update it for \c values.  A factor that
+     * needs refreshing and is shared with other graphs is first replaced by a
+     * clone, so only this graph sees the change.  Returns whether the error of
+     * any factor changed, in which case errors computed before are stale.
+     * @param numThreads as in error()
+     */
+    bool refresh(const Values& values, size_t numThreads = 1);
+
+    /// Refresh factor \c i as refresh() does, returns whether its error changed
+    bool refreshFactor(size_t i, const Values& values);
 
     /** Unnormalized probability. O(n) */
     double probPrime(const Values& values) const;
@@ -139,8 +190,25 @@ namespace gtsam {
      */
     Ordering orderingCOLAMDConstrained(const FastMap<Key, int>& constraints) const;
 
-    /// Linearize a nonlinear factor graph
-    boost::shared_ptr<GaussianFactorGraph> linearize(const Values& linearizationPoint) const;
+    /**
+     * Linearize a nonlinear factor graph
+     * @param numThreads when GTSAM is built without TBB, linearize on this many
+     * threads of the shared ThreadPool, 0 for all cores.  With TBB, TBB is used.
+     */
+    boost::shared_ptr<GaussianFactorGraph> linearize(const Values& linearizationPoint,
+        size_t numThreads = 1) const;
+
+    /**
+     * Linearize into an existing GaussianFactorGraph, typically the result of
+     * linearizing this same graph at a previous linearization point.  Factor i
+     * is linearized into slot i of \c result, overwriting its JacobianFactor in
+     * place when it is not shared and its structure is unchanged (see
+     * NonlinearFactor::linearizeInto).  This avoids re-allocating the graph and
+     * all of its factors on every optimizer iteration.
+     * @param numThreads as in linearize()
+     */
+    void linearizeInto(const Values& linearizationPoint, GaussianFactorGraph& result,
+        size_t numThreads = 1) const;
 
     /// typdef for dampen functions used below
     typedef std::function<void(const boost::shared_ptr<HessianFactor>& hessianFactor)> Dampen;
@@ -151,16 +219,18 @@ namespace gtsam {
      * a new graph, and hence useful in case a dense solve is appropriate for your problem.
      * An optional ordering can be given that still decides how the Hessian is laid out.
      * An optional lambda function can be used to apply damping on the filled Hessian.
-     * No parallelism is exploited, because all the factors write in the same memory.
+     * Factors are linearized on \c numThreads threads (0 for all cores), in
+     * batches, but the rank updates into the Hessian are serial because all
+     * the factors write in the same memory.
      */
     boost::shared_ptr<HessianFactor> linearizeToHessianFactor(
         const Values& values, boost::optional<Ordering&> ordering = boost::none,
-        const Dampen& dampen = nullptr) const;
+        const Dampen& dampen = nullptr, size_t numThreads = 1) const;
 
     /// Linearize and solve in one pass.
     /// Calls linearizeToHessianFactor, densely solves the normal equations, and updates the values.
     Values updateCholesky(const Values& values, boost::optional<Ordering&> ordering = boost::none,
-                          const Dampen& dampen = nullptr) const;
+                          const Dampen& dampen = nullptr, size_t numThreads = 1) const;
 
     /// Clone() performs a deep-copy of the graph, including all of the factors
     NonlinearFactorGraph clone() const;
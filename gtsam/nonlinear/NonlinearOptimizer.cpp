@@ -22,6 +22,7 @@
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/linear/SubgraphSolver.h>
 #include <gtsam/linear/PCGSolver.h>
+#include <gtsam/linear/SupernodalCholesky.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/VectorValues.h>
 
@@ -61,6 +62,36 @@ const Values& NonlinearOptimizer::values() const {
   return state_->values;
 }
 
+/* ************************************************************************* */
+GaussianFactorGraph::shared_ptr NonlinearOptimizer::linearizeInPlace() const {
+  // Only reuse the previous linearization if we are its sole owner
+  if (!linear_ || !linear_.unique())
+    linear_ = boost::make_shared<GaussianFactorGraph>();
+  graph_.linearizeInto(state_->values, *linear_, _params().numThreads);
+  return linear_;
+}
+
+/* ************************************************************************* */
+void NonlinearOptimizer::invalidateSymbolicStructure() {
+  junctionTree_.invalidate();
+  supernodal_.reset();
+  supernodalOrdering_.clear();
+  supernodalFactorKeys_.clear();
+}
+
+/* ************************************************************************* */
+bool NonlinearOptimizer::refreshFactors() {
+  if (!graph_.refresh(state_->values, _params().numThreads))
+    return false;
+  state_->error = recomputeError();
+  return true;
+}
+
+/* ************************************************************************* */
+double NonlinearOptimizer::recomputeError() {
+  return graph_.error(state_->values, _params().numThreads);
+}
+
 /* ************************************************************************* */
 void NonlinearOptimizer::defaultOptimize() {
   const NonlinearOptimizerParams& params = _params();
@@ -89,6 +120,10 @@ void NonlinearOptimizer::defaultOptimize() {
 
   // Iterative loop
   do {
+    // Factors only change between iterations, so that currentError and the
+    // error after the iteration are computed with the same factors
+    refreshFactors();
+
     // Do next iteration
     currentError = error();
     iterate();
@@ -134,12 +169,38 @@ VectorValues NonlinearOptimizer::solve(const GaussianFactorGraph& gfg,
 
   // Check which solver we are using
   if (params.isMultifrontal()) {
-    // Multifrontal QR or Cholesky (decided by params.getEliminationFunction())
-    delta = gfg.optimize(optionalOrdering, params.getEliminationFunction());
+    // Multifrontal QR or Cholesky (decided by params.getEliminationFunction()),
+    // re-using the junction tree of the previous call if possible
+    delta = junctionTree_.optimize(gfg, params.getEliminationFunction(),
+                                   optionalOrdering);
   } else if (params.isSequential()) {
     // Sequential QR or Cholesky (decided by params.getEliminationFunction())
     delta = gfg.eliminateSequential(optionalOrdering, params.getEliminationFunction(), boost::none,
-                                    params.orderingType)->optimize();
+                                    params.orderingType, params.numThreads)->optimize();
+  } else if (params.isCholmod()) {
+    // Sparse supernodal Cholesky on the Hessian of the whole graph,
+    // re-using the ordering and symbolic analysis of the previous call if
+    // the graph has the same factors on the same keys
+    const SupernodalCholesky::Precision precision =
+        params.linearSolverType == NonlinearOptimizerParams::MIXED_PRECISION_CHOLMOD
+            ? SupernodalCholesky::MIXED : SupernodalCholesky::DOUBLE;
+    bool sameStructure = supernodal_ && supernodal_->precision() == precision
+        && (!params.ordering || static_cast<const KeyVector&>(*params.ordering)
+                                    == supernodalOrdering_)
+        && gfg.size() == supernodalFactorKeys_.size();
+    for (size_t i = 0; sameStructure && i < gfg.size(); ++i)
+      sameStructure = gfg[i] ? gfg[i]->keys() == supernodalFactorKeys_[i]
+                             : supernodalFactorKeys_[i].empty();
+    if (!sameStructure) {
+      supernodalOrdering_ = params.ordering
+          ? *params.ordering : Ordering::Create(params.orderingType, gfg);
+      supernodal_ = boost::make_shared<SupernodalCholesky>(
+          gfg, supernodalOrdering_, precision);
+      supernodalFactorKeys_.resize(gfg.size());
+      for (size_t i = 0; i < gfg.size(); ++i)
+        supernodalFactorKeys_[i] = gfg[i] ? gfg[i]->keys() : KeyVector();
+    }
+    delta = supernodal_->optimize(gfg);
   } else if (params.isIterative()) {
     // Conjugate Gradient -> needs params.iterativeParams
     if (!params.iterativeParams)
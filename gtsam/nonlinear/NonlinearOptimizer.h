@@ -20,10 +20,12 @@
 
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/NonlinearOptimizerParams.h>
+#include <gtsam/linear/CachedGaussianJunctionTree.h>
 
 namespace gtsam {
 
 namespace internal { struct NonlinearOptimizerState; }
+class SupernodalCholesky;
 
 /**
  * This is the abstract interface for classes that can optimize for the
@@ -79,6 +81,20 @@ protected:
 
   std::unique_ptr<internal::NonlinearOptimizerState> state_; ///< PIMPL'd state
 
+  /// Linearization from the previous iteration, its factors are reused by linearizeInPlace
+  mutable GaussianFactorGraph::shared_ptr linear_;
+
+  /// Ordering and junction tree of the multifrontal solvers, re-used by
+  /// solve() while the linear system keeps the same structure
+  mutable CachedGaussianJunctionTree junctionTree_;
+
+  /// Ordering and symbolic analysis of the supernodal Cholesky solver, and
+  /// the keys of each factor they were computed for, re-used by solve()
+  /// while the linear system keeps the same structure
+  mutable Ordering supernodalOrdering_;
+  mutable std::vector<KeyVector> supernodalFactorKeys_;
+  mutable boost::shared_ptr<SupernodalCholesky> supernodal_;
+
 public:
   /** A shared pointer to this class */
   typedef boost::shared_ptr<const NonlinearOptimizer> shared_ptr;
@@ -126,6 +142,26 @@ public:
   virtual VectorValues solve(const GaussianFactorGraph &gfg,
       const NonlinearOptimizerParams& params) const;
 
+  /**
+   * Drop the symbolic structure cached by the multifrontal and supernodal
+   * Cholesky solvers.  This is only needed to free it, or to recompute the
+   * ordering: a linear system with a different structure rebuilds it anyway.
+   */
+  void invalidateSymbolicStructure();
+
+  /**
+   * Let the factors update data derived from the current estimate, e.g. IMU
+   * preintegration with a new bias estimate (see NonlinearFactorGraph::refresh),
+   * and recompute error() if any of them changed.  Factors that change are
+   * cloned into the graph of the optimizer first, so the graph passed to the
+   * constructor is left as it is.  optimize() calls this before every
+   * iteration, callers of iterate() may do the same.  iterate()
+   * itself never changes the factors, so the error of the state and of all
+   * its trial steps are computed with the same factors.
+   * @return whether any factor changed
+   */
+  bool refreshFactors();
+
   /** 
    * Perform a single iteration, returning GaussianFactorGraph corresponding to 
    * the linearized factor graph.
@@ -142,6 +178,18 @@ protected:
 
   virtual const NonlinearOptimizerParams& _params() const = 0;
 
+  /// Error of graph_ at the current values, called by refreshFactors() after
+  /// the factors changed.  Optimizers caching per-factor errors reset them here.
+  virtual double recomputeError();
+
+  /**
+   * Linearize graph_ at the current values.  If nobody kept a reference to
+   * the graph returned by the previous call, the same GaussianFactorGraph is
+   * returned, with its JacobianFactors overwritten in place wherever the
+   * structure allows it (see NonlinearFactorGraph::linearizeInto).
+   */
+  GaussianFactorGraph::shared_ptr linearizeInPlace() const;
+
   /** Constructor for initial construction of base classes. Takes ownership of state. */
   NonlinearOptimizer(const NonlinearFactorGraph& graph,
                      std::unique_ptr<internal::NonlinearOptimizerState> state);
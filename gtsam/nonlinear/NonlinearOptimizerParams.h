@@ -45,9 +45,16 @@ public:
   Verbosity verbosity; ///< The printing verbosity during optimization (default SILENT)
   Ordering::OrderingType orderingType; ///< The method of ordering use during variable elimination (default COLAMD)
 
+  /** Number of threads (default: 1, 0 means one per hardware thread).  They
+   * are used to index the graph for the ordering, to linearize, to evaluate
+   * the error, and to eliminate when TBB is disabled.  With TBB enabled,
+   * linearization and elimination use TBB instead.
+   */
+  size_t numThreads;
+
   NonlinearOptimizerParams() :
       maxIterations(100), relativeErrorTol(1e-5), absoluteErrorTol(1e-5), errorTol(
-          0.0), verbosity(SILENT), orderingType(Ordering::COLAMD),
+          0.0), verbosity(SILENT), orderingType(Ordering::COLAMD), numThreads(1),
           linearSolverType(MULTIFRONTAL_CHOLESKY) {}
 
   virtual ~NonlinearOptimizerParams() {
@@ -59,11 +66,13 @@ public:
   double getAbsoluteErrorTol() const { return absoluteErrorTol; }
   double getErrorTol() const { return errorTol; }
   std::string getVerbosity() const { return verbosityTranslator(verbosity); }
+  size_t getNumThreads() const { return numThreads; }
 
   void setMaxIterations(int value) { maxIterations = value; }
   void setRelativeErrorTol(double value) { relativeErrorTol = value; }
   void setAbsoluteErrorTol(double value) { absoluteErrorTol = value; }
   void setErrorTol(double value) { errorTol = value; }
+  void setNumThreads(size_t value) { numThreads = value; }
   void setVerbosity(const std::string& src) {
     verbosity = verbosityTranslator(src);
   }
@@ -78,7 +87,8 @@ public:
     SEQUENTIAL_CHOLESKY,
     SEQUENTIAL_QR,
     Iterative, /* Experimental Flag */
-    CHOLMOD, /* Experimental Flag */
+    CHOLMOD, /* Sparse supernodal Cholesky, see SupernodalCholesky */
+    MIXED_PRECISION_CHOLMOD, /* CHOLMOD factored in single precision, with iterative refinement */
   };
 
   LinearSolverType linearSolverType; ///< The type of linear solver to use in the nonlinear optimizer
@@ -96,7 +106,8 @@ public:
   }
 
   inline bool isCholmod() const {
-    return (linearSolverType == CHOLMOD);
+    return (linearSolverType == CHOLMOD)
+        || (linearSolverType == MIXED_PRECISION_CHOLMOD);
   }
 
   inline bool isIterative() const {
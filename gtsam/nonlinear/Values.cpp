@@ -103,6 +103,35 @@ namespace gtsam {
     return Values(*this, delta);
   }
 
+  /* ************************************************************************* */
+  namespace {
+    // Assign the retracted value without reallocating the stored one
+    void retractValue(Value& value, const Vector& delta) {
+      Value* retracted = value.retract_(delta);
+      value = *retracted;
+      retracted->deallocate_();
+    }
+  }
+
+  /* ************************************************************************* */
+  void Values::retractInPlace(const VectorValues& delta) {
+    for (VectorValues::const_iterator it = delta.begin(); it != delta.end(); ++it) {
+      KeyValueMap::iterator item = values_.find(it->first);
+      if (item != values_.end())
+        retractValue(*item->second, it->second);
+    }
+  }
+
+  /* ************************************************************************* */
+  void Values::retractMasked(const VectorValues& delta, const KeySet& mask) {
+    for (Key key : mask) {
+      KeyValueMap::iterator item = values_.find(key);
+      if (item == values_.end())
+        throw ValuesKeyDoesNotExist("retractMasked", key);
+      retractValue(*item->second, delta.at(key));
+    }
+  }
+
   /* ************************************************************************* */
   VectorValues Values::localCoordinates(const Values& cp) const {
     if(this->size() != cp.size())
@@ -245,6 +245,15 @@ namespace gtsam {
     /** Add a delta config to current config and returns a new config */
     Values retract(const VectorValues& delta) const;
 
+    /** Add a delta config to current config in place, equivalent to
+     *  *this = retract(delta), but values without a delta are not copied.
+     *  As in retract, keys in \c delta that are not in this config are ignored. */
+    void retractInPlace(const VectorValues& delta);
+
+    /** Retract in place only the variables in \c mask, all others are left
+     *  untouched.  Throws ValuesKeyDoesNotExist if a masked key is missing. */
+    void retractMasked(const VectorValues& delta, const KeySet& mask);
+
     /** Get a delta config about a linearization point c0 (*this) */
     VectorValues localCoordinates(const Values& cp) const;
 
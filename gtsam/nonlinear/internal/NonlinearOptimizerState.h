@@ -36,8 +36,9 @@ struct NonlinearOptimizerState {
   /** The current estimate of the variable values. */
   const Values values;
 
-  /** The factor graph error on the current values. */
-  const double error;
+  /** The factor graph error on the current values.  Not const, as
+   * NonlinearOptimizer::refreshFactors recomputes it when the factors change. */
+  double error;
 
   /** The number of optimization iterations performed. */
   const size_t iterations;
@@ -0,0 +1,149 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testAsyncISAM2.cpp
+ * @brief   Unit tests for AsyncISAM2
+ */
+
+#include <gtsam/nonlinear/AsyncISAM2.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace gtsam;
+
+static const SharedNoiseModel model = noiseModel::Isotropic::Sigma(3, 0.1);
+
+/* ************************************************************************* */
+TEST(AsyncISAM2, odometryChain) {
+  // Relinearize everything on every update, so that the estimate does not
+  // depend on how the background thread batched the measurements
+  ISAM2Params params;
+  params.optimizationParams = ISAM2GaussNewtonParams(0.0);
+  params.relinearizeThreshold = 0.0;
+  params.relinearizeSkip = 1;
+  AsyncISAM2 isam(params);
+  EXPECT(isam.estimate()->empty());
+
+  // Drive along a straight line, initializing slightly off
+  const Pose2 odometry(1.0, 0.0, 0.0);
+  NonlinearFactorGraph prior;
+  prior.emplace_shared<PriorFactor<Pose2> >(0, Pose2(), model);
+  Values initial;
+  initial.insert(0, Pose2(0.01, -0.01, 0.01));
+  isam.add(prior, initial);
+  for (size_t i = 1; i < 20; ++i) {
+    NonlinearFactorGraph odometryFactor;
+    odometryFactor.emplace_shared<BetweenFactor<Pose2> >(i - 1, i, odometry,
+                                                         model);
+    Values newPose;
+    newPose.insert(i, Pose2(i + 0.01, 0.02, -0.01));
+    isam.add(odometryFactor, newPose);
+  }
+
+  isam.flush();
+  EXPECT(isam.numUpdates() >= 1);
+  EXPECT(isam.numUpdates() <= 20);
+  AsyncISAM2::ValuesSnapshot estimate = isam.estimate();
+  EXPECT_LONGS_EQUAL(20, estimate->size());
+
+  // Iterate to convergence with empty updates
+  for (size_t i = 0; i < 5; ++i) {
+    isam.add();
+    isam.flush();
+  }
+  EXPECT(assert_equal(Pose2(19.0, 0.0, 0.0),
+                      isam.calculateEstimate<Pose2>(19), 1e-6));
+  estimate = isam.estimate();
+  EXPECT_LONGS_EQUAL(20, estimate->size());
+
+  // Snapshots are not changed by later updates
+  NonlinearFactorGraph last;
+  last.emplace_shared<BetweenFactor<Pose2> >(19, 20, odometry, model);
+  Values newPose;
+  newPose.insert(20, Pose2(20.0, 0.0, 0.0));
+  isam.add(last, newPose);
+  isam.flush();
+  EXPECT_LONGS_EQUAL(20, estimate->size());
+  EXPECT_LONGS_EQUAL(21, isam.estimate()->size());
+}
+
+/* ************************************************************************* */
+TEST(AsyncISAM2, error) {
+  AsyncISAM2 isam;
+  Values initial;
+  initial.insert(0, Pose2());
+  NonlinearFactorGraph prior;
+  prior.emplace_shared<PriorFactor<Pose2> >(0, Pose2(), model);
+  isam.add(prior, initial);
+  isam.flush();
+
+  // Inserting an existing variable fails on the background thread, and is
+  // reported by flush
+  isam.add(NonlinearFactorGraph(), initial);
+  CHECK_EXCEPTION(isam.flush(), ValuesKeyAlreadyExists);
+
+  // Previous estimate is still available, and updates can continue
+  EXPECT_LONGS_EQUAL(1, isam.estimate()->size());
+  Values next;
+  next.insert(1, Pose2());
+  NonlinearFactorGraph between;
+  between.emplace_shared<BetweenFactor<Pose2> >(0, 1, Pose2(), model);
+  isam.add(between, next);
+  isam.flush();
+  EXPECT_LONGS_EQUAL(2, isam.estimate()->size());
+}
+
+/* ************************************************************************* */
+TEST(AsyncISAM2, rejectedEntry) {
+  AsyncISAM2 isam;
+  Values initial;
+  initial.insert(0, Pose2());
+  NonlinearFactorGraph prior;
+  prior.emplace_shared<PriorFactor<Pose2> >(0, Pose2(), model);
+  isam.add(prior, initial);
+
+  // Queue bad entries in between good ones, without flushing, so that they
+  // can end up in the same update
+  for (size_t i = 1; i < 5; ++i) {
+    NonlinearFactorGraph between;
+    between.emplace_shared<BetweenFactor<Pose2> >(i - 1, i, Pose2(), model);
+    Values next;
+    next.insert(i, Pose2());
+    isam.add(between, next);
+
+    if (i == 2) {
+      // Inserts an existing variable
+      isam.add(NonlinearFactorGraph(), initial);
+    } else if (i == 3) {
+      // Factor on a variable that is never inserted
+      NonlinearFactorGraph unknown;
+      unknown.emplace_shared<BetweenFactor<Pose2> >(i, 100, Pose2(), model);
+      isam.add(unknown);
+    }
+  }
+
+  // The first error is reported, and all good entries are incorporated
+  CHECK_EXCEPTION(isam.flush(), ValuesKeyAlreadyExists);
+  AsyncISAM2::ValuesSnapshot estimate = isam.estimate();
+  EXPECT_LONGS_EQUAL(5, estimate->size());
+  for (size_t i = 0; i < 5; ++i) EXPECT(estimate->exists(i));
+  EXPECT(!estimate->exists(100));
+  isam.flush();  // the error is only reported once
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -0,0 +1,106 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testCachedErrorEvaluator.cpp
+ * @brief   Unit tests for CachedErrorEvaluator
+ */
+
+#include <gtsam/nonlinear/CachedErrorEvaluator.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace gtsam;
+
+static const SharedNoiseModel model = noiseModel::Isotropic::Sigma(3, 0.1);
+
+/* ************************************************************************* */
+// A chain of 5 poses, with a prior on the first one
+static NonlinearFactorGraph createChain(Values* values) {
+  NonlinearFactorGraph graph;
+  graph.emplace_shared<PriorFactor<Pose2> >(0, Pose2(), model);
+  values->insert(0, Pose2(0.1, 0.0, 0.0));
+  for (size_t i = 1; i < 5; ++i) {
+    graph.emplace_shared<BetweenFactor<Pose2> >(i - 1, i, Pose2(1.0, 0.0, 0.1),
+                                                model);
+    values->insert(i, Pose2(i + 0.1, 0.2, 0.0));
+  }
+  return graph;
+}
+
+/* ************************************************************************* */
+TEST(CachedErrorEvaluator, trialSteps) {
+  Values values;
+  const NonlinearFactorGraph graph = createChain(&values);
+  CachedErrorEvaluator evaluator(graph);
+  EXPECT(!evaluator.initialized());
+  EXPECT_DOUBLES_EQUAL(graph.error(values), evaluator.reset(values), 0.0);
+
+  // Only variable 4 moves, so only the last between factor is evaluated
+  VectorValues delta = values.zeroVectors();
+  delta[4] = Vector3(0.1, -0.2, 0.05);
+  Values trial = values.retract(delta);
+  EXPECT_DOUBLES_EQUAL(graph.error(trial), evaluator.error(trial, delta), 0.0);
+  EXPECT_LONGS_EQUAL(1, evaluator.lastNumEvaluated());
+
+  // Rejected: the reference point is unchanged
+  delta[4].setZero();
+  delta[0] = Vector3(-0.1, 0.0, 0.0);
+  trial = values.retract(delta);
+  EXPECT_DOUBLES_EQUAL(graph.error(trial), evaluator.error(trial, delta), 0.0);
+  EXPECT_LONGS_EQUAL(2, evaluator.lastNumEvaluated());
+
+  // Accepted: later steps are relative to the new point
+  evaluator.accept();
+  EXPECT_DOUBLES_EQUAL(graph.error(trial), evaluator.error(), 0.0);
+  values = trial;
+  delta = values.zeroVectors();
+  delta[2] = Vector3(0.0, -0.2, 0.0);
+  trial = values.retract(delta);
+  EXPECT_DOUBLES_EQUAL(graph.error(trial), evaluator.error(trial, delta), 0.0);
+  EXPECT_LONGS_EQUAL(2, evaluator.lastNumEvaluated());
+}
+
+/* ************************************************************************* */
+TEST(CachedErrorEvaluator, whitenedErrors) {
+  Values values;
+  NonlinearFactorGraph graph = createChain(&values);
+  graph.push_back(NonlinearFactorGraph::sharedFactor());  // null factor
+  CachedErrorEvaluator evaluator(graph, 2, true);
+  EXPECT_DOUBLES_EQUAL(graph.error(values), evaluator.reset(values), 1e-9);
+
+  const NoiseModelFactor& between =
+      dynamic_cast<const NoiseModelFactor&>(*graph[3]);
+  EXPECT(assert_equal(between.whitenedError(values),
+                      evaluator.whitenedError(3)));
+  EXPECT_DOUBLES_EQUAL(between.error(values), evaluator.factorError(3), 0.0);
+  EXPECT_LONGS_EQUAL(0, evaluator.whitenedError(5).size());
+
+  VectorValues delta = values.zeroVectors();
+  delta[3] = Vector3(0.3, 0.0, 0.0);
+  const Values trial = values.retract(delta);
+  evaluator.error(trial, delta);
+  evaluator.accept();
+  EXPECT(assert_equal(between.whitenedError(trial),
+                      evaluator.whitenedError(3)));
+  EXPECT_DOUBLES_EQUAL(graph.error(trial), evaluator.error(), 1e-9);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,267 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testFlatValues.cpp
+ * @brief Unit tests for FlatValues, checked against Values
+ */
+
+#include <gtsam/nonlinear/FlatValues.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/base/Testable.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace gtsam;
+using namespace std;
+
+using symbol_shorthand::K;
+using symbol_shorthand::L;
+using symbol_shorthand::X;
+
+/* ************************************************************************* */
+// A mixed Values: Pose3, Point3 and Pose2 are stored contiguously when
+// converted, Cal3_S2 is not one of the common types and is stored boxed
+static Values mixedValues() {
+  Values values;
+  values.insert(X(3), Pose3(Rot3::Ypr(0.1, 0.2, 0.3), Point3(1, 2, 3)));
+  values.insert(X(1), Pose3());
+  values.insert(L(1), Point3(4, 5, 6));
+  values.insert(X(2), Pose3(Rot3::Ypr(-0.1, 0.0, 0.1), Point3(0, 1, 0)));
+  values.insert(L(2), Pose2(1, 2, 0.3));
+  values.insert(K(1), Cal3_S2(500, 480, 0.1, 320, 240));
+  return values;
+}
+
+/* ************************************************************************* */
+TEST(FlatValues, insert_at) {
+  FlatValues flat;
+  flat.insert(X(2), Pose3());
+  flat.insert(X(1), Pose3(Rot3(), Point3(1, 2, 3)));
+  flat.insert(L(1), Point3(4, 5, 6));
+
+  EXPECT_LONGS_EQUAL(3, flat.size());
+  EXPECT_LONGS_EQUAL(2, flat.count<Pose3>());
+  EXPECT_LONGS_EQUAL(1, flat.count<Point3>());
+  EXPECT(assert_equal(Pose3(Rot3(), Point3(1, 2, 3)), flat.at<Pose3>(X(1))));
+  EXPECT(assert_equal(Point3(4, 5, 6), flat.at<Point3>(L(1))));
+  EXPECT(flat.exists(X(2)));
+  EXPECT(!flat.exists(X(3)));
+  EXPECT(!flat.exists<Pose3>(X(3)));
+  EXPECT(assert_equal(Pose3(), *flat.exists<Pose3>(X(2))));
+
+  // Keys are sorted
+  KeyVector expected;
+  expected.push_back(L(1));
+  expected.push_back(X(1));
+  expected.push_back(X(2));
+  EXPECT(expected == flat.keys());
+
+  CHECK_EXCEPTION(flat.insert(X(1), Pose3()), ValuesKeyAlreadyExists);
+  CHECK_EXCEPTION(flat.at<Pose3>(X(3)), ValuesKeyDoesNotExist);
+  CHECK_EXCEPTION(flat.at<Pose2>(X(1)), ValuesIncorrectType);
+}
+
+/* ************************************************************************* */
+TEST(FlatValues, insert_interleaved) {
+  // Interleaved x and l Symbols: every l goes before all x inserted so far
+  FlatValues flat;
+  Values expected;
+  for (size_t i = 0; i < 200; ++i) {
+    flat.insert(X(i), Pose3(Rot3(), Point3(double(i), 0, 0)));
+    flat.insert(L(i), Point3(0, double(i), 0));
+    expected.insert(X(i), Pose3(Rot3(), Point3(double(i), 0, 0)));
+    expected.insert(L(i), Point3(0, double(i), 0));
+  }
+  EXPECT(assert_equal(expected, flat.toValues()));
+  EXPECT(expected.keys() == flat.keys());
+  EXPECT(assert_equal(Point3(0, 7, 0), flat.at<Point3>(L(7))));
+  EXPECT(L(7) == flat.find(L(7))->key);
+  EXPECT(X(0) == flat.upper_bound(L(199))->key);
+  EXPECT(flat.find(L(200)) == flat.end());
+  CHECK_EXCEPTION(flat.insert(L(3), Point3()), ValuesKeyAlreadyExists);
+
+  // Erasing keys wherever they are indexed
+  for (size_t i = 0; i < 200; i += 3) {
+    flat.erase(L(i));
+    expected.erase(L(i));
+  }
+  flat.insert(L(3), Point3(1, 2, 3));
+  expected.insert(L(3), Point3(1, 2, 3));
+  EXPECT(assert_equal(expected, flat.toValues()));
+  EXPECT(assert_equal(flat, FlatValues(expected)));
+}
+
+/* ************************************************************************* */
+TEST(FlatValues, conversion) {
+  Values values = mixedValues();
+  FlatValues flat(values);
+  EXPECT_LONGS_EQUAL(values.size(), flat.size());
+  EXPECT_LONGS_EQUAL(values.dim(), flat.dim());
+  EXPECT(assert_equal(values, flat.toValues()));
+
+  size_t i = 0;
+  for (const FlatValues::ConstKeyValuePair& key_value : flat) {
+    EXPECT(values.keys()[i++] == key_value.key);
+    EXPECT(key_value.value.equals_(values.at(key_value.key)));
+  }
+
+  // Common types are stored contiguously, in key order
+  const char* x1 = reinterpret_cast<const char*>(&flat.at(X(1)));
+  const char* x2 = reinterpret_cast<const char*>(&flat.at(X(2)));
+  const char* x3 = reinterpret_cast<const char*>(&flat.at(X(3)));
+  EXPECT_LONGS_EQUAL(sizeof(GenericValue<Pose3>), x2 - x1);
+  EXPECT_LONGS_EQUAL(sizeof(GenericValue<Pose3>), x3 - x2);
+}
+
+/* ************************************************************************* */
+TEST(FlatValues, update_erase) {
+  FlatValues flat;
+  flat.reserve<Pose3>(3);
+  flat.insert(mixedValues());
+  EXPECT_LONGS_EQUAL(3, flat.count<Pose3>());
+
+  flat.update(X(2), Pose3(Rot3(), Point3(7, 8, 9)));
+  EXPECT(assert_equal(Pose3(Rot3(), Point3(7, 8, 9)), flat.at<Pose3>(X(2))));
+  CHECK_EXCEPTION(flat.update(X(2), Pose2()), ValuesIncorrectType);
+
+  // Erasing moves the last Pose3 into the hole, other keys must still resolve
+  Values expected = mixedValues();
+  expected.update(X(2), Pose3(Rot3(), Point3(7, 8, 9)));
+  flat.erase(X(3));
+  expected.erase(X(3));
+  EXPECT(assert_equal(expected, flat.toValues()));
+  flat.erase(X(1));
+  expected.erase(X(1));
+  EXPECT(assert_equal(expected, flat.toValues()));
+  CHECK_EXCEPTION(flat.erase(X(1)), ValuesKeyDoesNotExist);
+}
+
+/* ************************************************************************* */
+TEST(FlatValues, boxed_then_reserved) {
+  // Cal3_S2 is only known as a Value here, so it is stored boxed ...
+  FlatValues flat(mixedValues());
+  const Cal3_S2 K1(500, 480, 0.1, 320, 240), K2(400, 400, 0, 300, 200);
+  EXPECT(assert_equal(K1, flat.at<Cal3_S2>(K(1))));
+
+  // ... until announced, at which point it moves to contiguous storage
+  flat.reserve<Cal3_S2>(10);
+  flat.insert(K(2), K2);
+  EXPECT_LONGS_EQUAL(2, flat.count<Cal3_S2>());
+  EXPECT(assert_equal(K1, flat.at<Cal3_S2>(K(1))));
+  EXPECT(assert_equal(K2, flat.at<Cal3_S2>(K(2))));
+}
+
+/* ************************************************************************* */
+TEST(FlatValues, retract_localCoordinates) {
+  Values values = mixedValues();
+  FlatValues flat(values);
+
+  VectorValues delta = values.zeroVectors();
+  delta[X(1)] << 0.1, -0.2, 0.3, 1, 2, 3;
+  delta[L(1)] << 0.5, 0.5, 0.5;
+  delta[L(2)] << 0.1, 0.2, 0.3;
+  delta.erase(X(2));
+
+  // Retract must agree with Values, including keys without a delta
+  FlatValues retracted = flat.retract(delta);
+  EXPECT(assert_equal(values.retract(delta), retracted.toValues()));
+  EXPECT(assert_equal(values.localCoordinates(values.retract(delta)),
+      flat.localCoordinates(retracted)));
+
+  // Mismatched keys
+  FlatValues other(flat);
+  other.erase(L(1));
+  CHECK_EXCEPTION(flat.localCoordinates(other), DynamicValuesMismatched);
+}
+
+/* ************************************************************************* */
+TEST(FlatValues, retractInPlace) {
+  Values values = mixedValues();
+  FlatValues flat(values);
+  const Value& pose = flat.at(X(1));
+  const Value& calibration = flat.at(K(1));
+
+  // Keys missing on either side are skipped
+  VectorValues delta;
+  delta.insert(X(0), Vector6::Zero());
+  delta.insert(X(1), (Vector(6) << 0.1, -0.2, 0.3, 1, 2, 3).finished());
+  delta.insert(K(1), (Vector(5) << 10, -5, 0.01, 2, 3).finished());
+  delta.insert(L(2), Vector3(0.1, 0.2, 0.3));
+  delta.insert(X(9), Vector6::Zero());
+  flat.retractInPlace(delta);
+  values.retractInPlace(delta);
+  EXPECT(assert_equal(values, flat.toValues()));
+
+  // Values are changed where they are stored, contiguous or boxed
+  EXPECT(&pose == &flat.at(X(1)));
+  EXPECT(&calibration == &flat.at(K(1)));
+  EXPECT(assert_equal(values.at<Pose3>(X(1)),
+                      dynamic_cast<const GenericValue<Pose3>&>(pose).value()));
+}
+
+/* ************************************************************************* */
+TEST(FlatValues, localCoordinates_mixed_storage) {
+  // The same type stored contiguously in one FlatValues and boxed in the other
+  Values values = mixedValues();
+  FlatValues reserved;
+  reserved.reserve<Cal3_S2>(1);
+  reserved.insert(values);
+  FlatValues converted(values);
+
+  VectorValues delta = values.zeroVectors();
+  delta[K(1)] << 10, -5, 0.01, 2, 3;
+  const Values retracted = values.retract(delta);
+  FlatValues retractedReserved;
+  retractedReserved.reserve<Cal3_S2>(1);
+  retractedReserved.insert(retracted);
+  const FlatValues retractedConverted(retracted);
+
+  EXPECT(assert_equal(delta, reserved.localCoordinates(retractedConverted)));
+  EXPECT(assert_equal(delta, converted.localCoordinates(retractedReserved)));
+}
+
+/* ************************************************************************* */
+TEST(FlatValues, copy_equals) {
+  FlatValues flat(mixedValues());
+  FlatValues copy(flat);
+  EXPECT(assert_equal(flat, copy));
+
+  // Deep copy: updating the copy does not change the original
+  copy.update(X(1), Pose3(Rot3(), Point3(1, 1, 1)));
+  EXPECT(!flat.equals(copy));
+  EXPECT(assert_equal(Pose3(), flat.at<Pose3>(X(1))));
+
+  FlatValues assigned;
+  assigned = copy;
+  EXPECT(assert_equal(copy, assigned));
+  assigned.clear();
+  EXPECT(assigned.empty());
+}
+
+/* ************************************************************************* */
+TEST(FlatValues, DynamicInsertFixedRead) {
+  FlatValues flat;
+  Vector v(3); v << 5.0, 6.0, 7.0;
+  flat.insert(X(1), v);
+  Vector3 expected(5.0, 6.0, 7.0);
+  EXPECT(assert_equal(expected, flat.at<Vector3>(X(1))));
+  CHECK_EXCEPTION(flat.at<Vector7>(X(1)), NoMatchFoundForFixed);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
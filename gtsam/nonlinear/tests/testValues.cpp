@@ -235,6 +235,49 @@ TEST(Values, retract_partial)
   CHECK(assert_equal(expected, Values(config0, delta)));
 }
 
+/* ************************************************************************* */
+TEST(Values, retractInPlace)
+{
+  Values config;
+  config.insert(key1, Vector3(1.0, 2.0, 3.0));
+  config.insert(key2, Vector3(5.0, 6.0, 7.0));
+
+  // key3 is not in config, and is ignored as in retract
+  VectorValues delta = pair_list_of<Key, Vector>
+    (key2, Vector3(1.3, 1.4, 1.5))
+    (key3, Vector3(1.0, 1.0, 1.0));
+
+  Values expected = config.retract(delta);
+  const Value* stored = &config.at(key2);
+  config.retractInPlace(delta);
+  CHECK(assert_equal(expected, config));
+  CHECK(stored == &config.at(key2)); // not reallocated
+}
+
+/* ************************************************************************* */
+TEST(Values, retractMasked)
+{
+  Values config;
+  config.insert(key1, Vector3(1.0, 2.0, 3.0));
+  config.insert(key2, Vector3(5.0, 6.0, 7.0));
+
+  VectorValues delta = pair_list_of<Key, Vector>
+    (key1, Vector3(1.0, 1.1, 1.2))
+    (key2, Vector3(1.3, 1.4, 1.5));
+
+  Values expected;
+  expected.insert(key1, Vector3(1.0, 2.0, 3.0));
+  expected.insert(key2, Vector3(6.3, 7.4, 8.5));
+
+  KeySet mask;
+  mask.insert(key2);
+  config.retractMasked(delta, mask);
+  CHECK(assert_equal(expected, config));
+
+  mask.insert(key3);
+  CHECK_EXCEPTION(config.retractMasked(delta, mask), ValuesKeyDoesNotExist);
+}
+
 /* ************************************************************************* */
 TEST(Values, equals)
 {
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <ostream>
+#include <typeinfo>
 
 #include <gtsam/base/Testable.h>
 #include <gtsam/base/Lie.h>
@@ -102,6 +103,26 @@ namespace gtsam {
 #endif
     }
 
+    /// Non-virtual kernel for NonlinearFactorGraph::whitenedErrors
+    virtual void whitenedErrors(NoiseModelFactor::FactorIterator first,
+        NoiseModelFactor::FactorIterator last, const Values& x, Vector& out,
+        size_t offset) const {
+      // Derived classes may have overridden evaluateError
+      if (typeid(*this) != typeid(This)) {
+        Base::whitenedErrors(first, last, x, out, offset);
+        return;
+      }
+      for (NoiseModelFactor::FactorIterator it = first; it != last; ++it) {
+        const This& factor = static_cast<const This&>(**it);
+        const SharedNoiseModel& model = factor.noiseModel_;
+        Eigen::Block<Vector> e(out, offset, 0, model->dim(), 1);
+        e = traits<T>::Local(factor.measured_,
+            traits<T>::Between(x.at<T>(factor.key1()), x.at<T>(factor.key2())));
+        model->whitenInPlace(e);
+        offset += model->dim();
+      }
+    }
+
     /** return the measured */
     const VALUE& measured() const {
       return measured_;
@@ -18,6 +18,8 @@
 #include <gtsam/nonlinear/NonlinearFactor.h>
 #include <gtsam/base/Testable.h>
 
+#include <typeinfo>
+
 namespace gtsam {
 
   /**
@@ -92,6 +94,25 @@ namespace gtsam {
       return -traits<T>::Local(x, prior_);
     }
 
+    /// Non-virtual kernel for NonlinearFactorGraph::whitenedErrors
+    virtual void whitenedErrors(NoiseModelFactor::FactorIterator first,
+        NoiseModelFactor::FactorIterator last, const Values& x, Vector& out,
+        size_t offset) const {
+      // Derived classes may have overridden evaluateError
+      if (typeid(*this) != typeid(This)) {
+        Base::whitenedErrors(first, last, x, out, offset);
+        return;
+      }
+      for (NoiseModelFactor::FactorIterator it = first; it != last; ++it) {
+        const This& factor = static_cast<const This&>(**it);
+        const SharedNoiseModel& model = factor.noiseModel_;
+        Eigen::Block<Vector> e(out, offset, 0, model->dim(), 1);
+        e = -traits<T>::Local(x.at<T>(factor.key()), factor.prior_);
+        model->whitenInPlace(e);
+        offset += model->dim();
+      }
+    }
+
     const VALUE & prior() const { return prior_; }
 
   private:
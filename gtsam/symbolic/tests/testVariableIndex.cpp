@@ -143,6 +143,33 @@ TEST(VariableIndex, deep_copy) {
   EXPECT(assert_equal(expectedRemoved, clone));
 }
 
+/* ************************************************************************* */
+TEST(VariableIndex, parallel) {
+
+  auto fg1 = testGraph1(), fg2 = testGraph2();
+
+  // Small graph with an empty factor, fewer factors than some of the threads
+  SymbolicFactorGraph fgCombined;
+  fgCombined.push_back(fg1);
+  fgCombined.push_back(SymbolicFactor::shared_ptr());
+  fgCombined.push_back(fg2);
+  EXPECT(assert_equal(VariableIndex(fgCombined), VariableIndex(fgCombined, 3)));
+  EXPECT(assert_equal(VariableIndex(fgCombined), VariableIndex(fgCombined, 16)));
+
+  // Larger graph where the keys of each thread's factors interleave
+  SymbolicFactorGraph grid;
+  for (Key i = 0; i < 50; ++i)
+    for (Key j = 0; j < 50; ++j) {
+      if (i + 1 < 50) grid.push_factor(50 * i + j, 50 * (i + 1) + j);
+      if (j + 1 < 50) grid.push_factor(50 * i + j, 50 * i + j + 1);
+      if ((i + j) % 7 == 0) grid.push_factor(50 * j + i);
+    }
+  VariableIndex expected(grid), actual(grid, 4);
+  LONGS_EQUAL(expected.nEntries(), actual.nEntries());
+  LONGS_EQUAL(expected.nFactors(), actual.nFactors());
+  EXPECT(assert_equal(expected, actual));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
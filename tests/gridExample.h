@@ -0,0 +1,58 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    gridExample.h
+ * @brief   Linear grid graphs shared by the tests of sparse linear solvers
+ * @date    Oct 16, 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/GaussianFactorGraph.h>
+
+namespace gtsam {
+namespace example {
+
+/**
+ * Create a rows x cols grid of variables of dimension \c dim, numbered row by
+ * row, with factors between horizontal and vertical neighbours, so that
+ * elimination creates fill-in.  With \c priorOnAll every variable has a
+ * prior, otherwise only variable 0.  The structure only depends on the size,
+ * and the values also on \c scale, so that grids with different scales have
+ * the same sparsity pattern.
+ */
+inline GaussianFactorGraph createGaussianGrid(size_t rows, size_t cols,
+                                              size_t dim, double scale = 1.0,
+                                              bool priorOnAll = true) {
+  GaussianFactorGraph graph;
+  const SharedDiagonal model = noiseModel::Isotropic::Sigma(dim, 0.5);
+  const Matrix I = Matrix::Identity(dim, dim);
+  for (Key key = 0; key < rows * cols; ++key) {
+    // A non-symmetric, well-conditioned block that differs per variable
+    const double s = scale + 0.1 * key;
+    Matrix A = I;
+    A(0, 1) = 0.1 * s;
+    A(1, 0) = 0.2;
+    A(dim - 1, dim - 1) = 2.0;
+    const Vector b = Vector::LinSpaced(dim, s, -1.0);
+
+    if (priorOnAll || key == 0) graph.add(key, s * I, b, model);
+    if (key % cols + 1 < cols)
+      graph.add(key, A, key + 1, -I, 0.1 * b, model);
+    if (key + cols < rows * cols)
+      graph.add(key, -I, key + cols, A.transpose(), b.reverse(), model);
+  }
+  return graph;
+}
+
+}  // namespace example
+}  // namespace gtsam
@@ -452,6 +452,59 @@ TEST(ISAM2, removeVariables)
   CHECK(isam_check(fullgraph, fullinit, isam, *this, result_));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, calculateEstimate_cached)
+{
+  // Relinearize only some variables, and ask for the estimate at every step
+  const vector<ISAM2Params> params = {
+      ISAM2Params(ISAM2GaussNewtonParams(0.001), 0.05, 1, true),
+      ISAM2Params(ISAM2DoglegParams(), 0.05, 1, true)};
+  for (const ISAM2Params& p : params) {
+    ISAM2 isam(p);
+    NonlinearFactorGraph prior;
+    prior += PriorFactor<Pose2>(0, Pose2(), odoNoise);
+    Values init;
+    init.insert(0, Pose2(0.01, 0.01, 0.01));
+    isam.update(prior, init);
+    for (size_t i = 1; i < 20; ++i) {
+      NonlinearFactorGraph newfactors;
+      newfactors += BetweenFactor<Pose2>(i - 1, i, Pose2(1.0, 0.0, M_PI / 8.0),
+                                         odoNoise);
+      if (i % 5 == 0)
+        newfactors += PriorFactor<Pose2>(i, Pose2(i, 0.5, 0.0), odoNoise);
+      Values newTheta;
+      newTheta.insert(i, Pose2(i + 0.2, -0.3, 0.1));
+      isam.update(newfactors, newTheta);
+
+      // The cached estimate is only updated where delta or theta changed
+      const Values expected =
+          isam.getLinearizationPoint().retract(isam.getDelta());
+      EXPECT(assert_equal(expected, isam.calculateEstimate()));
+
+      // getEstimate does not copy
+      const Values& estimate = isam.getEstimate();
+      EXPECT(&estimate == &isam.getEstimate());
+      EXPECT(assert_equal(expected, estimate));
+    }
+  }
+
+  // Removing a variable also removes it from the cached estimate
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2 isam = createSlamlikeISAM2(
+      fullinit, fullgraph,
+      ISAM2Params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false));
+  EXPECT(isam.calculateEstimate().exists(100));
+  FactorIndices toRemove;
+  toRemove.push_back(7);
+  toRemove.push_back(14);
+  isam.update(NonlinearFactorGraph(), Values(), toRemove);
+  const Values actual = isam.calculateEstimate();
+  EXPECT(!actual.exists(100));
+  EXPECT(assert_equal(
+      isam.getLinearizationPoint().retract(isam.getDelta()), actual));
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, swapFactors)
 {
@@ -645,6 +698,159 @@ TEST(ISAM2, slamlike_solution_partial_relinearization_check)
   CHECK(isam_check(fullgraph, fullinit, isam, *this, result_));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, slamlike_solution_multithreaded)
+{
+  // Relinearize everything at every step, with one and with four threads
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.0, 1, true);
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2 serial = createSlamlikeISAM2(fullinit, fullgraph, params);
+
+  params.numThreads = 4;
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph, params);
+
+  // Linearization is the only thing done in parallel, so results agree
+  EXPECT(assert_equal(serial.calculateEstimate(), isam.calculateEstimate()));
+  EXPECT(assert_equal(serial.getLinearizationPoint(),
+                      isam.getLinearizationPoint()));
+}
+
+/* ************************************************************************* */
+#ifdef GTSAM_SUPPORT_NESTED_DISSECTION
+TEST(ISAM2, slamlike_solution_metis)
+{
+  // Nested dissection for both batch and incremental re-eliminations
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false);
+  params.orderingType = Ordering::METIS;
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph, params);
+
+  // Compare solutions
+  CHECK(isam_check(fullgraph, fullinit, isam, *this, result_));
+
+  // A loop closure to the first pose triggers a batch step, which keeps the
+  // observed keys last: the root ends with one of them
+  NonlinearFactorGraph newfactors;
+  newfactors += BetweenFactor<Pose2>(0, 50, Pose2(1.0, 0.0, 0.0), odoNoise);
+  Values init;
+  init.insert(50, Pose2(1.01, 0.01, 0.01));
+  isam.update(newfactors, init);
+  fullgraph.push_back(newfactors);
+  fullinit.insert(init);
+  const auto& frontals = isam.roots().front()->conditional()->frontals();
+  EXPECT(frontals.back() == 0 || frontals.back() == 50);
+  CHECK(isam_check(fullgraph, fullinit, isam, *this, result_));
+}
+#endif
+
+/* ************************************************************************* */
+TEST(ISAM2, maxRelinearizedVariables)
+{
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 1e-4, 1, true);
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2 unlimited = createSlamlikeISAM2(fullinit, fullgraph, params);
+
+  params.maxRelinearizedVariables = 2;
+  params.enableDetailedResults = true;
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph, params);
+
+  // Keep updating until nothing is deferred anymore
+  size_t totalDeferred = 0;
+  for (size_t i = 0; i < 100; ++i) {
+    unlimited.update();
+    ISAM2Result result = isam.update();
+    size_t aboveThreshold = 0, deferred = 0;
+    for (const auto& key_status : result.detail->variableStatus) {
+      if (key_status.second.isAboveRelinThreshold) ++aboveThreshold;
+      if (key_status.second.isDeferred) ++deferred;
+    }
+    EXPECT(aboveThreshold <= 2);
+    EXPECT_LONGS_EQUAL(result.variablesDeferred, deferred);
+    totalDeferred += deferred;
+    if (i > 10 && result.variablesDeferred == 0) break;
+  }
+  EXPECT(totalDeferred > 0);
+
+  // Both converge to the same solution, up to the wildfire threshold
+  EXPECT(assert_equal(unlimited.calculateEstimate(), isam.calculateEstimate(),
+                      1e-3));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, parallel_backsubstitution)
+{
+  // Large enough to back-substitute in parallel: a pose chain with loop
+  // closures, added in batches
+  const size_t n = 1200;
+  NonlinearFactorGraph graph;
+  Values init;
+  graph += PriorFactor<Pose2>(0, Pose2(), odoNoise);
+  init.insert(0, Pose2());
+  for (size_t i = 1; i < n; ++i) {
+    graph += BetweenFactor<Pose2>(i - 1, i, Pose2(1.0, 0.0, 0.01), odoNoise);
+    if (i >= 100 && i % 10 == 0)
+      graph += BetweenFactor<Pose2>(i - 100, i, Pose2(100.0, 0.0, 1.0),
+                                    odoNoise);
+    init.insert(i, Pose2(double(i), 0.1, 0.0));
+  }
+
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.1, 1, true);
+  ISAM2 serial(params);
+  params.numThreads = 4;
+  ISAM2 parallel(params);
+  for (size_t first = 0; first < graph.size(); first += 200) {
+    NonlinearFactorGraph batch;
+    Values newValues;
+    for (size_t k = first; k < std::min(first + 200, graph.size()); ++k) {
+      batch.push_back(graph[k]);
+      for (Key key : graph[k]->keys())
+        if (!serial.valueExists(key) && !newValues.exists(key))
+          newValues.insert(key, init.at(key));
+    }
+    serial.update(batch, newValues);
+    parallel.update(batch, newValues);
+  }
+
+  // Wildfire and full back-substitution give the same results
+  EXPECT(assert_equal(serial.calculateEstimate(),
+                      parallel.calculateEstimate(), 0.0));
+  EXPECT(assert_equal(serial.calculateBestEstimate(),
+                      parallel.calculateBestEstimate(), 0.0));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, updateTimeBudget)
+{
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 1e-4, 1, true);
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2 unlimited = createSlamlikeISAM2(fullinit, fullgraph, params);
+
+  // A budget too small for any clique, so that once the cost per variable is
+  // measured, a single variable is relinearized per update
+  params.updateTimeBudget = 1e-12;
+  params.enableDetailedResults = true;
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph, params);
+
+  size_t totalDeferred = 0;
+  for (size_t i = 0; i < 200; ++i) {
+    unlimited.update();
+    ISAM2Result result = isam.update();
+    size_t aboveThreshold = 0;
+    for (const auto& key_status : result.detail->variableStatus)
+      if (key_status.second.isAboveRelinThreshold) ++aboveThreshold;
+    EXPECT(aboveThreshold <= 1);
+    totalDeferred += result.variablesDeferred;
+    if (i > 10 && result.variablesDeferred == 0) break;
+  }
+  EXPECT(totalDeferred > 0);
+  EXPECT(assert_equal(unlimited.calculateEstimate(), isam.calculateEstimate(),
+                      1e-4));
+}
+
 namespace {
   bool checkMarginalizeLeaves(ISAM2& isam, const FastList<Key>& leafKeys) {
     Matrix expectedAugmentedHessian, expected3AugmentedHessian;
@@ -24,10 +24,16 @@
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/symbolic/SymbolicFactorGraph.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/linear/HessianFactor.h>
 #include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/nonlinear/ExpressionFactor.h>
 #include <gtsam/sam/RangeFactor.h>
 #include <gtsam/slam/PriorFactor.h>
 #include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/GeneralSFMFactor.h>
+#include <gtsam/slam/expressions.h>
 
 #include <CppUnitLite/TestHarness.h>
 
@@ -66,6 +72,47 @@ TEST( NonlinearFactorGraph, error )
   DOUBLES_EQUAL( 5.625, actual2, 1e-9 );
 }
 
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, whitenedErrors )
+{
+  // Runs of between factors with different noise models, broken up by other
+  // factor types and a null factor
+  NonlinearFactorGraph fg;
+  Values values;
+  const SharedNoiseModel diagonal = noiseModel::Diagonal::Sigmas(Vector3(0.1, 0.2, 0.05));
+  const SharedNoiseModel isotropic = noiseModel::Isotropic::Sigma(3, 0.5);
+  const SharedNoiseModel robust = noiseModel::Robust::Create(
+      noiseModel::mEstimator::Huber::Create(1.0), isotropic);
+  const SharedNoiseModel constrained = noiseModel::Constrained::MixedSigmas(Vector3(0.0, 0.1, 0.1));
+  fg += PriorFactor<Pose2>(X(0), Pose2(), diagonal);
+  values.insert(X(0), Pose2(0.1, -0.1, 0.05));
+  for (size_t i = 1; i < 1500; ++i) {
+    const SharedNoiseModel& model =
+        i % 7 == 0 ? robust : (i % 11 == 0 ? constrained : (i % 2 ? isotropic : diagonal));
+    fg += BetweenFactor<Pose2>(X(i - 1), X(i), Pose2(1.0, 0.1, 0.01), model);
+    values.insert(X(i), Pose2(i * 1.01, 0.02 * i, 0.001 * i));
+    if (i == 500) fg.push_back(NonlinearFactorGraph::sharedFactor());
+    if (i % 100 == 0)
+      fg += RangeFactor<Pose2, Pose2>(X(i), X(i - 100), 99.0, noiseModel::Unit::Create(1));
+  }
+
+  for (size_t numThreads : {1, 3}) {
+    const WhitenedErrors actual = fg.whitenedErrors(values, numThreads);
+    LONGS_EQUAL((long)fg.size(), (long)actual.size());
+    const Vector squaredNorms = actual.squaredNorms();
+    for (size_t i = 0; i < fg.size(); ++i) {
+      auto factor = boost::dynamic_pointer_cast<NoiseModelFactor>(fg[i]);
+      if (!factor) {
+        LONGS_EQUAL(0, actual[i].size());
+        continue;
+      }
+      const Vector expected = factor->whitenedError(values);
+      EXPECT(assert_equal(expected, Vector(actual[i]), 1e-9));
+      EXPECT_DOUBLES_EQUAL(expected.squaredNorm(), squaredNorms(i), 1e-9);
+    }
+  }
+}
+
 /* ************************************************************************* */
 TEST( NonlinearFactorGraph, keys )
 {
@@ -116,6 +163,130 @@ TEST( NonlinearFactorGraph, linearize )
   CHECK(assert_equal(expected,linearFG)); // Needs correct linearizations
 }
 
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, linearizeInto )
+{
+  NonlinearFactorGraph fg = createNonlinearFactorGraph();
+  GaussianFactorGraph linearFG = *fg.linearize(createValues());
+  const GaussianFactor* first = linearFG[0].get();
+
+  // Relinearizing overwrites the existing factors in place
+  Values initial = createNoisyValues();
+  fg.linearizeInto(initial, linearFG);
+  EXPECT(assert_equal(createGaussianFactorGraph(), linearFG));
+  EXPECT(first == linearFG[0].get());
+
+  // A factor that is shared with someone else is not overwritten
+  GaussianFactor::shared_ptr shared = linearFG[0];
+  fg.linearizeInto(createValues(), linearFG);
+  EXPECT(shared.get() != linearFG[0].get());
+  EXPECT(assert_equal(*createGaussianFactorGraph()[0], *shared));
+  EXPECT(assert_equal(*fg.linearize(createValues()), linearFG));
+}
+
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, linearizeIntoOverridden )
+{
+  // Factors that override linearize are linearized the same way in place
+  typedef PinholeCamera<Cal3_S2> Camera;
+  NonlinearFactorGraph fg;
+  fg.emplace_shared<ExpressionFactor<Point2> >(
+      noiseModel::Isotropic::Sigma(2, 0.5), Point2(1, 2), Point2_(1));
+  fg.emplace_shared<GeneralSFMFactor<Camera, Point3> >(
+      Point2(320, 240), noiseModel::Isotropic::Sigma(2, 1.0), 2, 3);
+  Values values;
+  values.insert(1, Point2(0.5, 1.5));
+  values.insert(2, Camera(Pose3(), Cal3_S2(500, 500, 0, 320, 240)));
+  values.insert(3, Point3(0.1, -0.2, 5));
+
+  GaussianFactorGraph linearFG = *fg.linearize(values);
+  const GaussianFactor* first = linearFG[0].get();
+  values.update(1, Point2(0.7, 1.1));
+  values.update(3, Point3(0.2, 0.1, 4));
+  fg.linearizeInto(values, linearFG);
+
+  const GaussianFactorGraph expected = *fg.linearize(values);
+  EXPECT(assert_equal(expected, linearFG));
+  EXPECT(first == linearFG[0].get());
+  EXPECT(typeid(*expected[1]) == typeid(*linearFG[1]));
+}
+
+/* ************************************************************************* */
+namespace {
+// A prior whose linearize override returns a HessianFactor
+struct HessianPrior : public PriorFactor<Point2> {
+  HessianPrior(Key key, const Point2& prior, const SharedNoiseModel& model)
+      : PriorFactor<Point2>(key, prior, model) {}
+  boost::shared_ptr<GaussianFactor> linearize(const Values& x) const override {
+    return boost::make_shared<HessianFactor>(
+        *PriorFactor<Point2>::linearize(x));
+  }
+};
+}
+
+TEST( NonlinearFactorGraph, linearizeIntoSubclass )
+{
+  // A linearize override in a subclass of an in-place factor is never skipped
+  NonlinearFactorGraph fg;
+  fg.emplace_shared<HessianPrior>(1, Point2(1, 2),
+      noiseModel::Isotropic::Sigma(2, 0.5));
+  Values values;
+  values.insert(1, Point2(0.5, 1.5));
+
+  GaussianFactorGraph linearFG = *fg.linearize(values);
+  values.update(1, Point2(0.7, 1.1));
+  fg.linearizeInto(values, linearFG);
+
+  const GaussianFactorGraph expected = *fg.linearize(values);
+  EXPECT(assert_equal(expected, linearFG));
+  EXPECT(boost::dynamic_pointer_cast<HessianFactor>(linearFG[0]));
+}
+
+/* ************************************************************************* */
+namespace {
+// A prior that moves its measurement to the estimate when refreshed
+struct RefreshedPrior : public PriorFactor<Point2> {
+  RefreshedPrior(Key key, const Point2& prior, const SharedNoiseModel& model)
+      : PriorFactor<Point2>(key, prior, model) {}
+  NonlinearFactor::shared_ptr clone() const override {
+    return boost::make_shared<RefreshedPrior>(*this);
+  }
+  bool needsRefresh(const Values& x) const override {
+    return x.at<Point2>(key()) != prior();
+  }
+  bool refresh(const Values& x) override {
+    if (!needsRefresh(x)) return false;
+    *this = RefreshedPrior(key(), x.at<Point2>(key()), noiseModel());
+    return true;
+  }
+};
+}
+
+TEST( NonlinearFactorGraph, refresh )
+{
+  NonlinearFactorGraph fg;
+  fg.emplace_shared<RefreshedPrior>(1, Point2(1, 2),
+      noiseModel::Isotropic::Sigma(2, 0.5));
+  Values values;
+  values.insert(1, Point2(1, 2));
+  EXPECT(!fg.refresh(values));
+
+  // A factor shared with another graph is cloned before it changes
+  NonlinearFactorGraph copy = fg;
+  values.update(1, Point2(3, 4));
+  EXPECT(copy.refresh(values));
+  EXPECT(copy[0] != fg[0]);
+  EXPECT_DOUBLES_EQUAL(0.0, copy.error(values), 1e-9);
+  EXPECT_DOUBLES_EQUAL(16.0, fg.error(values), 1e-9);
+
+  // and refreshed in place once this graph is its only owner
+  const NonlinearFactor* refreshed = copy[0].get();
+  values.update(1, Point2(5, 6));
+  EXPECT(copy.refresh(values));
+  EXPECT(copy[0].get() == refreshed);
+  EXPECT(!copy.refresh(values));
+}
+
 /* ************************************************************************* */
 TEST( NonlinearFactorGraph, clone )
 {
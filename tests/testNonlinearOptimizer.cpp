@@ -24,6 +24,7 @@
 #include <gtsam/nonlinear/DoglegOptimizer.h>
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/SupernodalCholesky.h>
 #include <gtsam/linear/NoiseModel.h>
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/geometry/Pose2.h>
@@ -171,6 +172,11 @@ TEST( NonlinearOptimizer, optimization_method )
 
   Values actualMFChol = LevenbergMarquardtOptimizer(fg, c0, paramsChol).optimize();
   DOUBLES_EQUAL(0,fg.error(actualMFChol),tol);
+
+  LevenbergMarquardtParams paramsCholmod;
+  paramsCholmod.linearSolverType = LevenbergMarquardtParams::CHOLMOD;
+  Values actualCholmod = LevenbergMarquardtOptimizer(fg, c0, paramsCholmod).optimize();
+  DOUBLES_EQUAL(0,fg.error(actualCholmod),tol);
 }
 
 /* ************************************************************************* */
@@ -236,6 +242,92 @@ TEST(NonlinearOptimizer, NullFactor) {
   DOUBLES_EQUAL(0,fg.error(actual3),tol);
 }
 
+/* ************************************************************************* */
+// Addresses of the factors of a linear graph
+static vector<const GaussianFactor*> factorAddresses(const GaussianFactorGraph& graph) {
+  vector<const GaussianFactor*> addresses;
+  for (const GaussianFactor::shared_ptr& factor : graph)
+    addresses.push_back(factor.get());
+  return addresses;
+}
+
+/* ************************************************************************* */
+TEST(NonlinearOptimizer, ReuseLinearization) {
+  // A small pose graph, solved with the default multifrontal Cholesky
+  NonlinearFactorGraph fg;
+  fg += PriorFactor<Pose2>(X(0), Pose2(), noiseModel::Isotropic::Sigma(3, 0.1));
+  Values init;
+  init.insert(X(0), Pose2(0.1, -0.1, 0.05));
+  for (size_t k = 1; k < 5; k++) {
+    fg += BetweenFactor<Pose2>(X(k - 1), X(k), Pose2(1, 0, 0.2),
+                               noiseModel::Isotropic::Sigma(3, 0.1));
+    init.insert(X(k), Pose2(1.1 * k, 0.2 * k, 0.1 * k));
+  }
+
+  // Each iteration overwrites the JacobianFactors of the previous one: neither
+  // the damped system nor the cached junction tree keep them alive
+  LevenbergMarquardtOptimizer lm(fg, init);
+  const vector<const GaussianFactor*> lmFactors = factorAddresses(*lm.iterate());
+  EXPECT(lmFactors == factorAddresses(*lm.iterate()));
+  EXPECT(lmFactors == factorAddresses(*lm.iterate()));
+
+  GaussNewtonOptimizer gn(fg, init);
+  const vector<const GaussianFactor*> gnFactors = factorAddresses(*gn.iterate());
+  EXPECT(gnFactors == factorAddresses(*gn.iterate()));
+
+  // A linearization the caller holds on to is not overwritten
+  GaussianFactorGraph::shared_ptr held = gn.iterate();
+  EXPECT(gnFactors == factorAddresses(*held));
+  EXPECT(gnFactors != factorAddresses(*gn.iterate()));
+}
+
+/* ************************************************************************* */
+// Levenberg-Marquardt that exposes the cached supernodal Cholesky
+class SupernodalLM : public LevenbergMarquardtOptimizer {
+public:
+  SupernodalLM(const NonlinearFactorGraph& graph, const Values& initialValues,
+               const LevenbergMarquardtParams& params)
+      : LevenbergMarquardtOptimizer(graph, initialValues, params) {}
+  const SupernodalCholesky* supernodal() const { return supernodal_.get(); }
+};
+
+/* ************************************************************************* */
+TEST(NonlinearOptimizer, ReuseSupernodalCholesky) {
+  NonlinearFactorGraph fg;
+  fg += PriorFactor<Pose2>(X(0), Pose2(), noiseModel::Isotropic::Sigma(3, 0.1));
+  Values init;
+  init.insert(X(0), Pose2(0.1, -0.1, 0.05));
+  for (size_t k = 1; k < 5; k++) {
+    fg += BetweenFactor<Pose2>(X(k - 1), X(k), Pose2(1, 0, 0.2),
+                               noiseModel::Isotropic::Sigma(3, 0.1));
+    init.insert(X(k), Pose2(1.1 * k, 0.2 * k, 0.1 * k));
+  }
+
+  // The symbolic analysis of the first iteration is re-used by the next ones
+  LevenbergMarquardtParams params;
+  params.linearSolverType = LevenbergMarquardtParams::CHOLMOD;
+  SupernodalLM lm(fg, init, params);
+  EXPECT(!lm.supernodal());
+  lm.iterate();
+  const SupernodalCholesky* first = lm.supernodal();
+  EXPECT(first);
+  lm.iterate();
+  EXPECT(first == lm.supernodal());
+
+  // Until it is invalidated
+  lm.invalidateSymbolicStructure();
+  EXPECT(!lm.supernodal());
+  lm.iterate();
+  EXPECT(lm.supernodal());
+
+  LevenbergMarquardtParams multifrontal;
+  LevenbergMarquardtOptimizer expected(fg, init, multifrontal);
+  expected.iterate();
+  expected.iterate();
+  expected.iterate();
+  EXPECT(assert_equal(expected.values(), lm.values(), 1e-6));
+}
+
 /* ************************************************************************* */
 TEST_UNSAFE(NonlinearOptimizer, MoreOptimization) {
 
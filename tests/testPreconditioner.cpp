@@ -23,7 +23,10 @@
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/linear/Preconditioner.h>
 #include <gtsam/linear/PCGSolver.h>
+#include <gtsam/linear/IncompleteCholeskyPreconditioner.h>
+#include <gtsam/linear/MultigridPreconditioner.h>
 #include <gtsam/geometry/Point2.h>
+#include <tests/gridExample.h>
 
 using namespace std;
 using namespace gtsam;
@@ -122,6 +125,82 @@ TEST(PCGSolver, simpleLinearSystem) {
   EXPECT(assert_equal(expectedSolution, deltaPCGJacobi, 1e-5));
   //deltaPCGJacobi.print("PCG Jacobi");
 
+  // With incomplete Cholesky preconditioners
+  pcg->preconditioner_ = boost::make_shared<gtsam::IncompleteCholeskyPreconditionerParameters>();
+  VectorValues deltaPCGIC0 = PCGSolver(*pcg).optimize(simpleGFG);
+  EXPECT(assert_equal(expectedSolution, deltaPCGIC0, 1e-5));
+  pcg->preconditioner_ = boost::make_shared<gtsam::IncompleteCholeskyPreconditionerParameters>(1e-3);
+  VectorValues deltaPCGICT = PCGSolver(*pcg).optimize(simpleGFG);
+  EXPECT(assert_equal(expectedSolution, deltaPCGICT, 1e-5));
+
+  // With multigrid preconditioner, which is a direct solve for a small system
+  pcg->preconditioner_ = boost::make_shared<gtsam::MultigridPreconditionerParameters>();
+  VectorValues deltaPCGMultigrid = PCGSolver(*pcg).optimize(simpleGFG);
+  EXPECT(assert_equal(expectedSolution, deltaPCGMultigrid, 1e-5));
+}
+
+/* ************************************************************************* */
+// A 10x10 grid of 3-dimensional variables, with a single prior
+static GaussianFactorGraph createGrid() {
+  return example::createGaussianGrid(10, 10, 3, 1.0, false);
+}
+
+/* ************************************************************************* */
+TEST(PCGSolver, incompleteCholesky) {
+  const GaussianFactorGraph graph = createGrid();
+  const VectorValues expected = graph.optimize();
+  const KeyInfo keyInfo(graph);
+  const std::map<Key, Vector> lambda;
+
+  gtsam::PCGSolverParameters::shared_ptr pcg = boost::make_shared<gtsam::PCGSolverParameters>();
+  pcg->setEpsilon_abs(1e-20);
+  pcg->setEpsilon_rel(1e-12);
+
+  // IC(0) keeps the pattern of the Hessian
+  IncompleteCholeskyPreconditioner ic0;
+  ic0.build(graph, keyInfo, lambda);
+  EXPECT_LONGS_EQUAL(100 + 180, ic0.nnzBlocks());
+  pcg->preconditioner_ = boost::make_shared<IncompleteCholeskyPreconditionerParameters>();
+  EXPECT(assert_equal(expected, PCGSolver(*pcg).optimize(graph), 1e-6));
+
+  // ICT with a zero drop tolerance is the complete factorization
+  IncompleteCholeskyPreconditioner ict(IncompleteCholeskyPreconditionerParameters(1e-30));
+  ict.build(graph, keyInfo, lambda);
+  EXPECT(ict.nnzBlocks() > ic0.nnzBlocks());
+  const Vector b = expected.vector(keyInfo.ordering());
+  const Matrix H = graph.hessian(keyInfo.ordering()).first;
+  Vector x;
+  ict.precondition(H * b, x);
+  EXPECT(assert_equal(b, x, 1e-6));
+}
+
+/* ************************************************************************* */
+TEST(PCGSolver, multigrid) {
+  const GaussianFactorGraph graph = createGrid();
+  const VectorValues expected = graph.optimize();
+  const KeyInfo keyInfo(graph);
+
+  MultigridPreconditionerParameters parameters;
+  parameters.coarsestDim_ = 10;
+  MultigridPreconditioner multigrid(parameters);
+  multigrid.build(graph, keyInfo, std::map<Key, Vector>());
+  EXPECT(multigrid.numLevels() > 2);
+  EXPECT_LONGS_EQUAL(300, multigrid.levelDim(0));
+  EXPECT(multigrid.levelDim(1) < 300);
+
+  // The V-cycle is symmetric
+  const Vector u = Vector::LinSpaced(300, -1.0, 2.0);
+  const Vector v = Vector::LinSpaced(300, 3.0, 0.5).array().sin();
+  Vector Mu, Mv;
+  multigrid.precondition(u, Mu);
+  multigrid.precondition(v, Mv);
+  EXPECT_DOUBLES_EQUAL(v.dot(Mu), u.dot(Mv), 1e-9 * std::abs(v.dot(Mu)));
+
+  gtsam::PCGSolverParameters::shared_ptr pcg = boost::make_shared<gtsam::PCGSolverParameters>();
+  pcg->setEpsilon_abs(1e-20);
+  pcg->setEpsilon_rel(1e-12);
+  pcg->preconditioner_ = boost::make_shared<MultigridPreconditionerParameters>(parameters);
+  EXPECT(assert_equal(expected, PCGSolver(*pcg).optimize(graph), 1e-6));
 }
 
 /* ************************************************************************* */
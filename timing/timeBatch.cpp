@@ -19,9 +19,33 @@
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
 #include <gtsam/nonlinear/Marginals.h>
 
+#include <chrono>
+
 using namespace std;
 using namespace gtsam;
 
+// Time linearize and error with 1, 2, 4 and 8 threads
+static void timeThreads(const NonlinearFactorGraph& graph,
+                        const Values& values) {
+  typedef std::chrono::steady_clock Clock;
+  const size_t trials = 10;
+  for (size_t numThreads = 1; numThreads <= 8; numThreads *= 2) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < trials; ++i) graph.linearize(values, numThreads);
+    Clock::time_point middle = Clock::now();
+    double error = 0.0;
+    for (size_t i = 0; i < trials; ++i) error = graph.error(values, numThreads);
+    Clock::time_point stop = Clock::now();
+    cout << numThreads << " threads: linearize "
+         << std::chrono::duration<double, std::milli>(middle - start).count() /
+                trials
+         << " ms, error "
+         << std::chrono::duration<double, std::milli>(stop - middle).count() /
+                trials
+         << " ms (error = " << error << ")" << endl;
+  }
+}
+
 int main(int argc, char *argv[]) {
 
   try {
@@ -35,6 +59,9 @@ int main(int argc, char *argv[]) {
     NonlinearFactorGraph graph = *data.first;
     Values initial = *data.second;
 
+    cout << "Timing linearization..." << endl;
+    timeThreads(graph, initial);
+
     cout << "Optimizing..." << endl;
 
     gttic_(Create_optimizer);
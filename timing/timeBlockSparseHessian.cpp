@@ -0,0 +1,87 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeBlockSparseHessian.cpp
+ * @brief   Time the products with A'A in PCG: GaussianFactorGraph on
+ * VectorValues against BlockSparseHessian, on the linearized sphere dataset
+ *
+ * Usage: timeBlockSparseHessian [numThreads]
+ */
+
+#include <gtsam/slam/dataset.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/linear/BlockSparseHessian.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/PCGSolver.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/geometry/Pose3.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+
+static const size_t kProducts = 200;
+
+/* ************************************************************************* */
+int main(int argc, char* argv[]) {
+  const size_t numThreads = argc > 1 ? atoi(argv[1]) : 4;
+
+  // Linearize at the chained odometry
+  NonlinearFactorGraph graph;
+  Values initial;
+  initial.insert(0, Pose3());
+  for (const BetweenFactor<Pose3>::shared_ptr& factor :
+       parse3DFactors(findExampleDataFile("sphere2500.txt"))) {
+    graph.push_back(factor);
+    if (factor->key2() == factor->key1() + 1 && !initial.exists(factor->key2()))
+      initial.insert(factor->key2(),
+                     initial.at<Pose3>(factor->key1()) * factor->measured());
+  }
+  graph.emplace_shared<PriorFactor<Pose3> >(
+      0, Pose3(), noiseModel::Isotropic::Sigma(6, 1e-3));
+  const GaussianFactorGraph::shared_ptr linear = graph.linearize(initial);
+  const KeyInfo keyInfo(*linear);
+  const Vector x = Vector::Ones(keyInfo.numCols());
+  cout << "sphere2500: " << linear->size() << " factors, " << keyInfo.size()
+       << " variables, " << kProducts << " products" << endl;
+
+  // As GaussianFactorGraphSystem did before BlockSparseHessian
+  {
+    const auto start = chrono::steady_clock::now();
+    Vector y;
+    for (size_t k = 0; k < kProducts; ++k) {
+      VectorValues Ax = keyInfo.x0();
+      linear->multiplyHessianAdd(1.0, buildVectorValues(x, keyInfo), Ax);
+      y = Ax.vector(keyInfo.ordering());
+    }
+    const chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cout << "  GaussianFactorGraph:      " << elapsed.count() * 1e3 << " ms"
+         << endl;
+  }
+
+  for (size_t threads : {size_t(1), numThreads}) {
+    const auto start = chrono::steady_clock::now();
+    const BlockSparseHessian hessian(*linear, keyInfo, threads);
+    const chrono::duration<double> build = chrono::steady_clock::now() - start;
+    Vector y;
+    for (size_t k = 0; k < kProducts; ++k) hessian.multiply(x, y);
+    const chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cout << "  BlockSparseHessian (" << threads << "): " << elapsed.count() * 1e3
+         << " ms, of which " << build.count() * 1e3 << " ms to build" << endl;
+  }
+  return 0;
+}
@@ -20,8 +20,11 @@
 #include <gtsam/nonlinear/ExpressionFactor.h>
 #include <gtsam/slam/ProjectionFactor.h>
 #include <gtsam/slam/GeneralSFMFactor.h>
+#include <gtsam/slam/SmartProjectionFactor.h>
 #include <gtsam/geometry/Pose3.h>
 #include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/Cal3Bundler.h>
+#include <gtsam/geometry/CameraSet.h>
 #include "timeLinearize.h"
 
 using namespace std;
@@ -105,5 +108,55 @@ int main() {
       boost::make_shared<ExpressionFactor<Point2> >(model, z,
           Point2_(myProject, x, p));
   time("Binary(Leaf,Leaf)           : ", g3, values);
+
+  // BATCH PROJECTION
+
+  // One point seen by many cameras, as in SfM: projected into one camera at a
+  // time, against CameraSet::project2, which projects into all at once
+  typedef PinholeCamera<Cal3Bundler> BundlerCamera;
+  const size_t m = 128;
+  const int calls = 20000;
+  CameraSet<BundlerCamera> cameras;
+  Values cameraValues;
+  boost::shared_ptr<SmartProjectionFactor<BundlerCamera> > smart(
+      new SmartProjectionFactor<BundlerCamera>(model));
+  const Point3 point(0, 0, 1);
+  for (size_t i = 0; i < m; i++) {
+    const BundlerCamera camera(Pose3(Rot3::Ypr(0.001 * i, 0, 0),
+        Point3(0.05 * i, 0, -10)), Cal3Bundler(500, 1e-3, 1e-5));
+    cameras.push_back(camera);
+    cameraValues.insert(i, camera);
+    smart->add(camera.project2(point), i);
+  }
+  CameraSet<BundlerCamera>::FBlocks Fs(m);
+  Matrix E(2 * m, 3);
+
+  long timeLog = clock();
+  for (int k = 0; k < calls; k++) {
+    for (size_t i = 0; i < m; i++) {
+      Matrix23 Ei;
+      cameras[i].project2(point, Fs[i], Ei);
+      E.block<2, 3>(2 * i, 0) = Ei;
+    }
+  }
+  double seconds = (double) (clock() - timeLog) / CLOCKS_PER_SEC;
+  cout << "One camera at a time, " << m << " cameras: "
+      << seconds * 1000000 / calls << " musecs/call" << endl;
+
+  timeLog = clock();
+  for (int k = 0; k < calls; k++)
+    cameras.project2(point, Fs, E);
+  seconds = (double) (clock() - timeLog) / CLOCKS_PER_SEC;
+  cout << "CameraSet::project2, " << m << " cameras: "
+      << seconds * 1000000 / calls << " musecs/call" << endl;
+
+  // Smart factor linearization, mostly projecting with derivatives and the
+  // Schur complement
+  timeLog = clock();
+  for (int k = 0; k < calls / 100; k++)
+    smart->linearize(cameraValues);
+  seconds = (double) (clock() - timeLog) / CLOCKS_PER_SEC;
+  cout << "SmartProjectionFactor, " << m << " cameras: "
+      << seconds * 1000000 / (calls / 100) << " musecs/call" << endl;
   return 0;
 }
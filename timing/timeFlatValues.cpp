@@ -0,0 +1,127 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeFlatValues.cpp
+ * @brief   Compare Values and FlatValues on lookup, retract and localCoordinates
+ *
+ * Usage: timeFlatValues [g2oFile3D] [BALfile]
+ * Defaults to the sphere2500 pose graph and the dubrovnik-3-7 BAL problem.
+ */
+
+#include <gtsam/slam/dataset.h>
+#include <gtsam/nonlinear/FlatValues.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/timing.h>
+
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+
+static const size_t trials = 100;
+
+// Sum a coordinate of all values of type T, through the given container
+template<class T, class VALUES>
+double sumAt(const VALUES& values, const KeyVector& keys) {
+  double sum = 0.0;
+  for (Key key : keys)
+    sum += traits<T>::Local(T(), values.template at<T>(key))(0);
+  return sum;
+}
+
+// Time both containers on the same data, T is the type used for lookups
+template<class T>
+void timeContainers(const string& name, const Values& values,
+                    const FlatValues& flat, const KeyVector& lookupKeys) {
+  VectorValues delta = values.zeroVectors();
+  for (VectorValues::KeyValuePair& key_delta : delta)
+    key_delta.second.setConstant(1e-3);
+
+  cout << name << ": " << values.size() << " values, dim " << values.dim()
+       << endl;
+
+  double checksum = 0.0;
+  for (size_t i = 0; i < trials; i++) {
+    gttic_(Values);
+    {
+      gttic_(at);
+      checksum += sumAt<T>(values, lookupKeys);
+    }
+    Values retracted;
+    {
+      gttic_(retract);
+      retracted = values.retract(delta);
+    }
+    {
+      gttic_(localCoordinates);
+      checksum += values.localCoordinates(retracted).size();
+    }
+    gttoc_(Values);
+
+    gttic_(FlatValues);
+    {
+      gttic_(at);
+      checksum -= sumAt<T>(flat, lookupKeys);
+    }
+    FlatValues flatRetracted;
+    {
+      gttic_(retract);
+      flatRetracted = flat.retract(delta);
+    }
+    {
+      gttic_(localCoordinates);
+      checksum -= flat.localCoordinates(flatRetracted).size();
+    }
+    gttoc_(FlatValues);
+    tictoc_finishedIteration_();
+  }
+
+  tictoc_print_();
+  tictoc_reset_();
+  if (std::abs(checksum) > 1e-6)
+    cout << "Warning: Values and FlatValues disagree, checksum " << checksum
+         << endl;
+}
+
+int main(int argc, char* argv[]) {
+  // Pose graph, all Pose3
+  string g2oFile = argc > 1 ? argv[1] : findExampleDataFile("sphere2500.txt");
+  Values::shared_ptr poses = readG2o(g2oFile, true).second;
+  FlatValues flatPoses;
+  flatPoses.reserve<Pose3>(poses->size());
+  flatPoses.insert(*poses);
+  timeContainers<Pose3>("g2o " + g2oFile, *poses, flatPoses, poses->keys());
+
+  // Bundle adjustment, cameras and points
+  SfM_data db;
+  string balFile = argc > 2 ? argv[2] : findExampleDataFile("dubrovnik-3-7-pre");
+  if (!readBAL(balFile, db))
+    throw runtime_error("Could not access file!");
+  Values ba;
+  for (size_t i = 0; i < db.number_cameras(); i++)
+    ba.insert(symbol_shorthand::C(i), db.cameras[i]);
+  KeyVector points;
+  for (size_t j = 0; j < db.number_tracks(); j++) {
+    ba.insert(symbol_shorthand::P(j), db.tracks[j].p);
+    points.push_back(symbol_shorthand::P(j));
+  }
+  FlatValues flatBa;
+  flatBa.reserve<SfM_Camera>(db.number_cameras());
+  flatBa.reserve<Point3>(db.number_tracks());
+  flatBa.insert(ba);
+  timeContainers<Point3>("BAL " + balFile, ba, flatBa, points);
+
+  return 0;
+}
@@ -25,6 +25,7 @@ using namespace std;
 #include <boost/assign/list_of.hpp>
 
 #include <gtsam/base/Matrix.h>
+#include <gtsam/base/SymmetricBlockMatrix.h>
 #include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/GaussianConditional.h>
@@ -35,6 +36,27 @@ using namespace boost::assign;
 
 static const Key _x1_=1, _x2_=2, _l1_=3;
 
+/*
+ * Time updateHessian of a factor with M rows on two variables of dimension
+ * D, into the information matrix of three variables as during elimination
+ */
+template <int M, int D>
+static void timeUpdateHessian(int n) {
+  JacobianFactor factor(_x1_, Matrix::Random(M, D), _x2_, Matrix::Random(M, D),
+      Vector::Random(M), noiseModel::Isotropic::Sigma(M, 0.1));
+  KeyVector keys = list_of(_x2_)(_l1_)(_x1_);
+  SymmetricBlockMatrix info(vector<DenseIndex>(3, D), true);
+  info.setZero();
+
+  long timeLog = clock();
+  for(int i = 0; i < n; i++)
+    factor.updateHessian(keys, &info);
+  long timeLog2 = clock();
+  double seconds = (double)(timeLog2-timeLog)/CLOCKS_PER_SEC;
+  cout << "updateHessian " << M << "x" << D << ": " << seconds / n * 1e9
+       << " ns/call" << endl;
+}
+
 /*
  * Alex's Machine
  * Results for Eliminate:
@@ -52,6 +74,12 @@ static const Key _x1_=1, _x2_=2, _l1_=3;
 
 int main()
 {
+  // time updateHessian for the sizes with fixed-size kernels
+  timeUpdateHessian<2, 6>(1000000);
+  timeUpdateHessian<3, 6>(1000000);
+  timeUpdateHessian<6, 6>(1000000);
+  timeUpdateHessian<2, 9>(1000000);
+
   // create a linear factor
   Matrix Ax2 = (Matrix(8, 2) <<
            // x2
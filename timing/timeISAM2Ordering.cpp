@@ -0,0 +1,145 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeISAM2Ordering.cpp
+ * @brief   Compare COLAMD and METIS orderings in iSAM2 on the Manhattan and
+ * sphere datasets: fill-in and shape of the Bayes tree, and wall time of a
+ * batch step and of incremental updates
+ */
+
+#include <gtsam/slam/dataset.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// Depth of the Bayes tree and size of its largest clique
+static void treeShape(const ISAM2::sharedClique& clique, size_t depth,
+                      size_t* maxDepth, size_t* maxClique) {
+  *maxDepth = std::max(*maxDepth, depth);
+  *maxClique = std::max(*maxClique, clique->conditional()->size());
+  for (const ISAM2::sharedClique& child : clique->children)
+    treeShape(child, depth + 1, maxDepth, maxClique);
+}
+
+static void printTree(const ISAM2& isam) {
+  size_t nnz = 0, maxDepth = 0, maxClique = 0;
+  for (const ISAM2::sharedClique& root : isam.roots()) {
+    nnz += root->calculate_nnz();
+    treeShape(root, 1, &maxDepth, &maxClique);
+  }
+  cout << ", nnz(R) " << nnz << ", largest clique " << maxClique
+       << " variables, depth " << maxDepth << endl;
+}
+
+/* ************************************************************************* */
+// The datasets only have edges: chain the odometry for the initial estimate,
+// and add the edges of each pose when it is first seen
+template <class POSE>
+static void timeOrdering(const string& name, const NonlinearFactorGraph& edges,
+                         size_t maxPoses) {
+  map<Key, NonlinearFactorGraph> byPose;
+  map<Key, POSE> odometry;
+  for (const NonlinearFactor::shared_ptr& factor : edges) {
+    auto between = boost::dynamic_pointer_cast<BetweenFactor<POSE> >(factor);
+    if (!between) continue;
+    const Key key = std::max(between->key1(), between->key2());
+    if (key >= maxPoses) continue;
+    byPose[key].push_back(between);
+    if (between->key2() == between->key1() + 1)
+      odometry[between->key2()] = between->measured();
+  }
+  const Key numPoses = byPose.rbegin()->first + 1;
+  byPose[0].emplace_shared<PriorFactor<POSE> >(
+      0, POSE(), noiseModel::Isotropic::Sigma(traits<POSE>::dimension, 1e-3));
+  Values initial;
+  initial.insert(0, POSE());
+  for (Key key = 1; key < numPoses; ++key)
+    initial.insert(key, initial.at<POSE>(key - 1) * odometry[key]);
+  cout << name << ": " << initial.size() << " poses" << endl;
+
+  const pair<string, Ordering::OrderingType> orderings[] = {
+      {"COLAMD", Ordering::COLAMD}, {"METIS", Ordering::METIS}};
+  for (const auto& ordering : orderings) {
+    // Gauss-Newton with relinearizeSkip 10 fails on w20000 after the first
+    // large loop closures, relinearize every step instead
+    ISAM2Params params;
+    params.relinearizeSkip = 1;
+    params.orderingType = ordering.second;
+
+    // One batch step with all factors
+    {
+      NonlinearFactorGraph graph;
+      for (const auto& pose_factors : byPose) graph.push_back(pose_factors.second);
+      ISAM2 isam(params);
+      const auto start = chrono::steady_clock::now();
+      isam.update(graph, initial);
+      const chrono::duration<double> batch = chrono::steady_clock::now() - start;
+      cout << "  " << ordering.first << " batch: " << batch.count() * 1e3
+           << " ms";
+      printTree(isam);
+    }
+
+    // One update per pose, with batch steps on large loop closures.  A pose
+    // without edges to earlier poses waits for the update that constrains it.
+    {
+      ISAM2 isam(params);
+      Values pending;
+      const auto start = chrono::steady_clock::now();
+      for (Key key = 0; key < numPoses; ++key) {
+        pending.insert(key, key == 0 ? initial.at<POSE>(0)
+                                     : (pending.exists(key - 1)
+                                            ? pending.at<POSE>(key - 1)
+                                            : isam.calculateEstimate<POSE>(key - 1)) *
+                                           odometry[key]);
+        if (byPose[key].empty()) continue;
+        isam.update(byPose[key], pending);
+        pending.clear();
+      }
+      const chrono::duration<double> incremental =
+          chrono::steady_clock::now() - start;
+      cout << "  " << ordering.first
+           << " incremental: " << incremental.count() * 1e3 << " ms";
+      printTree(isam);
+    }
+  }
+}
+
+/* ************************************************************************* */
+int main(int argc, char* argv[]) {
+  // Optionally limit the number of poses of each dataset
+  const size_t maxPoses = argc > 1 ? atoi(argv[1]) : 1000000;
+  {
+    GraphAndValues manhattan = load2D(findExampleDataFile("w20000.txt"));
+    timeOrdering<Pose2>("w20000", *manhattan.first, maxPoses);
+  }
+  {
+    NonlinearFactorGraph graph;
+    for (const BetweenFactor<Pose3>::shared_ptr& factor :
+         parse3DFactors(findExampleDataFile("sphere2500.txt")))
+      graph.push_back(factor);
+    timeOrdering<Pose3>("sphere2500", graph, maxPoses);
+  }
+  return 0;
+}
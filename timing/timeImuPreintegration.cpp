@@ -0,0 +1,147 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeImuPreintegration.cpp
+ * @brief   Time IMU preintegration of a 1 kHz stream, one virtual call per
+ * sample against the batch integrateMeasurements over contiguous arrays, and
+ * the linearization of the resulting factors
+ */
+
+#include <gtsam/navigation/ImuFactor.h>
+#include <gtsam/navigation/CombinedImuFactor.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::B;
+using symbol_shorthand::V;
+using symbol_shorthand::X;
+
+static const double kGravity = 9.81;
+
+/* ************************************************************************* */
+template <class PIM>
+static void timePreintegration(const string& name,
+                               const boost::shared_ptr<typename PIM::Params>& p,
+                               const Eigen::Matrix3Xd& accs,
+                               const Eigen::Matrix3Xd& omegas, const Vector& dts,
+                               size_t keyframes) {
+  const imuBias::ConstantBias biasHat(Vector3(0.1, -0.1, 0.05),
+                                      Vector3(0.01, 0.02, -0.01));
+  const size_t n = dts.size();
+
+  // One sample at a time, through the base class as in a sensor callback
+  PIM loop(p, biasHat);
+  auto start = chrono::steady_clock::now();
+  for (size_t k = 0; k < keyframes; k++) {
+    loop.resetIntegration();
+    PreintegrationBase& base = loop;
+    for (size_t j = 0; j < n; j++)
+      base.integrateMeasurement(accs.col(j), omegas.col(j), dts(j));
+  }
+  const chrono::duration<double> loopTime = chrono::steady_clock::now() - start;
+
+  PIM batch(p, biasHat);
+  start = chrono::steady_clock::now();
+  for (size_t k = 0; k < keyframes; k++) {
+    batch.resetIntegration();
+    batch.integrateMeasurements(accs, omegas, dts);
+  }
+  const chrono::duration<double> batchTime = chrono::steady_clock::now() - start;
+
+  const double samples = double(n * keyframes);
+  cout << name << ": loop " << loopTime.count() * 1e9 / samples
+       << " ns/sample, batch " << batchTime.count() * 1e9 / samples
+       << " ns/sample, covariance difference "
+       << (loop.preintMeasCov() - batch.preintMeasCov()).norm() << endl;
+}
+
+/* ************************************************************************* */
+// Generic NoiseModelFactor linearization against the factor's own, which
+// writes fixed-size blocks into the factor of the previous call
+template <class FACTOR>
+static void timeLinearize(const string& name, const FACTOR& factor,
+                          const Values& values, size_t n) {
+  auto start = chrono::steady_clock::now();
+  for (size_t k = 0; k < n; k++) factor.NoiseModelFactor::linearize(values);
+  const chrono::duration<double> generic = chrono::steady_clock::now() - start;
+
+  boost::shared_ptr<GaussianFactor> gaussian;
+  start = chrono::steady_clock::now();
+  for (size_t k = 0; k < n; k++) factor.linearizeInto(values, gaussian);
+  const chrono::duration<double> inPlace = chrono::steady_clock::now() - start;
+
+  cout << name << " linearize: generic " << generic.count() * 1e9 / n
+       << " ns, fixed-size in place " << inPlace.count() * 1e9 / n << " ns"
+       << endl;
+}
+
+/* ************************************************************************* */
+int main(int argc, char* argv[]) {
+  // Samples between keyframes of a 1 kHz IMU, and number of keyframes
+  const size_t n = argc > 1 ? atoi(argv[1]) : 2000;
+  const size_t keyframes = argc > 2 ? atoi(argv[2]) : 500;
+
+  Eigen::Matrix3Xd accs(3, n), omegas(3, n);
+  Vector dts(n);
+  for (size_t j = 0; j < n; j++) {
+    const double t = 0.001 * j;
+    accs.col(j) << sin(t), cos(2 * t), kGravity + 0.1 * sin(5 * t);
+    omegas.col(j) << 0.3 * cos(t), 0.2 * sin(3 * t), 0.5;
+    dts(j) = 0.001;
+  }
+  cout << n << " samples per keyframe, " << keyframes << " keyframes" << endl;
+
+  auto p = PreintegrationParams::MakeSharedD(kGravity);
+  p->gyroscopeCovariance = 1e-6 * I_3x3;
+  p->accelerometerCovariance = 1e-4 * I_3x3;
+  p->integrationCovariance = 1e-8 * I_3x3;
+  timePreintegration<PreintegratedImuMeasurements>("PreintegratedImuMeasurements",
+                                                   p, accs, omegas, dts, keyframes);
+
+  auto pc = PreintegratedCombinedMeasurements::Params::MakeSharedD(kGravity);
+  pc->gyroscopeCovariance = 1e-6 * I_3x3;
+  pc->accelerometerCovariance = 1e-4 * I_3x3;
+  pc->integrationCovariance = 1e-8 * I_3x3;
+  pc->biasAccCovariance = 1e-6 * I_3x3;
+  pc->biasOmegaCovariance = 1e-8 * I_3x3;
+  pc->biasAccOmegaInt = 1e-5 * I_6x6;
+  timePreintegration<PreintegratedCombinedMeasurements>(
+      "PreintegratedCombinedMeasurements", pc, accs, omegas, dts, keyframes);
+
+  // Linearize at a state that does not agree with the measurements
+  const imuBias::ConstantBias bias(Vector3(0.1, 0, 0), Vector3(0, 0.01, 0));
+  Values values;
+  values.insert(X(0), Pose3());
+  values.insert(V(0), Vector3(1, 0, 0));
+  values.insert(X(1), Pose3(Rot3::Ypr(0.1, 0, 0), Point3(2, 0.1, 0)));
+  values.insert(V(1), Vector3(1, 0.2, 0));
+  values.insert(B(0), bias);
+  values.insert(B(1), bias);
+
+  PreintegratedImuMeasurements pim(p);
+  pim.integrateMeasurements(accs, omegas, dts);
+  timeLinearize("ImuFactor", ImuFactor(X(0), V(0), X(1), V(1), B(0), pim),
+                values, 100 * keyframes);
+
+  PreintegratedCombinedMeasurements pimc(pc);
+  pimc.integrateMeasurements(accs, omegas, dts);
+  timeLinearize("CombinedImuFactor",
+                CombinedImuFactor(X(0), V(0), X(1), V(1), B(0), B(1), pimc),
+                values, 100 * keyframes);
+  return 0;
+}
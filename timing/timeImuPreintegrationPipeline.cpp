@@ -0,0 +1,108 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeImuPreintegrationPipeline.cpp
+ * @brief   Samples per second of several IMU streams, preintegrated serially
+ * in the sensor callbacks against ImuPreintegrationPipeline
+ */
+
+#include <gtsam/navigation/ImuPreintegrationPipeline.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+using namespace gtsam;
+
+static const double kGravity = 9.81;
+static const double kSampleDt = 1.0 / 1024;
+static const double kKeyframeDt = 0.125;
+
+static Vector3 acc(size_t sensor, double t) {
+  return Vector3(sin(t + sensor), cos(2 * t), kGravity + 0.1 * sin(5 * t));
+}
+static Vector3 omega(size_t sensor, double t) {
+  return Vector3(0.3 * cos(t), 0.2 * sin(3 * t + sensor), 0.5);
+}
+
+/* ************************************************************************* */
+int main(int argc, char* argv[]) {
+  // Number of sensors, seconds of log, and threads of the pipeline
+  const size_t numSensors = argc > 1 ? atoi(argv[1]) : 4;
+  const double seconds = argc > 2 ? atof(argv[2]) : 60;
+  const size_t numThreads = argc > 3 ? atoi(argv[3]) : 0;
+  const size_t numSamples = seconds / kSampleDt + 1;
+  const size_t numKeyframes = seconds / kKeyframeDt + 1;
+  cout << numSensors << " sensors, " << numSamples << " samples each, "
+       << numKeyframes << " keyframes, " << thread::hardware_concurrency()
+       << " hardware threads" << endl;
+
+  auto p = PreintegrationParams::MakeSharedD(kGravity);
+  p->gyroscopeCovariance = 1e-6 * I_3x3;
+  p->accelerometerCovariance = 1e-4 * I_3x3;
+  p->integrationCovariance = 1e-8 * I_3x3;
+
+  // Replay the log serially, integrating every sample when it arrives and
+  // starting over at keyframes, as in the examples
+  auto start = chrono::steady_clock::now();
+  double checksum = 0;
+  for (size_t j = 0; j < numSensors; j++) {
+    PreintegratedImuMeasurements pim(p);
+    for (size_t i = 0; i + 1 < numSamples; i++) {
+      const double t = i * kSampleDt;
+      pim.integrateMeasurement(acc(j, t), omega(j, t), kSampleDt);
+      if (pim.deltaTij() >= kKeyframeDt) {
+        checksum += pim.deltaPij().norm();
+        pim.resetIntegration();
+      }
+    }
+  }
+  const chrono::duration<double> serial = chrono::steady_clock::now() - start;
+
+  // Replay it through the pipeline, one feeding thread per sensor
+  start = chrono::steady_clock::now();
+  double pipelineChecksum = 0;
+  size_t numIntervals = 0;
+  {
+    ImuPreintegrationPipeline<PreintegratedImuMeasurements> pipeline(
+        vector<boost::shared_ptr<PreintegrationParams> >(numSensors, p),
+        numThreads);
+    for (size_t k = 0; k < numKeyframes; k++) pipeline.addKeyframe(k * kKeyframeDt);
+    vector<thread> feeders;
+    for (size_t j = 0; j < numSensors; j++) {
+      feeders.emplace_back([&pipeline, j, numSamples] {
+        for (size_t i = 0; i < numSamples; i++) {
+          const double t = i * kSampleDt;
+          pipeline.push(j, t, acc(j, t), omega(j, t));
+        }
+      });
+    }
+    for (thread& feeder : feeders) feeder.join();
+    pipeline.flush();
+    ImuPreintegrationPipeline<PreintegratedImuMeasurements>::Interval interval;
+    while (pipeline.tryPop(interval)) {
+      pipelineChecksum += interval.pim.deltaPij().norm();
+      numIntervals++;
+    }
+  }
+  const chrono::duration<double> pipelined = chrono::steady_clock::now() - start;
+
+  const double samples = double(numSensors * (numSamples - 1));
+  cout << "serial:   " << samples / serial.count() << " samples/s" << endl;
+  cout << "pipeline: " << samples / pipelined.count() << " samples/s, "
+       << numIntervals << " intervals, checksum difference "
+       << fabs(checksum - pipelineChecksum) << endl;
+  return 0;
+}
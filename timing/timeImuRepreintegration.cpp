@@ -0,0 +1,128 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeImuRepreintegration.cpp
+ * @brief   Time correcting ImuFactors for a new bias estimate: rebuilding all
+ * of them from the raw samples, against lazy re-preintegration of the factors
+ * whose bias moved beyond the threshold before linearizing
+ */
+
+#include <gtsam/navigation/ImuFactor.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::B;
+using symbol_shorthand::V;
+using symbol_shorthand::X;
+
+static const double kGravity = 9.81;
+static const double kDt = 0.001;
+
+/* ************************************************************************* */
+int main(int argc, char* argv[]) {
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+  // Factors, samples per factor, fraction of factors beyond the threshold,
+  // and threads
+  const size_t numFactors = argc > 1 ? atoi(argv[1]) : 500;
+  const size_t n = argc > 2 ? atoi(argv[2]) : 200;
+  const double fraction = argc > 3 ? atof(argv[3]) : 0.1;
+  const size_t numThreads = argc > 4 ? atoi(argv[4]) : 0;
+  const double threshold = 0.05;
+  cout << numFactors << " factors of " << n << " samples, " << fraction
+       << " of them beyond the bias threshold" << endl;
+
+  auto p = PreintegrationParams::MakeSharedD(kGravity);
+  p->gyroscopeCovariance = 1e-6 * I_3x3;
+  p->accelerometerCovariance = 1e-4 * I_3x3;
+  p->integrationCovariance = 1e-8 * I_3x3;
+
+  Eigen::Matrix3Xd accs(3, n), omegas(3, n);
+  for (size_t j = 0; j < n; j++) {
+    const double t = kDt * j;
+    accs.col(j) << sin(t), cos(2 * t), kGravity + 0.1 * sin(5 * t);
+    omegas.col(j) << 0.3 * cos(t), 0.2 * sin(3 * t), 0.5;
+  }
+  const Vector dts = Vector::Constant(n, kDt);
+
+  // Factors preintegrated with a zero bias, with and without the samples,
+  // and a new estimate that moved far for some of them, a little for the others
+  NonlinearFactorGraph graph, firstOrderGraph;
+  Values values;
+  const imuBias::ConstantBias small(Vector3(0.01, 0, 0), Vector3(0, 0.005, 0));
+  const imuBias::ConstantBias large(Vector3(0.2, -0.1, 0), Vector3(0, 0.05, -0.02));
+  for (size_t k = 0; k < numFactors; k++) {
+    PreintegratedImuMeasurements pim(p);
+    pim.integrateMeasurements(accs, omegas, dts);
+    firstOrderGraph.emplace_shared<ImuFactor>(X(k), V(k), X(k + 1), V(k + 1),
+                                              B(k), pim);
+    PreintegratedImuMeasurements storing(p);
+    storing.storeSamples(threshold);
+    storing.integrateMeasurements(accs, omegas, dts);
+    graph.emplace_shared<ImuFactor>(X(k), V(k), X(k + 1), V(k + 1), B(k),
+                                    storing);
+    values.insert(X(k), Pose3());
+    values.insert(V(k), Vector3(1, 0, 0));
+    values.insert(B(k), k < fraction * numFactors ? large : small);
+  }
+  values.insert(X(numFactors), Pose3(Rot3(), Point3(0.2, 0, 0)));
+  values.insert(V(numFactors), Vector3(1, 0, 0));
+
+  // First-order bias correction only, for reference
+  auto start = chrono::steady_clock::now();
+  firstOrderGraph.linearize(values, numThreads);
+  const chrono::duration<double> firstOrder = chrono::steady_clock::now() - start;
+
+  // What applications do without stored samples: rebuild every factor from
+  // the raw samples with the new estimate, then linearize
+  start = chrono::steady_clock::now();
+  NonlinearFactorGraph rebuilt;
+  for (size_t k = 0; k < numFactors; k++) {
+    PreintegratedImuMeasurements pim(p);
+    pim.resetIntegrationAndSetBias(values.at<imuBias::ConstantBias>(B(k)));
+    pim.integrateMeasurements(accs, omegas, dts);
+    rebuilt.emplace_shared<ImuFactor>(X(k), V(k), X(k + 1), V(k + 1), B(k), pim);
+  }
+  rebuilt.linearize(values, numThreads);
+  const chrono::duration<double> full = chrono::steady_clock::now() - start;
+
+  // Re-preintegrate lazily, in parallel, then linearize
+  start = chrono::steady_clock::now();
+  graph.refresh(values, numThreads);
+  graph.linearize(values, numThreads);
+  const chrono::duration<double> lazy = chrono::steady_clock::now() - start;
+
+  // Error of the first-order correction for the factors far from biasHat
+  const double correctionError =
+      (boost::static_pointer_cast<ImuFactor>(firstOrderGraph.at(0))
+           ->unwhitenedError(values) -
+       boost::static_pointer_cast<ImuFactor>(graph.at(0))
+           ->unwhitenedError(values)).norm();
+
+  cout << "linearize, first-order correction: " << firstOrder.count() * 1e3
+       << " ms" << endl;
+  cout << "re-integrate all and linearize:    " << full.count() * 1e3 << " ms"
+       << endl;
+  cout << "lazy re-preintegration:            " << lazy.count() * 1e3 << " ms"
+       << endl;
+  cout << "first-order error beyond the threshold: " << correctionError << endl;
+#else
+  cout << "Re-preintegration needs GTSAM_TANGENT_PREINTEGRATION" << endl;
+#endif
+  return 0;
+}
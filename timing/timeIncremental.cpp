@@ -24,6 +24,9 @@
 #include <gtsam/nonlinear/Marginals.h>
 #include <gtsam/base/timing.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <fstream>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/binary_iarchive.hpp>
@@ -68,6 +71,16 @@ double chi2_red(const gtsam::NonlinearFactorGraph& graph, const gtsam::Values& c
   return 2. * graph.error(config) / dof; // kaess: added factor 2, graph.error returns half of actual error
 }
 
+// Print the p-th percentile of the given latencies, in milliseconds
+static void printPercentile(vector<double> latencies, double p) {
+  if (latencies.empty()) return;
+  const size_t k = std::min(latencies.size() - 1,
+                            static_cast<size_t>(p / 100.0 * latencies.size()));
+  std::nth_element(latencies.begin(), latencies.begin() + k, latencies.end());
+  cout << "p" << p << " update latency: " << latencies[k] << " ms" << endl;
+}
+
+// Usage: timeIncremental [numThreads]
 int main(int argc, char *argv[]) {
 
   cout << "Loading data..." << endl;
@@ -84,7 +97,13 @@ int main(int argc, char *argv[]) {
 
   cout << "Playing forward time steps..." << endl;
 
-  ISAM2 isam2;
+  ISAM2Params params;
+  params.numThreads = argc > 1 ? atoi(argv[1]) : 1;
+  cout << "Using " << params.numThreads << " threads" << endl;
+  ISAM2 isam2(params);
+
+  // Wall-clock latency of every update, in milliseconds
+  vector<double> latencies;
 
   size_t nextMeasurement = 0;
   for(size_t step=1; nextMeasurement < measurements.size(); ++step) {
@@ -169,7 +188,10 @@ int main(int argc, char *argv[]) {
 
     // Update iSAM2
     gttic_(Update_ISAM2);
+    const auto start = std::chrono::steady_clock::now();
     isam2.update(newFactors, newVariables);
+    latencies.push_back(std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count());
     gttoc_(Update_ISAM2);
 
     if(step % 100 == 0) {
@@ -205,6 +227,9 @@ int main(int argc, char *argv[]) {
   //  cout << e.what() << endl;
   //}
 
+  printPercentile(latencies, 50);
+  printPercentile(latencies, 99);
+
   NonlinearFactorGraph graph;
   Values values;
 
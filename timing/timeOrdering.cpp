@@ -0,0 +1,80 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeOrdering.cpp
+ * @brief   Time building the VariableIndex and the COLAMD ordering of a large
+ * grid, serially and in parallel, and compare the fill-in of the orderings
+ */
+
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/symbolic/SymbolicFactorGraph.h>
+#include <gtsam/symbolic/SymbolicBayesNet.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+static double seconds(const chrono::steady_clock::time_point& start) {
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/* ************************************************************************* */
+// Number of block entries of R
+static size_t fill(const SymbolicFactorGraph& graph, const Ordering& ordering) {
+  const SymbolicBayesNet::shared_ptr R = graph.eliminateSequential(ordering);
+  size_t nnz = 0;
+  for (const auto& conditional : *R) nnz += conditional->size();
+  return nnz;
+}
+
+/* ************************************************************************* */
+int main(int argc, char* argv[]) {
+  // Side of the grid, the default has about 10M factors
+  const Key side = argc > 1 ? atoi(argv[1]) : 2236;
+  const size_t numThreads = std::max(2u, thread::hardware_concurrency());
+
+  SymbolicFactorGraph graph;
+  graph.reserve(2 * side * side);
+  for (Key i = 0; i < side; ++i)
+    for (Key j = 0; j < side; ++j) {
+      if (i + 1 < side) graph.push_factor(side * i + j, side * (i + 1) + j);
+      if (j + 1 < side) graph.push_factor(side * i + j, side * i + j + 1);
+    }
+  cout << side << "x" << side << " grid: " << graph.size() << " factors, "
+       << numThreads << " threads" << endl;
+
+  auto start = chrono::steady_clock::now();
+  const VariableIndex serialIndex(graph);
+  cout << "  VariableIndex serial: " << seconds(start) << " s" << endl;
+  start = chrono::steady_clock::now();
+  const VariableIndex parallelIndex(graph, numThreads);
+  cout << "  VariableIndex parallel: " << seconds(start) << " s, "
+       << (serialIndex.equals(parallelIndex) ? "same" : "DIFFERENT") << endl;
+
+  start = chrono::steady_clock::now();
+  const Ordering colamd = Ordering::Colamd(serialIndex);
+  cout << "  Colamd: " << seconds(start) << " s" << endl;
+  start = chrono::steady_clock::now();
+  const Ordering parallel = Ordering::ColamdParallel(parallelIndex, numThreads);
+  cout << "  ColamdParallel: " << seconds(start) << " s" << endl;
+
+  // Elimination of the largest grids does not fit in memory
+  if (side <= 1000)
+    cout << "  fill: Colamd " << fill(graph, colamd) << ", ColamdParallel "
+         << fill(graph, parallel) << endl;
+  return 0;
+}
@@ -0,0 +1,119 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timePreconditioners.cpp
+ * @brief   Compare the PCG preconditioners on the linearized Manhattan and
+ * sphere datasets: iterations, build and solve times, and error against the
+ * direct solution
+ */
+
+#include <gtsam/slam/dataset.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/IncompleteCholeskyPreconditioner.h>
+#include <gtsam/linear/MultigridPreconditioner.h>
+#include <gtsam/linear/PCGSolver.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// Counts the products with the Hessian, one per CG iteration
+struct CountingSystem : public GaussianFactorGraphSystem {
+  using GaussianFactorGraphSystem::GaussianFactorGraphSystem;
+  mutable size_t products = 0;
+  void multiply(const Vector& x, Vector& y) const {
+    ++products;
+    GaussianFactorGraphSystem::multiply(x, y);
+  }
+};
+
+/* ************************************************************************* */
+// The datasets only have edges: chain the odometry for the linearization
+// point, and fix the first pose
+template <class POSE>
+static GaussianFactorGraph::shared_ptr linearize(NonlinearFactorGraph graph) {
+  Values initial;
+  initial.insert(0, POSE());
+  for (const NonlinearFactor::shared_ptr& factor : graph) {
+    auto between = boost::dynamic_pointer_cast<BetweenFactor<POSE> >(factor);
+    if (between && between->key2() == between->key1() + 1 &&
+        initial.exists(between->key1()) && !initial.exists(between->key2()))
+      initial.insert(between->key2(), initial.at<POSE>(between->key1()) *
+                                          between->measured());
+  }
+  graph.emplace_shared<PriorFactor<POSE> >(
+      0, POSE(), noiseModel::Isotropic::Sigma(traits<POSE>::dimension, 1e-3));
+  return graph.linearize(initial);
+}
+
+/* ************************************************************************* */
+static void timePreconditioners(const string& name,
+                                const GaussianFactorGraph& graph) {
+  const KeyInfo keyInfo(graph);
+  const map<Key, Vector> lambda;
+  const Vector exact = graph.optimize().vector(keyInfo.ordering());
+  cout << name << ": " << graph.size() << " factors, " << keyInfo.numCols()
+       << " unknowns" << endl;
+
+  PCGSolverParameters parameters;
+  parameters.setMaxIterations(5000);
+  parameters.setEpsilon_rel(1e-8);
+  parameters.setEpsilon_abs(0.0);
+
+  const pair<string, PreconditionerParameters::shared_ptr> preconditioners[] = {
+      {"block Jacobi", boost::make_shared<BlockJacobiPreconditionerParameters>()},
+      {"IC(0)", boost::make_shared<IncompleteCholeskyPreconditionerParameters>()},
+      {"ICT(1e-3)",
+       boost::make_shared<IncompleteCholeskyPreconditionerParameters>(1e-3)},
+      {"multigrid", boost::make_shared<MultigridPreconditionerParameters>()}};
+  for (const auto& item : preconditioners) {
+    const Preconditioner::shared_ptr preconditioner =
+        createPreconditioner(item.second);
+    const auto start = chrono::steady_clock::now();
+    preconditioner->build(graph, keyInfo, lambda);
+    const auto built = chrono::steady_clock::now();
+    const CountingSystem system(graph, *preconditioner, keyInfo, lambda);
+    const Vector x = preconditionedConjugateGradient(
+        system, Vector(Vector::Zero(keyInfo.numCols())), parameters);
+    const auto solved = chrono::steady_clock::now();
+    const chrono::duration<double> build = built - start, solve = solved - built;
+    cout << "  " << item.first << ": " << system.products << " iterations, build "
+         << build.count() * 1e3 << " ms, solve " << solve.count() * 1e3
+         << " ms, relative error " << (x - exact).norm() / exact.norm() << endl;
+  }
+}
+
+/* ************************************************************************* */
+int main(int argc, char* argv[]) {
+  {
+    GraphAndValues manhattan = load2D(findExampleDataFile("w20000.txt"));
+    timePreconditioners("w20000", *linearize<Pose2>(*manhattan.first));
+  }
+  {
+    NonlinearFactorGraph graph;
+    for (const BetweenFactor<Pose3>::shared_ptr& factor :
+         parse3DFactors(findExampleDataFile("sphere2500.txt")))
+      graph.push_back(factor);
+    timePreconditioners("sphere2500", *linearize<Pose3>(graph));
+  }
+  return 0;
+}
@@ -51,5 +51,11 @@ int main(int argc, char* argv[]) {
   for (const SfM_Camera& camera : db.cameras)
     initial.insert(C(i++), camera);
 
+  // Linearize once, projecting every point into all cameras that see it
+  {
+    gttic_(linearize);
+    graph.linearize(initial);
+  }
+
   return optimize(db, graph, initial);
 }
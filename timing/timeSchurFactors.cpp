@@ -25,6 +25,7 @@ using namespace gtsam;
 #define SLOW
 #define RAW
 #define HESSIAN
+#define UPDATE_HESSIAN
 #define NUM_ITERATIONS 1000
 
 // Create CSV file for results
@@ -95,6 +96,24 @@ void timeAll(size_t m, size_t N) {
   TIME(Hessian, hessianFactor, xvalues, yvalues)
 #endif
 
+#ifdef UPDATE_HESSIAN
+  { // Information matrix of the 2xD camera blocks, as when eliminating them
+    vector<JacobianFactor> cameraFactors;
+    for (size_t i = 0; i < m; i++)
+      cameraFactors.push_back(JacobianFactor(keys[i], Fblocks[i],
+          b.segment<2>(2 * i), model));
+    SymmetricBlockMatrix info(vector<DenseIndex>(m, D), true);
+    info.setZero();
+    gttic_(UpdateHessian);
+    for (size_t t = 0; t < N; t++)
+      for (const JacobianFactor& factor : cameraFactors)
+        factor.updateHessian(keys, &info);
+    gttoc_(UpdateHessian);
+    tictoc_getNode(timer, UpdateHessian)
+    os << timer->secs()/NUM_ITERATIONS << ", ";
+  }
+#endif
+
 #ifdef OVERHEAD
   DummyFactor<D> dummy(Fblocks, E, P, b);
   TIME(Overhead,dummy,xvalues,yvalues)
@@ -130,6 +149,9 @@ int main(void) {
 #ifdef HESSIAN
   os << "Hessian,";
 #endif
+#ifdef UPDATE_HESSIAN
+  os << "UpdateHessian,";
+#endif
 #ifdef OVERHEAD
   os << "Overhead,";
 #endif
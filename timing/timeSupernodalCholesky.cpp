@@ -0,0 +1,123 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeSupernodalCholesky.cpp
+ * @brief   Time Levenberg-Marquardt with the CHOLMOD (supernodal Cholesky),
+ * MIXED_PRECISION_CHOLMOD and MULTIFRONTAL_CHOLESKY linear solvers, on the
+ * Manhattan, sphere and BAL datasets
+ *
+ * Usage: timeSupernodalCholesky [BALfile]
+ */
+
+#include <gtsam/slam/dataset.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/GeneralSFMFactor.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/geometry/Cal3Bundler.h>
+#include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::C;
+using symbol_shorthand::P;
+
+/* ************************************************************************* */
+// The datasets only have edges: chain the odometry for the initial estimate,
+// and fix the first pose
+template <class POSE>
+static void chainOdometry(NonlinearFactorGraph* graph, Values* initial) {
+  initial->insert(0, POSE());
+  for (const NonlinearFactor::shared_ptr& factor : *graph) {
+    auto between = boost::dynamic_pointer_cast<BetweenFactor<POSE> >(factor);
+    if (between && between->key2() == between->key1() + 1 &&
+        initial->exists(between->key1()) && !initial->exists(between->key2()))
+      initial->insert(between->key2(), initial->at<POSE>(between->key1()) *
+                                            between->measured());
+  }
+  graph->emplace_shared<PriorFactor<POSE> >(
+      0, POSE(), noiseModel::Isotropic::Sigma(traits<POSE>::dimension, 1e-3));
+}
+
+/* ************************************************************************* */
+static void timeSolvers(const string& name, const NonlinearFactorGraph& graph,
+                        const Values& initial) {
+  cout << name << ": " << graph.size() << " factors, " << initial.size()
+       << " variables" << endl;
+  const LevenbergMarquardtParams::LinearSolverType solvers[] = {
+      LevenbergMarquardtParams::MULTIFRONTAL_CHOLESKY,
+      LevenbergMarquardtParams::CHOLMOD,
+      LevenbergMarquardtParams::MIXED_PRECISION_CHOLMOD};
+  for (LevenbergMarquardtParams::LinearSolverType solver : solvers) {
+    LevenbergMarquardtParams params;
+    params.linearSolverType = solver;
+    params.maxIterations = 20;
+    const auto start = chrono::steady_clock::now();
+    LevenbergMarquardtOptimizer optimizer(graph, initial, params);
+    const Values result = optimizer.optimize();
+    const chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cout << "  " << params.getLinearSolverType() << ": "
+         << elapsed.count() * 1e3 << " ms, " << optimizer.iterations()
+         << " iterations, error " << graph.error(result) << endl;
+  }
+}
+
+/* ************************************************************************* */
+int main(int argc, char* argv[]) {
+  // Manhattan world
+  {
+    GraphAndValues manhattan = load2D(findExampleDataFile("w20000.txt"));
+    NonlinearFactorGraph graph = *manhattan.first;
+    Values initial;
+    chainOdometry<Pose2>(&graph, &initial);
+    timeSolvers("w20000", graph, initial);
+  }
+
+  // Sphere
+  {
+    NonlinearFactorGraph graph;
+    for (const BetweenFactor<Pose3>::shared_ptr& factor :
+         parse3DFactors(findExampleDataFile("sphere2500.txt")))
+      graph.push_back(factor);
+    Values initial;
+    chainOdometry<Pose3>(&graph, &initial);
+    timeSolvers("sphere2500", graph, initial);
+  }
+
+  // Bundle adjustment
+  {
+    typedef GeneralSFMFactor<PinholeCamera<Cal3Bundler>, Point3> SfmFactor;
+    SfM_data db;
+    const string filename =
+        argc > 1 ? argv[1] : findExampleDataFile("dubrovnik-3-7-pre");
+    if (!readBAL(filename, db)) throw runtime_error("Could not access file!");
+    NonlinearFactorGraph graph;
+    Values initial;
+    const SharedNoiseModel model = noiseModel::Unit::Create(2);
+    for (size_t j = 0; j < db.number_tracks(); j++) {
+      for (const SfM_Measurement& m : db.tracks[j].measurements)
+        graph.emplace_shared<SfmFactor>(m.second, model, C(m.first), P(j));
+      initial.insert(P(j), db.tracks[j].p);
+    }
+    for (size_t i = 0; i < db.number_cameras(); i++)
+      initial.insert(C(i), db.cameras[i]);
+    timeSolvers(filename, graph, initial);
+  }
+  return 0;
+}
@@ -0,0 +1,76 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeWhitenedErrors.cpp
+ * @brief   Time chi-square gating of a large pose graph, one factor at a time
+ * and with NonlinearFactorGraph::whitenedErrors
+ *
+ * Usage: timeWhitenedErrors [numFactors] [numThreads]
+ * Defaults to 1M BetweenFactor<Pose3> on a single thread.
+ */
+
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/geometry/Pose3.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+
+static const double chi2Threshold = 12.59; // 95% quantile, 6 dof
+
+/* ************************************************************************* */
+int main(int argc, char* argv[]) {
+  const size_t n = argc > 1 ? atoi(argv[1]) : 1000000;
+  const size_t numThreads = argc > 2 ? atoi(argv[2]) : 1;
+
+  // A chain of poses with slightly wrong odometry
+  const SharedNoiseModel model = noiseModel::Diagonal::Sigmas(
+      (Vector(6) << 0.01, 0.01, 0.01, 0.1, 0.1, 0.1).finished());
+  const Pose3 odometry(Rot3::Ypr(0.01, 0.0, 0.0), Point3(1.0, 0.0, 0.0));
+  NonlinearFactorGraph graph;
+  Values values;
+  Pose3 pose;
+  values.insert(0, pose);
+  for (size_t i = 1; i <= n; ++i) {
+    graph.emplace_shared<BetweenFactor<Pose3> >(i - 1, i, odometry, model);
+    pose = pose * Pose3(Rot3::Ypr(0.0105, 0.0, 0.0),
+                        Point3(1.0, 0.001 * (i % 7), 0.0));
+    values.insert(i, pose);
+  }
+  cout << n << " factors, " << numThreads << " threads" << endl;
+
+  // One virtual call and allocation per factor
+  auto start = chrono::steady_clock::now();
+  size_t outliers = 0;
+  for (const NonlinearFactor::shared_ptr& factor : graph) {
+    const NoiseModelFactor& f = static_cast<const NoiseModelFactor&>(*factor);
+    if (f.whitenedError(values).squaredNorm() > chi2Threshold) ++outliers;
+  }
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  cout << "per factor:     " << elapsed.count() * 1e3 << " ms, " << outliers
+       << " outliers" << endl;
+
+  // Batched, into one contiguous vector
+  start = chrono::steady_clock::now();
+  const Vector squaredNorms =
+      graph.whitenedErrors(values, numThreads).squaredNorms();
+  outliers = (squaredNorms.array() > chi2Threshold).count();
+  elapsed = chrono::steady_clock::now() - start;
+  cout << "whitenedErrors: " << elapsed.count() * 1e3 << " ms, " << outliers
+       << " outliers" << endl;
+  return 0;
+}